@@ -0,0 +1,337 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "BigInt/BigInt.h"
+#include "Scheduler/Scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Microbenchmarks das operações básicas com varredura de tamanhos
+// Para cada operação e cada tamanho (1, 10, 100, ... dígitos) repete a
+// operação até somar pelo menos --min-tempo segundos e reporta ns/op e
+// limbs/s (limbs do maior operando processados por segundo). O tempo de
+// uma chamada no próximo tamanho é estimado pelo crescimento entre os dois
+// últimos tamanhos (pelo menos linear); se a estimativa passar de --limite
+// segundos a operação deixa de ser medida (ex.: o MDC de Euclides, que é
+// quadrático)
+//
+// Operandos: a tem n dígitos; b tem n dígitos na soma, subtração,
+// multiplicação e MDC, e n/2 dígitos na divisão e no módulo
+//
+// Uso: bench [--max-digitos N] [--min-tempo S] [--limite S] [--ops a,b,...]
+//            [--csv arquivo] [--json arquivo] [--threads N]
+
+typedef enum {
+  BENCH_PARSE,
+  BENCH_TO_STRING,
+  BENCH_SUM,
+  BENCH_SUBTRACT,
+  BENCH_MULTIPLY,
+  BENCH_DIVIDE,
+  BENCH_MOD,
+  BENCH_GCD,
+  BENCH_OPS
+} BenchOp;
+
+static const char *bench_op_names[BENCH_OPS] = {
+    "parse", "to_string", "sum", "subtract", "multiply", "divide", "mod",
+    "gcd"};
+
+typedef struct {
+  BenchOp op;
+  size_t digits;
+  size_t limbs;
+  size_t iterations;
+  double ns_per_op;
+  double limbs_per_second;
+} BenchResult;
+
+typedef struct {
+  size_t max_digits;
+  double min_time;
+  double limit;
+  int enabled[BENCH_OPS];
+  BenchResult *results;
+  size_t count, capacity;
+  int ok;
+} Bench;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Número decimal aleatório com digits dígitos (sem zero à esquerda)
+static char *random_digits(uint64_t *state, size_t digits) {
+  char *s = malloc(digits + 1);
+  if (s == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < digits; i++) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    s[i] = (char)('0' + (*state >> 32) % 10);
+  }
+  if (s[0] == '0') {
+    s[0] = '7';
+  }
+  s[digits] = '\0';
+  return s;
+}
+
+// Operandos de um tamanho
+typedef struct {
+  char *a_str;
+  BigInt *a;
+  BigInt *b;      // n dígitos
+  BigInt *b_half; // n/2 dígitos (divisor)
+} Operands;
+
+static void operands_free(Operands *o) {
+  free(o->a_str);
+  bigint_destroy(o->a);
+  bigint_destroy(o->b);
+  bigint_destroy(o->b_half);
+}
+
+static int operands_create(Operands *o, size_t digits, uint64_t *state) {
+  memset(o, 0, sizeof(Operands));
+  char *b_str = random_digits(state, digits);
+  o->a_str = random_digits(state, digits);
+  if (b_str != NULL && o->a_str != NULL) {
+    o->a = bigint_create_from_chars(o->a_str, digits);
+    o->b = bigint_create_from_chars(b_str, digits);
+    o->b_half = bigint_create_from_chars(b_str, digits > 1 ? digits / 2 : 1);
+  }
+  free(b_str);
+  if (o->a == NULL || o->b == NULL || o->b_half == NULL) {
+    operands_free(o);
+    return 0;
+  }
+  return 1;
+}
+
+// Executa a operação uma vez. Retorna 0 se ela falhou
+static int run_once(BenchOp op, const Operands *o, size_t digits) {
+  BigInt *r = NULL;
+  char *s = NULL;
+  switch (op) {
+  case BENCH_PARSE: r = bigint_create_from_chars(o->a_str, digits); break;
+  case BENCH_TO_STRING: s = bigint_to_string(o->a); break;
+  case BENCH_SUM: r = bigint_sum(o->a, o->b); break;
+  case BENCH_SUBTRACT: r = bigint_subtract(o->a, o->b); break;
+  case BENCH_MULTIPLY: r = bigint_multiplicacao(o->a, o->b); break;
+  case BENCH_DIVIDE: r = bigint_divisao(o->a, o->b_half); break;
+  case BENCH_MOD: r = bigint_mod(o->a, o->b_half); break;
+  case BENCH_GCD: r = bigint_gcd(o->a, o->b); break;
+  case BENCH_OPS: break;
+  }
+  int ok = r != NULL || s != NULL;
+  bigint_destroy(r);
+  free(s);
+  return ok;
+}
+
+static int add_result(Bench *b, BenchResult result) {
+  if (b->count == b->capacity) {
+    size_t cap = b->capacity > 0 ? 2 * b->capacity : 64;
+    BenchResult *bigger = realloc(b->results, cap * sizeof(BenchResult));
+    if (bigger == NULL) {
+      return 0;
+    }
+    b->results = bigger;
+    b->capacity = cap;
+  }
+  b->results[b->count++] = result;
+  return 1;
+}
+
+static void bench_task(void *arg) {
+  Bench *b = arg;
+  uint64_t state = 88172645463325252ULL;
+  int skipped[BENCH_OPS] = {0};
+  double previous[BENCH_OPS] = {0}; // Tempo por chamada no tamanho anterior
+
+  printf("%-10s %10s %9s %10s %16s %14s\n", "op", "digitos", "limbs",
+         "iteracoes", "ns/op", "limbs/s");
+  for (size_t digits = 1; digits <= b->max_digits; digits *= 10) {
+    Operands o;
+    if (!operands_create(&o, digits, &state)) {
+      fprintf(stderr, "Erro: memoria insuficiente em %zu digitos\n", digits);
+      b->ok = 0;
+      return;
+    }
+    size_t limbs = o.a->digits->length;
+
+    for (int op = 0; op < BENCH_OPS; op++) {
+      if (!b->enabled[op] || skipped[op]) {
+        continue;
+      }
+      size_t iterations = 0;
+      double start = now(), elapsed = 0;
+      do {
+        if (!run_once((BenchOp)op, &o, digits)) {
+          fprintf(stderr, "Erro: %s falhou em %zu digitos\n",
+                  bench_op_names[op], digits);
+          b->ok = 0;
+          break;
+        }
+        iterations++;
+        elapsed = now() - start;
+      } while (elapsed < b->min_time);
+      if (iterations == 0) {
+        skipped[op] = 1;
+        continue;
+      }
+
+      BenchResult r = {(BenchOp)op, digits, limbs, iterations,
+                       elapsed * 1e9 / (double)iterations,
+                       (double)limbs * (double)iterations / elapsed};
+      if (!add_result(b, r)) {
+        b->ok = 0;
+      }
+      printf("%-10s %10zu %9zu %10zu %16.1f %14.4g\n", bench_op_names[op],
+             digits, limbs, iterations, r.ns_per_op, r.limbs_per_second);
+      fflush(stdout);
+      double per_call = elapsed / (double)iterations;
+      double growth = previous[op] > 0 ? per_call / previous[op] : 10;
+      double estimate = per_call * (growth > 10 ? growth : 10);
+      previous[op] = per_call;
+      if (estimate > b->limit && digits * 10 <= b->max_digits) {
+        skipped[op] = 1;
+        printf("%-10s (tamanhos maiores pulados: estimativa de %.1f s por "
+               "chamada)\n",
+               bench_op_names[op], estimate);
+      }
+    }
+    operands_free(&o);
+  }
+}
+
+static int write_csv(const Bench *b, const char *path) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    perror("Erro ao abrir arquivo CSV");
+    return 0;
+  }
+  fprintf(f, "op,digits,limbs,iterations,ns_per_op,limbs_per_second\n");
+  for (size_t i = 0; i < b->count; i++) {
+    const BenchResult *r = &b->results[i];
+    fprintf(f, "%s,%zu,%zu,%zu,%.1f,%.6g\n", bench_op_names[r->op],
+            r->digits, r->limbs, r->iterations, r->ns_per_op,
+            r->limbs_per_second);
+  }
+  return fclose(f) == 0;
+}
+
+static int write_json(const Bench *b, const char *path, size_t threads) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    perror("Erro ao abrir arquivo JSON");
+    return 0;
+  }
+  fprintf(f, "{\n  \"threads\": %zu,\n  \"min_time\": %g,\n", threads,
+          b->min_time);
+  fprintf(f, "  \"results\": [\n");
+  for (size_t i = 0; i < b->count; i++) {
+    const BenchResult *r = &b->results[i];
+    fprintf(f,
+            "    {\"op\": \"%s\", \"digits\": %zu, \"limbs\": %zu, "
+            "\"iterations\": %zu, \"ns_per_op\": %.1f, "
+            "\"limbs_per_second\": %.6g}%s\n",
+            bench_op_names[r->op], r->digits, r->limbs, r->iterations,
+            r->ns_per_op, r->limbs_per_second, i + 1 < b->count ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+  return fclose(f) == 0;
+}
+
+// Habilita as operações de uma lista separada por vírgulas
+static int parse_ops(Bench *b, const char *list) {
+  memset(b->enabled, 0, sizeof(b->enabled));
+  while (*list != '\0') {
+    size_t len = strcspn(list, ",");
+    int found = 0;
+    for (int op = 0; op < BENCH_OPS; op++) {
+      if (strlen(bench_op_names[op]) == len &&
+          strncmp(bench_op_names[op], list, len) == 0) {
+        b->enabled[op] = found = 1;
+      }
+    }
+    if (!found) {
+      fprintf(stderr, "Erro: operacao desconhecida: %.*s\n", (int)len, list);
+      return 0;
+    }
+    list += len;
+    if (*list == ',') {
+      list++;
+    }
+  }
+  return 1;
+}
+
+int main(int argc, char *argv[]) {
+  Bench b = {0};
+  b.max_digits = 10000000;
+  b.min_time = 0.2;
+  b.limit = 10.0;
+  b.ok = 1;
+  for (int op = 0; op < BENCH_OPS; op++) {
+    b.enabled[op] = 1;
+  }
+  const char *csv = NULL, *json = NULL;
+  size_t threads = 1;
+
+  for (int i = 1; i < argc; i++) {
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (value != NULL && strcmp(argv[i], "--max-digitos") == 0) {
+      b.max_digits = strtoul(value, NULL, 10);
+    } else if (value != NULL && strcmp(argv[i], "--min-tempo") == 0) {
+      b.min_time = strtod(value, NULL);
+    } else if (value != NULL && strcmp(argv[i], "--limite") == 0) {
+      b.limit = strtod(value, NULL);
+    } else if (value != NULL && strcmp(argv[i], "--ops") == 0) {
+      if (!parse_ops(&b, value)) {
+        return 1;
+      }
+    } else if (value != NULL && strcmp(argv[i], "--csv") == 0) {
+      csv = value;
+    } else if (value != NULL && strcmp(argv[i], "--json") == 0) {
+      json = value;
+    } else if (value != NULL && strcmp(argv[i], "--threads") == 0) {
+      threads = strtoul(value, NULL, 10);
+    } else {
+      fprintf(stderr,
+              "Uso: %s [--max-digitos N] [--min-tempo S] [--limite S] "
+              "[--ops a,b,...] [--csv arquivo] [--json arquivo] "
+              "[--threads N]\n",
+              argv[0]);
+      return 1;
+    }
+    i++;
+  }
+
+  if (threads > 1) {
+    Scheduler *s = scheduler_create(threads);
+    if (s == NULL) {
+      fprintf(stderr, "Erro: nao foi possivel criar as threads\n");
+      return 1;
+    }
+    scheduler_run(s, bench_task, &b);
+    scheduler_destroy(s);
+  } else {
+    bench_task(&b);
+  }
+
+  if (csv != NULL && !write_csv(&b, csv)) {
+    b.ok = 0;
+  }
+  if (json != NULL && !write_json(&b, json, threads > 1 ? threads : 1)) {
+    b.ok = 0;
+  }
+  free(b.results);
+  return b.ok ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+// Gerador de carga para o modo servidor (--server)
+// Cada conexão tem uma thread que envia requisições "<id> <op> a b" e outra
+// que lê as respostas, com no máximo janela requisições pendentes. Mede a
+// vazão e a latência (p50, p99, p99.9, máximo) de cada requisição
+//
+// Uso: loadgen <socket> [requisicoes] [conexoes] [digitos] [op] [janela]
+
+// Operandos distintos sorteados por conexão (pares repetidos são raros,
+// então um cache no servidor quase não acerta)
+#define LOADGEN_POOL 1024
+
+typedef struct {
+  const char *path;
+  const char *op;
+  size_t requests; // Requisições desta conexão
+  size_t digits;
+  size_t window;
+  uint64_t seed;
+  int fd;
+  double *sent_at;   // Instante de envio de cada id
+  double *latencies; // Latência de cada id (segundos)
+  size_t received;
+  size_t errors;
+  pthread_mutex_t lock;
+  pthread_cond_t slot;
+  int failed;
+} Client;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+// Número decimal aleatório com digits dígitos (sem zero à esquerda)
+static char *random_number(uint64_t *state, size_t digits) {
+  char *s = malloc(digits + 1);
+  if (s == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < digits; i++) {
+    s[i] = (char)('0' + next_random(state) % 10);
+  }
+  if (digits > 0 && s[0] == '0') {
+    s[0] = '1';
+  }
+  s[digits] = '\0';
+  return s;
+}
+
+static int write_all(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return 0;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return 1;
+}
+
+static void *receiver(void *arg) {
+  Client *c = arg;
+  size_t capacity = 1 << 16, start = 0, filled = 0;
+  char *buffer = malloc(capacity);
+
+  while (buffer != NULL && c->received < c->requests) {
+    char *nl = memchr(buffer + start, '\n', filled - start);
+    if (nl == NULL) {
+      if (start > 0) {
+        memmove(buffer, buffer + start, filled - start);
+        filled -= start;
+        start = 0;
+      } else if (filled == capacity) {
+        char *bigger = realloc(buffer, 2 * capacity);
+        if (bigger == NULL) {
+          break;
+        }
+        buffer = bigger;
+        capacity *= 2;
+      }
+      ssize_t n = read(c->fd, buffer + filled, capacity - filled);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        break;
+      }
+      filled += (size_t)n;
+      continue;
+    }
+
+    double t = now();
+    char *line = buffer + start;
+    start = (size_t)(nl - buffer) + 1;
+    char *end;
+    size_t id = strtoul(line, &end, 10);
+    if (end == line || id >= c->requests) {
+      continue;
+    }
+    c->latencies[id] = t - c->sent_at[id];
+    if (strncmp(end, " OK", 3) != 0) {
+      c->errors++;
+    }
+
+    pthread_mutex_lock(&c->lock);
+    c->received++;
+    pthread_cond_signal(&c->slot);
+    pthread_mutex_unlock(&c->lock);
+  }
+
+  pthread_mutex_lock(&c->lock);
+  if (c->received < c->requests) {
+    c->failed = 1;
+  }
+  pthread_cond_signal(&c->slot);
+  pthread_mutex_unlock(&c->lock);
+  free(buffer);
+  return NULL;
+}
+
+static void *client_thread(void *arg) {
+  Client *c = arg;
+  char *pool[LOADGEN_POOL];
+  for (size_t i = 0; i < LOADGEN_POOL; i++) {
+    pool[i] = random_number(&c->seed, c->digits);
+    if (pool[i] == NULL) {
+      c->failed = 1;
+    }
+  }
+  size_t line_cap = 2 * c->digits + strlen(c->op) + 32;
+  char *line = malloc(line_cap);
+  pthread_t rx;
+  if (c->failed || line == NULL ||
+      pthread_create(&rx, NULL, receiver, c) != 0) {
+    c->failed = 1;
+    free(line);
+    for (size_t i = 0; i < LOADGEN_POOL; i++) {
+      free(pool[i]);
+    }
+    return NULL;
+  }
+
+  for (size_t id = 0; id < c->requests; id++) {
+    pthread_mutex_lock(&c->lock);
+    while (!c->failed && id - c->received >= c->window) {
+      pthread_cond_wait(&c->slot, &c->lock);
+    }
+    int failed = c->failed;
+    pthread_mutex_unlock(&c->lock);
+    if (failed) {
+      break;
+    }
+
+    const char *a = pool[next_random(&c->seed) % LOADGEN_POOL];
+    const char *b = pool[next_random(&c->seed) % LOADGEN_POOL];
+    int len = snprintf(line, line_cap, "%zu %s %s %s\n", id, c->op, a, b);
+    c->sent_at[id] = now();
+    if (!write_all(c->fd, line, (size_t)len)) {
+      pthread_mutex_lock(&c->lock);
+      c->failed = 1;
+      pthread_mutex_unlock(&c->lock);
+      break;
+    }
+  }
+
+  if (c->failed) {
+    shutdown(c->fd, SHUT_RDWR);
+  }
+  pthread_join(rx, NULL);
+  free(line);
+  for (size_t i = 0; i < LOADGEN_POOL; i++) {
+    free(pool[i]);
+  }
+  return NULL;
+}
+
+static int connect_socket(const char *path) {
+  struct sockaddr_un addr;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+static int compare_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Uso: %s <socket> [requisicoes] [conexoes] [digitos] [op] "
+            "[janela]\n",
+            argv[0]);
+    return 1;
+  }
+  size_t requests = argc > 2 ? strtoul(argv[2], NULL, 10) : 100000;
+  size_t connections = argc > 3 ? strtoul(argv[3], NULL, 10) : 4;
+  size_t digits = argc > 4 ? strtoul(argv[4], NULL, 10) : 100;
+  const char *op = argc > 5 ? argv[5] : "*";
+  size_t window = argc > 6 ? strtoul(argv[6], NULL, 10) : 64;
+  if (requests == 0 || connections == 0 || digits == 0 || window == 0) {
+    fprintf(stderr, "Erro: parametros devem ser positivos\n");
+    return 1;
+  }
+
+  Client *clients = calloc(connections, sizeof(Client));
+  if (clients == NULL) {
+    return 1;
+  }
+  for (size_t i = 0; i < connections; i++) {
+    Client *c = &clients[i];
+    c->path = argv[1];
+    c->op = op;
+    c->requests = requests / connections + (i < requests % connections);
+    c->digits = digits;
+    c->window = window;
+    c->seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+    c->sent_at = calloc(c->requests > 0 ? c->requests : 1, sizeof(double));
+    c->latencies = calloc(c->requests > 0 ? c->requests : 1, sizeof(double));
+    pthread_mutex_init(&c->lock, NULL);
+    pthread_cond_init(&c->slot, NULL);
+    c->fd = connect_socket(argv[1]);
+    if (c->fd < 0 || c->sent_at == NULL || c->latencies == NULL) {
+      fprintf(stderr, "Erro: nao foi possivel conectar em %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  pthread_t *tids = malloc(connections * sizeof(pthread_t));
+  if (tids == NULL) {
+    return 1;
+  }
+  double start = now();
+  for (size_t i = 0; i < connections; i++) {
+    pthread_create(&tids[i], NULL, client_thread, &clients[i]);
+  }
+  for (size_t i = 0; i < connections; i++) {
+    pthread_join(tids[i], NULL);
+  }
+  double elapsed = now() - start;
+
+  // Junta as latências de todas as conexões e ordena para os percentis
+  double *all = malloc(requests * sizeof(double));
+  size_t total = 0, errors = 0;
+  int failed = 0;
+  for (size_t i = 0; i < connections; i++) {
+    Client *c = &clients[i];
+    for (size_t j = 0; all != NULL && j < c->requests; j++) {
+      if (c->latencies[j] > 0) {
+        all[total++] = c->latencies[j];
+      }
+    }
+    errors += c->errors;
+    failed |= c->failed;
+    close(c->fd);
+    free(c->sent_at);
+    free(c->latencies);
+    pthread_mutex_destroy(&c->lock);
+    pthread_cond_destroy(&c->slot);
+  }
+  free(clients);
+  free(tids);
+  if (all == NULL || total == 0) {
+    fprintf(stderr, "Erro: nenhuma resposta recebida\n");
+    free(all);
+    return 1;
+  }
+  qsort(all, total, sizeof(double), compare_double);
+
+  printf("requisicoes: %zu (%zu erros) em %.3f s, %zu conexoes, janela %zu\n",
+         total, errors, elapsed, connections, window);
+  printf("vazao: %.0f req/s\n", (double)total / elapsed);
+  printf("latencia (ms): p50 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n",
+         all[total / 2] * 1e3, all[(size_t)((double)total * 0.99)] * 1e3,
+         all[(size_t)((double)total * 0.999)] * 1e3, all[total - 1] * 1e3);
+  free(all);
+  if (failed) {
+    fprintf(stderr, "Erro: conexao encerrada antes de todas as respostas\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "BigInt/BigInt.h"
+#include "Rns/Rns.h"
+#include "Scheduler/Scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Benchmark: avaliação de polinômio (Horner) em vários pontos
+// Compara a cadeia bigint_multiplicacao + bigint_sum com a mesma cadeia no
+// sistema de resíduos, reconstruindo o BigInt só no final
+//
+// Uso: rns_bench [grau] [bits dos pontos] [bits dos coeficientes] [pontos]
+//                [--threads N]
+
+typedef struct {
+  size_t degree, x_bits, coef_bits, points;
+  BigInt **coefs;
+  BigInt **xs;
+  BigInt **expected;
+  double bigint_seconds, rns_seconds, setup_seconds;
+  int ok;
+} Bench;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Inteiro aleatório com sinal e até bits bits (xorshift com semente fixa)
+static BigInt *random_bigint(uint64_t *state, size_t bits) {
+  size_t n = (bits + 31) / 32;
+  uint32_t *limbs = malloc((n > 0 ? n : 1) * sizeof(uint32_t));
+  if (limbs == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    limbs[i] = (uint32_t)(*state >> 16);
+  }
+  if (n > 0 && bits % 32 != 0) {
+    limbs[n - 1] &= (UINT32_C(1) << (bits % 32)) - 1;
+  }
+  BigInt *x = bigint_import_limbs(limbs, n, (*state & 1) ? -1 : 1);
+  free(limbs);
+  return x;
+}
+
+static BigInt *horner_bigint(BigInt **coefs, size_t degree, const BigInt *x) {
+  BigInt *acc = bigint_copy(coefs[degree]);
+  for (size_t i = degree; i-- > 0 && acc != NULL;) {
+    BigInt *prod = bigint_multiplicacao(acc, x);
+    bigint_destroy(acc);
+    acc = prod == NULL ? NULL : bigint_sum(prod, coefs[i]);
+    bigint_destroy(prod);
+  }
+  return acc;
+}
+
+static void bench_task(void *arg) {
+  Bench *b = arg;
+
+  double start = now();
+  for (size_t t = 0; t < b->points; t++) {
+    b->expected[t] = horner_bigint(b->coefs, b->degree, b->xs[t]);
+  }
+  b->bigint_seconds = now() - start;
+
+  // |P(x)| < (grau + 1) * 2^(coef_bits + grau * x_bits)
+  size_t bits = b->coef_bits + b->degree * b->x_bits + 64;
+  start = now();
+  RnsContext *ctx = rns_context_create(bits);
+  RnsNumber **coefs = calloc(b->degree + 1, sizeof(RnsNumber *));
+  if (ctx == NULL || coefs == NULL) {
+    rns_context_destroy(ctx);
+    free(coefs);
+    return;
+  }
+  for (size_t i = 0; i <= b->degree; i++) {
+    coefs[i] = rns_create_from_bigint(ctx, b->coefs[i]);
+  }
+  b->setup_seconds = now() - start;
+
+  b->ok = 1;
+  start = now();
+  for (size_t t = 0; t < b->points; t++) {
+    RnsNumber *x = rns_create_from_bigint(ctx, b->xs[t]);
+    RnsNumber *acc = rns_create_from_int(ctx, 0);
+    if (x == NULL || acc == NULL) {
+      b->ok = 0;
+      rns_destroy(x);
+      rns_destroy(acc);
+      break;
+    }
+    rns_add(acc, acc, coefs[b->degree]);
+    for (size_t i = b->degree; i-- > 0;) {
+      rns_mul(acc, acc, x);
+      rns_add(acc, acc, coefs[i]);
+    }
+    BigInt *result = rns_to_bigint(acc);
+    if (result == NULL || b->expected[t] == NULL ||
+        bigint_compare(result, b->expected[t]) != 0) {
+      b->ok = 0;
+    }
+    bigint_destroy(result);
+    rns_destroy(x);
+    rns_destroy(acc);
+  }
+  b->rns_seconds = now() - start;
+
+  for (size_t i = 0; i <= b->degree; i++) {
+    rns_destroy(coefs[i]);
+  }
+  free(coefs);
+  printf("primos: %zu\n", rns_context_size(ctx));
+  rns_context_destroy(ctx);
+}
+
+int main(int argc, char *argv[]) {
+  size_t args[4] = {64, 512, 512, 16};
+  size_t nargs = 0;
+  size_t threads = 1;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = strtoul(argv[++i], NULL, 10);
+    } else if (nargs < 4) {
+      args[nargs++] = strtoul(argv[i], NULL, 10);
+    }
+  }
+
+  Bench b = {0};
+  b.degree = args[0];
+  b.x_bits = args[1];
+  b.coef_bits = args[2];
+  b.points = args[3];
+  b.coefs = calloc(b.degree + 1, sizeof(BigInt *));
+  b.xs = calloc(b.points, sizeof(BigInt *));
+  b.expected = calloc(b.points, sizeof(BigInt *));
+  if (b.coefs == NULL || b.xs == NULL || b.expected == NULL) {
+    fprintf(stderr, "Erro: memoria insuficiente\n");
+    return 1;
+  }
+
+  uint64_t state = 88172645463325252ULL;
+  for (size_t i = 0; i <= b.degree; i++) {
+    b.coefs[i] = random_bigint(&state, b.coef_bits);
+  }
+  for (size_t t = 0; t < b.points; t++) {
+    b.xs[t] = random_bigint(&state, b.x_bits);
+  }
+
+  printf("grau %zu, pontos de %zu bits, coeficientes de %zu bits, "
+         "%zu pontos, %zu threads\n",
+         b.degree, b.x_bits, b.coef_bits, b.points, threads);
+
+  if (threads > 1) {
+    Scheduler *s = scheduler_create(threads);
+    if (s == NULL) {
+      fprintf(stderr, "Erro: nao foi possivel criar as threads\n");
+      return 1;
+    }
+    scheduler_run(s, bench_task, &b);
+    scheduler_destroy(s);
+  } else {
+    bench_task(&b);
+  }
+
+  printf("bigint (cadeia): %.3f s\n", b.bigint_seconds);
+  printf("rns (preparo):   %.3f s\n", b.setup_seconds);
+  printf("rns (cadeia):    %.3f s\n", b.rns_seconds);
+  printf("resultados %s\n", b.ok ? "iguais" : "DIFERENTES");
+
+  for (size_t i = 0; i <= b.degree; i++) {
+    bigint_destroy(b.coefs[i]);
+  }
+  for (size_t t = 0; t < b.points; t++) {
+    bigint_destroy(b.xs[t]);
+    bigint_destroy(b.expected[t]);
+  }
+  free(b.coefs);
+  free(b.xs);
+  free(b.expected);
+  return b.ok ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "Limbs/Limbs.h"
+#include "Radix/Radix.h"
+#include "Tuning/Tuning.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Afinador dos limiares de troca de algoritmo (make tune)
+// Para cada limiar, em uma varredura de tamanhos n, compara o algoritmo
+// básico sozinho (limiar "infinito") com um único nível do algoritmo rápido
+// por cima do básico (limiar = n). O limiar escolhido é o primeiro tamanho a
+// partir do qual o algoritmo rápido ganha em TUNE_CONFIRM tamanhos seguidos.
+// Os limiares são afinados em ordem (Karatsuba, NTT, Newton, conversão) e
+// cada um já usa os anteriores
+//
+// Uso: tune [arquivo.h]  (sem arquivo, só imprime os limiares)
+
+// Tempo mínimo de cada medida (repete a operação até atingir)
+#define TUNE_MIN_TIME 0.01
+
+// Medidas por tamanho e algoritmo (fica a menor)
+#define TUNE_REPEATS 3
+
+// Tamanhos seguidos em que o algoritmo rápido precisa ganhar
+#define TUNE_CONFIRM 3
+
+// Limiar "infinito" (com folga para as contas que o multiplicam)
+#define TUNE_INFINITE (SIZE_MAX / 64)
+
+typedef struct {
+  size_t max;
+  uint32_t *a, *b, *out, *q, *r;
+  char *dec;
+  size_t dec_capacity;
+} Buffers;
+
+typedef void (*TuneKernel)(Buffers *b, size_t n);
+
+typedef struct {
+  TuneParam param;
+  const char *label;
+  size_t first, last; // Tamanhos da varredura (limbs)
+  double step;        // Razão entre tamanhos seguidos
+  TuneKernel kernel;
+  size_t divisor; // Limiar = n / divisor liga um nível do algoritmo rápido
+} Sweep;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void kernel_mul(Buffers *b, size_t n) {
+  limbs_mul(b->out, b->a, n, b->b, n);
+}
+
+static void kernel_div(Buffers *b, size_t n) {
+  limbs_divmod(b->q, b->r, b->a, 2 * n, b->b, n);
+}
+
+static void kernel_radix(Buffers *b, size_t n) {
+  radix_write_decimal(b->dec + b->dec_capacity, b->a, n);
+}
+
+// Menor tempo por chamada entre TUNE_REPEATS medidas
+static double measure(TuneKernel kernel, Buffers *b, size_t n) {
+  double best = 0;
+  for (int rep = 0; rep < TUNE_REPEATS; rep++) {
+    size_t iterations = 0;
+    double start = now(), elapsed;
+    do {
+      kernel(b, n);
+      iterations++;
+      elapsed = now() - start;
+    } while (elapsed < TUNE_MIN_TIME);
+    double t = elapsed / (double)iterations;
+    if (rep == 0 || t < best) {
+      best = t;
+    }
+  }
+  return best;
+}
+
+static size_t tune(const Sweep *sw, Buffers *b) {
+  printf("%s (%s)\n", sw->label, tuning_name(sw->param));
+  printf("%10s %14s %14s %8s\n", "limbs", "basico (us)", "rapido (us)",
+         "razao");
+
+  size_t wins = 0, candidate = 0;
+  for (size_t n = sw->first; n <= sw->last;) {
+    tuning_set(sw->param, TUNE_INFINITE);
+    double base = measure(sw->kernel, b, n);
+    tuning_set(sw->param, n / sw->divisor);
+    double fast = measure(sw->kernel, b, n);
+    printf("%10zu %14.2f %14.2f %8.3f\n", n, base * 1e6, fast * 1e6,
+           fast / base);
+    fflush(stdout);
+
+    if (fast < base) {
+      if (wins++ == 0) {
+        candidate = n / sw->divisor;
+      }
+      if (wins == TUNE_CONFIRM) {
+        break;
+      }
+    } else {
+      wins = 0;
+    }
+
+    size_t next = (size_t)((double)n * sw->step);
+    n = next > n ? next : n + 1;
+  }
+
+  size_t value = tuning_default(sw->param);
+  if (wins > 0) {
+    value = candidate;
+    printf("-> %s = %zu\n\n", tuning_name(sw->param), value);
+  } else {
+    printf("-> sem cruzamento ate %zu limbs, mantendo %s = %zu\n\n",
+           sw->last, tuning_name(sw->param), value);
+  }
+  tuning_set(sw->param, value);
+  return value;
+}
+
+static int buffers_create(Buffers *b, size_t max) {
+  memset(b, 0, sizeof(Buffers));
+  b->max = max;
+  b->a = malloc(2 * max * sizeof(uint32_t));
+  b->b = malloc(max * sizeof(uint32_t));
+  b->out = malloc(2 * max * sizeof(uint32_t));
+  b->q = malloc((max + 1) * sizeof(uint32_t));
+  b->r = malloc(max * sizeof(uint32_t));
+  b->dec_capacity = radix_decimal_capacity(max);
+  b->dec = malloc(b->dec_capacity);
+  if (b->a == NULL || b->b == NULL || b->out == NULL || b->q == NULL ||
+      b->r == NULL || b->dec == NULL) {
+    return 0;
+  }
+
+  // Todos os limbs com o bit mais alto ligado: qualquer prefixo é um
+  // número normalizado (divisor e conversão)
+  uint64_t state = 88172645463325252ULL;
+  for (size_t i = 0; i < 2 * max; i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    b->a[i] = (uint32_t)(state >> 32) | 0x80000000u;
+    if (i < max) {
+      b->b[i] = (uint32_t)state | 0x80000000u;
+    }
+  }
+  return 1;
+}
+
+static void buffers_free(Buffers *b) {
+  free(b->a);
+  free(b->b);
+  free(b->out);
+  free(b->q);
+  free(b->r);
+  free(b->dec);
+}
+
+static int write_header(const char *path, const size_t *values) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    perror("Erro ao gravar o cabecalho");
+    return 0;
+  }
+  char date[64] = "";
+  time_t t = time(NULL);
+  struct tm tm;
+  if (localtime_r(&t, &tm) != NULL) {
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+  }
+
+  static const char *macros[TUNE_PARAMS] = {
+      "TUNED_KARATSUBA_THRESHOLD", "TUNED_NTT_THRESHOLD",
+      "TUNED_DIV_NEWTON_THRESHOLD", "TUNED_RADIX_DC_THRESHOLD"};
+  fprintf(f, "// Gerado por \"make tune\" em %s. Nao edite: rode make tune de\n",
+          date);
+  fprintf(f, "// novo ou sobrescreva na execucao com as variaveis PE_*\n");
+  fprintf(f, "#ifndef TUNED_H\n#define TUNED_H\n\n");
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    fprintf(f, "#define %s %zu\n", macros[p], values[p]);
+  }
+  fprintf(f, "\n#endif // TUNED_H\n");
+  if (fclose(f) != 0) {
+    perror("Erro ao gravar o cabecalho");
+    return 0;
+  }
+  printf("Limiares gravados em %s\n", path);
+  return 1;
+}
+
+int main(int argc, char *argv[]) {
+  const Sweep sweeps[TUNE_PARAMS] = {
+      {TUNE_KARATSUBA, "Escolar x Karatsuba (multiplicacao n x n)", 8, 512,
+       1.15, kernel_mul, 1},
+      {TUNE_NTT, "Karatsuba x NTT (multiplicacao n x n)", 1024, 131072, 1.3,
+       kernel_mul, 1},
+      {TUNE_DIV_NEWTON, "Knuth D x Newton (divisao 2n / n)", 64, 16384, 1.3,
+       kernel_div, 1},
+      {TUNE_RADIX_DC, "Grupo a grupo x divisao e conquista (n limbs -> "
+                      "decimal; limiar = n / 2)",
+       16, 8192, 1.3, kernel_radix, 2},
+  };
+
+  Buffers b;
+  if (!buffers_create(&b, 131072)) {
+    fprintf(stderr, "Erro: memoria insuficiente\n");
+    buffers_free(&b);
+    return 1;
+  }
+
+  // Parte dos valores compilados, sem as variáveis de ambiente; a NTT fica
+  // desligada enquanto Karatsuba é afinado
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    tuning_set((TuneParam)p, tuning_default((TuneParam)p));
+  }
+  tuning_set(TUNE_NTT, TUNE_INFINITE);
+  tuning_set(TUNE_DIV_NEWTON, TUNE_INFINITE);
+
+  size_t values[TUNE_PARAMS];
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    values[p] = tune(&sweeps[p], &b);
+  }
+  buffers_free(&b);
+
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    printf("%s = %zu (padrao %zu)\n", tuning_name((TuneParam)p), values[p],
+           tuning_default((TuneParam)p));
+  }
+  if (argc > 1 && !write_header(argv[1], values)) {
+    return 1;
+  }
+  return 0;
+}
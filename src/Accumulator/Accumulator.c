@@ -0,0 +1,224 @@
+#include "Accumulator.h"
+#include "../Limbs/Limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Parcelas (valores < 2^32) que cada posição recebe entre duas
+// normalizações. Depois de normalizada uma posição é < 2^32, então
+// 2^32 - 1 + ACC_MAX_PENDING * (2^32 - 1) mais o carry ainda cabem em 64 bits
+#define ACC_MAX_PENDING (UINT32_MAX - 1)
+
+// A partir deste tamanho (limbs do menor fator) acc_addmul multiplica com
+// limbs_mul (Karatsuba/NTT) e acumula o produto pronto
+#define ACC_MUL_DIRECT_MAX 32
+
+struct BigIntAccumulator {
+  uint64_t *pos; // Somas parciais das parcelas positivas
+  uint64_t *neg; // Somas parciais das parcelas negativas
+  size_t len;    // Posições em uso
+  size_t cap;
+  uint64_t pending; // Parcelas por posição desde a última normalização
+};
+
+BigIntAccumulator *acc_create(void) {
+  return calloc(1, sizeof(BigIntAccumulator));
+}
+
+void acc_destroy(BigIntAccumulator *acc) {
+  if (acc == NULL) {
+    return;
+  }
+  free(acc->pos);
+  free(acc->neg);
+  free(acc);
+}
+
+// Garante n posições (as novas começam em zero)
+static int ensure(BigIntAccumulator *acc, size_t n) {
+  if (n <= acc->cap) {
+    return 1;
+  }
+
+  size_t cap = acc->cap > 0 ? acc->cap : 16;
+  while (cap < n) {
+    cap *= 2;
+  }
+  uint64_t *pos = realloc(acc->pos, cap * sizeof(uint64_t));
+  if (pos == NULL) {
+    return 0;
+  }
+  acc->pos = pos;
+  uint64_t *neg = realloc(acc->neg, cap * sizeof(uint64_t));
+  if (neg == NULL) {
+    return 0;
+  }
+  acc->neg = neg;
+
+  memset(acc->pos + acc->cap, 0, (cap - acc->cap) * sizeof(uint64_t));
+  memset(acc->neg + acc->cap, 0, (cap - acc->cap) * sizeof(uint64_t));
+  acc->cap = cap;
+  return 1;
+}
+
+// Propaga os carries de um lado: cada posição volta a ser < 2^32
+static int carry_side(BigIntAccumulator *acc, uint64_t *side) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < acc->len; i++) {
+    uint64_t v = side[i] + carry;
+    side[i] = v & UINT32_MAX;
+    carry = v >> 32;
+  }
+  while (carry != 0) {
+    // ensure pode realocar o array deste lado
+    int is_pos = side == acc->pos;
+    if (!ensure(acc, acc->len + 1)) {
+      return 0;
+    }
+    side = is_pos ? acc->pos : acc->neg;
+    side[acc->len++] = carry & UINT32_MAX;
+    carry >>= 32;
+  }
+  return 1;
+}
+
+static int normalize(BigIntAccumulator *acc) {
+  if (!carry_side(acc, acc->pos) || !carry_side(acc, acc->neg)) {
+    return 0;
+  }
+  acc->pending = 0;
+  return 1;
+}
+
+// Reserva n posições para uma operação que acrescenta até units parcelas
+// em cada posição, normalizando antes se alguma puder estourar
+static int reserve(BigIntAccumulator *acc, size_t n, uint64_t units) {
+  if (acc->pending + units > ACC_MAX_PENDING && !normalize(acc)) {
+    return 0;
+  }
+  if (!ensure(acc, n)) {
+    return 0;
+  }
+  if (n > acc->len) {
+    acc->len = n;
+  }
+  acc->pending += units;
+  return 1;
+}
+
+static int add_list(BigIntAccumulator *acc, const BigInt *x, int negative) {
+  if (acc == NULL || x == NULL) {
+    return 0;
+  }
+  if (!reserve(acc, x->digits->length, 1)) {
+    return 0;
+  }
+
+  // Percorre a lista direto, sem exportar para um array
+  uint64_t *side = negative ? acc->neg : acc->pos;
+  size_t i = 0;
+  for (const ListNode *node = x->digits->head; node != NULL;
+       node = node->next) {
+    side[i++] += node->value;
+  }
+  return 1;
+}
+
+int acc_add(BigIntAccumulator *acc, const BigInt *x) {
+  return add_list(acc, x, x != NULL && x->sign < 0);
+}
+
+int acc_sub(BigIntAccumulator *acc, const BigInt *x) {
+  return add_list(acc, x, x != NULL && x->sign > 0);
+}
+
+int acc_addmul(BigIntAccumulator *acc, const BigInt *a, const BigInt *b) {
+  if (acc == NULL || a == NULL || b == NULL) {
+    return 0;
+  }
+
+  size_t an = 0, bn = 0;
+  uint32_t *al = bigint_export_limbs(a, &an);
+  uint32_t *bl = bigint_export_limbs(b, &bn);
+  if (al == NULL || bl == NULL) {
+    free(al);
+    free(bl);
+    return 0;
+  }
+  an = limbs_normalized_length(al, an);
+  bn = limbs_normalized_length(bl, bn);
+
+  int ok = 1;
+  size_t small = an < bn ? an : bn;
+  if (small > 0) {
+    if (small < ACC_MUL_DIRECT_MAX) {
+      // Cada produto de limbs vira duas parcelas: a parte baixa na posição
+      // i + j e a alta na i + j + 1, então cada posição recebe no máximo
+      // 2 * small parcelas
+      ok = reserve(acc, an + bn, 2 * (uint64_t)small);
+      if (ok) {
+        uint64_t *side = a->sign == b->sign ? acc->pos : acc->neg;
+        for (size_t i = 0; i < an; i++) {
+          uint64_t ai = al[i];
+          for (size_t j = 0; j < bn; j++) {
+            uint64_t prod = ai * bl[j];
+            side[i + j] += prod & UINT32_MAX;
+            side[i + j + 1] += prod >> 32;
+          }
+        }
+      }
+    } else {
+      uint32_t *prod = malloc((an + bn) * sizeof(uint32_t));
+      ok = prod != NULL && reserve(acc, an + bn, 1);
+      if (ok) {
+        limbs_mul(prod, al, an, bl, bn);
+        uint64_t *side = a->sign == b->sign ? acc->pos : acc->neg;
+        for (size_t i = 0; i < an + bn; i++) {
+          side[i] += prod[i];
+        }
+      }
+      free(prod);
+    }
+  }
+
+  free(al);
+  free(bl);
+  return ok;
+}
+
+BigInt *acc_finish(BigIntAccumulator *acc) {
+  if (acc == NULL || !normalize(acc)) {
+    return NULL;
+  }
+
+  size_t n = acc->len;
+  uint32_t *pos = malloc((n > 0 ? n : 1) * sizeof(uint32_t));
+  uint32_t *neg = malloc((n > 0 ? n : 1) * sizeof(uint32_t));
+  if (pos == NULL || neg == NULL) {
+    free(pos);
+    free(neg);
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    pos[i] = (uint32_t)acc->pos[i];
+    neg[i] = (uint32_t)acc->neg[i];
+  }
+
+  // Resultado = positivas - negativas, com o sinal do maior
+  BigInt *result;
+  if (limbs_cmp(pos, n, neg, n) >= 0) {
+    limbs_sub(pos, pos, n, neg, n);
+    result = bigint_import_limbs(pos, n, 1);
+  } else {
+    limbs_sub(neg, neg, n, pos, n);
+    result = bigint_import_limbs(neg, n, -1);
+  }
+  free(pos);
+  free(neg);
+
+  if (result != NULL && n > 0) {
+    memset(acc->pos, 0, acc->len * sizeof(uint64_t));
+    memset(acc->neg, 0, acc->len * sizeof(uint64_t));
+    acc->len = 0;
+  }
+  return result;
+}
@@ -0,0 +1,34 @@
+#ifndef ACCUMULATOR_H
+#define ACCUMULATOR_H
+
+#include "../BigInt/BigInt.h"
+
+// Acumulador com "vai um" adiado (carry-save) para somas longas
+// Cada posição guarda uma soma parcial de 64 bits dos limbs de 32 bits que
+// caem nela, então somar um número é só somar limbs, sem alocar e sem
+// propagar carries. Os carries são resolvidos em acc_finish (ou quando
+// alguma posição poderia estourar, a cada ~2^32 parcelas). Parcelas
+// positivas e negativas ficam separadas e são subtraídas só no final
+
+typedef struct BigIntAccumulator BigIntAccumulator;
+
+// Cria um acumulador com valor zero. Retorna NULL se faltou memória
+BigIntAccumulator *acc_create(void);
+
+// Destrói um acumulador
+void acc_destroy(BigIntAccumulator *acc);
+
+// acc += x e acc -= x. Retornam 1 em sucesso ou 0 em erro
+int acc_add(BigIntAccumulator *acc, const BigInt *x);
+int acc_sub(BigIntAccumulator *acc, const BigInt *x);
+
+// acc += a * b (multiplica e acumula, para produtos escalares)
+// Operandos pequenos são multiplicados direto nas posições do acumulador;
+// grandes usam limbs_mul. Retorna 1 em sucesso ou 0 em erro
+int acc_addmul(BigIntAccumulator *acc, const BigInt *a, const BigInt *b);
+
+// Resolve os carries e retorna o valor acumulado (NULL se faltou memória)
+// O acumulador volta a zero e pode ser reutilizado
+BigInt *acc_finish(BigIntAccumulator *acc);
+
+#endif // ACCUMULATOR_H
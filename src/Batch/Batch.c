@@ -0,0 +1,686 @@
+#include "Batch.h"
+#include "../Accumulator/Accumulator.h"
+#include "../ExecContext/ExecContext.h"
+#include "../InputFile/InputFile.h"
+#include "../Power/Power.h"
+#include "../Prime/Prime.h"
+#include "../ProductTree/ProductTree.h"
+#include "../Roots/Roots.h"
+#include "../Scheduler/Scheduler.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Tamanho do buffer de saída (um único fluxo bufferizado para todo o lote)
+#define BATCH_OUTPUT_BUFFER (1 << 20)
+
+// Saída de uma linha que estourou o tempo limite
+#define BATCH_TIMEOUT_TEXT "TEMPO ESGOTADO"
+
+typedef struct {
+  const char *name;
+  BatchOp op;
+} BatchOpName;
+
+static const BatchOpName batch_op_names[] = {
+    {"1", BATCH_OP_SOMA},
+    {"+", BATCH_OP_SOMA},
+    {"soma", BATCH_OP_SOMA},
+    {"2", BATCH_OP_SUBTRACAO},
+    {"-", BATCH_OP_SUBTRACAO},
+    {"sub", BATCH_OP_SUBTRACAO},
+    {"3", BATCH_OP_MULTIPLICACAO},
+    {"*", BATCH_OP_MULTIPLICACAO},
+    {"mul", BATCH_OP_MULTIPLICACAO},
+    {"4", BATCH_OP_DIVISAO},
+    {"/", BATCH_OP_DIVISAO},
+    {"div", BATCH_OP_DIVISAO},
+    {"5", BATCH_OP_MODULO},
+    {"%", BATCH_OP_MODULO},
+    {"mod", BATCH_OP_MODULO},
+    {"6", BATCH_OP_MDC},
+    {"mdc", BATCH_OP_MDC},
+    {"gcd", BATCH_OP_MDC},
+    {"7", BATCH_OP_FATORIAL},
+    {"!", BATCH_OP_FATORIAL},
+    {"fat", BATCH_OP_FATORIAL},
+    {"8", BATCH_OP_BINOMIAL},
+    {"binom", BATCH_OP_BINOMIAL},
+    {"9", BATCH_OP_PRODUTO},
+    {"prod", BATCH_OP_PRODUTO},
+    {"10", BATCH_OP_SOMATORIO},
+    {"sum", BATCH_OP_SOMATORIO},
+    {"11", BATCH_OP_PRODUTO_ESCALAR},
+    {"dot", BATCH_OP_PRODUTO_ESCALAR},
+    {"12", BATCH_OP_RAIZ_QUADRADA},
+    {"sqrt", BATCH_OP_RAIZ_QUADRADA},
+    {"13", BATCH_OP_RAIZ},
+    {"root", BATCH_OP_RAIZ},
+    {"14", BATCH_OP_POTENCIA_PERFEITA},
+    {"ispow", BATCH_OP_POTENCIA_PERFEITA},
+    {"15", BATCH_OP_POTENCIA},
+    {"^", BATCH_OP_POTENCIA},
+    {"pow", BATCH_OP_POTENCIA},
+    {"16", BATCH_OP_FIBONACCI},
+    {"fib", BATCH_OP_FIBONACCI},
+    {"17", BATCH_OP_LUCAS},
+    {"lucas", BATCH_OP_LUCAS},
+    {"18", BATCH_OP_PRIMO},
+    {"isprime", BATCH_OP_PRIMO},
+    {"19", BATCH_OP_PROXIMO_PRIMO},
+    {"nextprime", BATCH_OP_PROXIMO_PRIMO},
+};
+
+// Converte o token de operação de uma linha em BatchOp
+BatchOp batch_parse_op(const char *token, size_t len) {
+  if (token == NULL) {
+    return BATCH_OP_INVALIDA;
+  }
+
+  size_t count = sizeof(batch_op_names) / sizeof(batch_op_names[0]);
+  for (size_t i = 0; i < count; i++) {
+    if (strlen(batch_op_names[i].name) == len &&
+        memcmp(batch_op_names[i].name, token, len) == 0) {
+      return batch_op_names[i].op;
+    }
+  }
+  return BATCH_OP_INVALIDA;
+}
+
+// Retorna quantos operandos a operação recebe
+int batch_op_operands(BatchOp op) {
+  switch (op) {
+  case BATCH_OP_FATORIAL:
+  case BATCH_OP_RAIZ_QUADRADA:
+  case BATCH_OP_POTENCIA_PERFEITA:
+  case BATCH_OP_FIBONACCI:
+  case BATCH_OP_LUCAS:
+  case BATCH_OP_PRIMO:
+  case BATCH_OP_PROXIMO_PRIMO: return 1;
+  case BATCH_OP_PRODUTO:
+  case BATCH_OP_SOMATORIO:
+  case BATCH_OP_PRODUTO_ESCALAR: return BATCH_OPERANDOS_VARIAVEL;
+  default: return 2;
+  }
+}
+
+// Somatório (pares == 0) ou produto escalar (pares != 0) no acumulador
+static BigInt *accumulate(const BigInt **xs, size_t n, int pairs) {
+  if (pairs && n % 2 != 0) {
+    return NULL;
+  }
+  BigIntAccumulator *acc = acc_create();
+  if (acc == NULL) {
+    return NULL;
+  }
+
+  int ok = 1;
+  for (size_t i = 0; i < n && ok; i += pairs ? 2 : 1) {
+    ok = pairs ? acc_addmul(acc, xs[i], xs[i + 1]) : acc_add(acc, xs[i]);
+  }
+  BigInt *result = ok ? acc_finish(acc) : NULL;
+  acc_destroy(acc);
+  return result;
+}
+
+// Raiz k-ésima com k lido de um BigInt (1 <= k < 2^32)
+static BigInt *root_operand(const BigInt *x, const BigInt *k) {
+  int overflow;
+  uint64_t kk = bigint_to_u64(k, &overflow);
+  if (overflow || kk > UINT32_MAX) {
+    return NULL;
+  }
+  return bigint_root(x, (uint32_t)kk);
+}
+
+// Executa uma operação sobre n operandos (NULL em erro)
+BigInt *batch_apply_n(BatchOp op, const BigInt **xs, size_t n) {
+  if (op == BATCH_OP_INVALIDA || xs == NULL) {
+    return NULL;
+  }
+
+  int operands = batch_op_operands(op);
+  if (operands == BATCH_OPERANDOS_VARIAVEL ? n == 0 : n != (size_t)operands) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (xs[i] == NULL) {
+      return NULL;
+    }
+  }
+
+  const BigInt *a = xs[0];
+  const BigInt *b = n > 1 ? xs[1] : NULL;
+  switch (op) {
+  case BATCH_OP_SOMA: return bigint_sum(a, b);
+  case BATCH_OP_SUBTRACAO: return bigint_subtract(a, b);
+  case BATCH_OP_MULTIPLICACAO: return bigint_multiplicacao(a, b);
+  case BATCH_OP_DIVISAO: return bigint_divisao(a, b);
+  case BATCH_OP_MODULO: return bigint_mod(a, b);
+  case BATCH_OP_MDC: return bigint_gcd((BigInt *)a, (BigInt *)b);
+  case BATCH_OP_FATORIAL: return bigint_factorial(a);
+  case BATCH_OP_BINOMIAL: return bigint_binomial(a, b);
+  case BATCH_OP_PRODUTO: return bigint_product(xs, n);
+  case BATCH_OP_SOMATORIO: return accumulate(xs, n, 0);
+  case BATCH_OP_PRODUTO_ESCALAR: return accumulate(xs, n, 1);
+  case BATCH_OP_RAIZ_QUADRADA: return bigint_sqrtrem(a, NULL);
+  case BATCH_OP_RAIZ: return root_operand(a, b);
+  case BATCH_OP_POTENCIA_PERFEITA:
+    return bigint_create_from_int(bigint_is_perfect_power(a, NULL, NULL));
+  case BATCH_OP_POTENCIA: return bigint_pow(a, b);
+  case BATCH_OP_FIBONACCI: return bigint_fib(a);
+  case BATCH_OP_LUCAS: return bigint_lucas(a);
+  case BATCH_OP_PRIMO:
+    return bigint_create_from_int(
+        bigint_is_probable_prime(a, PRIME_DEFAULT_ROUNDS));
+  case BATCH_OP_PROXIMO_PRIMO:
+    return bigint_next_prime(a, PRIME_DEFAULT_ROUNDS);
+  default: return NULL;
+  }
+}
+
+// Executa uma operação passando antes pelo cache de resultados
+BigInt *batch_apply_cached(ResultCache *cache, BatchOp op, const BigInt **xs,
+                           size_t n) {
+  if (cache == NULL) {
+    return batch_apply_n(op, xs, n);
+  }
+
+  BigInt *result = cache_lookup(cache, op, xs, n);
+  if (result == NULL) {
+    result = batch_apply_n(op, xs, n);
+    // Uma operação interrompida pode ter resultado parcial: não entra
+    if (!exec_stopped()) {
+      cache_store(cache, op, xs, n, result);
+    }
+  }
+  return result;
+}
+
+// Executa uma operação e retorna o resultado (NULL em erro)
+BigInt *batch_apply(BatchOp op, const BigInt *a, const BigInt *b) {
+  const BigInt *xs[2] = {a, b};
+  return batch_apply_n(op, xs, b != NULL ? 2 : 1);
+}
+
+// Executa uma linha "op a [b ...]" e retorna o resultado em decimal
+// Os operandos são passados ao parser direto do span da linha, sem cópia
+// Retorna NULL se a linha for inválida ou a operação falhar
+static char *execute_operation(ResultCache *cache, const char *line,
+                               size_t end) {
+  size_t pos = 0;
+  const char *token = NULL;
+  size_t token_len = 0;
+
+  if (!inputfile_next_token(line, end, &pos, &token, &token_len)) {
+    return NULL;
+  }
+  BatchOp op = batch_parse_op(token, token_len);
+  if (op == BATCH_OP_INVALIDA) {
+    return NULL;
+  }
+
+  size_t count = 0;
+  size_t capacity = 2;
+  BigInt **xs = malloc(capacity * sizeof(BigInt *));
+  int ok = xs != NULL;
+  while (ok && inputfile_next_token(line, end, &pos, &token, &token_len)) {
+    if (count == capacity) {
+      BigInt **maior = realloc(xs, 2 * capacity * sizeof(BigInt *));
+      if (maior == NULL) {
+        ok = 0;
+        break;
+      }
+      xs = maior;
+      capacity *= 2;
+    }
+    xs[count] = bigint_create_from_chars(token, token_len);
+    ok = xs[count++] != NULL;
+  }
+
+  BigInt *result =
+      ok ? batch_apply_cached(cache, op, (const BigInt **)xs, count) : NULL;
+  for (size_t i = 0; i < count; i++) {
+    bigint_destroy(xs[i]);
+  }
+  free(xs);
+
+  char *res_str = bigint_to_string(result);
+  bigint_destroy(result);
+  return res_str;
+}
+
+// Executa uma linha com até seconds segundos (<= 0: sem limite), dentro de
+// um ExecContext. Se o tempo acabar, o resultado é BATCH_TIMEOUT_TEXT
+static char *execute_line(ResultCache *cache, const char *line, size_t end,
+                          double seconds) {
+  ExecContext exec;
+  exec_init(&exec);
+  exec_set_deadline(&exec, seconds);
+  ExecContext *previous = exec_enter(&exec);
+  char *res_str = execute_operation(cache, line, end);
+  exec_leave(previous);
+
+  if (exec_status(&exec) != EXEC_OK) {
+    free(res_str);
+    res_str = malloc(sizeof(BATCH_TIMEOUT_TEXT));
+    if (res_str != NULL) {
+      memcpy(res_str, BATCH_TIMEOUT_TEXT, sizeof(BATCH_TIMEOUT_TEXT));
+    }
+  }
+  return res_str;
+}
+
+static int is_timeout(const char *res_str) {
+  return res_str != NULL && strcmp(res_str, BATCH_TIMEOUT_TEXT) == 0;
+}
+
+// Avança até a próxima linha com operação (ignora vazias e comentários)
+// Retorna 1 e preenche *line/*len se encontrou
+static int next_line(const InputFile *in, size_t *pos, const char **line,
+                     size_t *len) {
+  while (*pos < in->size) {
+    const char *start = in->data + *pos;
+    const char *newline = memchr(start, '\n', in->size - *pos);
+    size_t line_len = newline ? (size_t)(newline - start) : in->size - *pos;
+    *pos += line_len + 1;
+
+    size_t first = 0;
+    while (first < line_len && (start[first] == ' ' || start[first] == '\t' ||
+                                start[first] == '\r')) {
+      first++;
+    }
+    if (first == line_len || start[first] == '#') {
+      continue;
+    }
+
+    *line = start + first;
+    *len = line_len - first;
+    return 1;
+  }
+  return 0;
+}
+
+// Escreve um resultado (ou "ERRO") no fluxo de saída
+static void write_result(FILE *fout, const char *res_str) {
+  fputs(res_str != NULL ? res_str : "ERRO", fout);
+  fputc('\n', fout);
+}
+
+typedef struct {
+  size_t total;
+  size_t erros;
+  size_t esgotadas; // Linhas que estouraram o tempo limite
+} BatchCounts;
+
+static void count_result(BatchCounts *counts, const char *res_str) {
+  counts->total++;
+  if (res_str == NULL) {
+    counts->erros++;
+  } else if (is_timeout(res_str)) {
+    counts->esgotadas++;
+  }
+}
+
+// Execução em uma única thread: lê, executa e escreve em sequência
+static void run_sequential(const InputFile *in, FILE *fout,
+                           ResultCache *cache, double seconds,
+                           BatchCounts *counts) {
+  size_t pos = 0;
+  const char *line;
+  size_t len;
+
+  while (next_line(in, &pos, &line, &len)) {
+    char *res_str = execute_line(cache, line, len, seconds);
+    write_result(fout, res_str);
+    count_result(counts, res_str);
+    free(res_str);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Pipeline multi-thread: leitor -> escalonador work-stealing -> janela de
+// reordenação -> escritor. Cada linha vira uma tarefa do Scheduler; operações
+// grandes (como multiplicações enormes) se dividem em subtarefas que workers
+// ociosos roubam. A janela de reordenação é limitada, então o leitor bloqueia
+// quando os workers ou o escritor ficam para trás (back-pressure).
+// ---------------------------------------------------------------------------
+
+// Tamanho da janela de reordenação por worker
+#define BATCH_WINDOW_PER_THREAD 16
+
+typedef struct BatchPipeline BatchPipeline;
+
+typedef struct {
+  BatchPipeline *p;
+  size_t seq;       // Posição da operação na entrada
+  const char *line; // Span da linha dentro do arquivo mapeado
+  size_t len;
+} BatchJob;
+
+struct BatchPipeline {
+  // Janela de reordenação: a operação seq usa o slot seq % window_capacity
+  BatchJob *jobs;
+  char **results;
+  int *ready;
+  size_t window_capacity;
+  size_t next_write; // Próxima operação a ser escrita
+  size_t total;      // Total de operações (válido quando input_done)
+  int input_done;    // Leitor terminou
+  BatchCounts counts;
+  pthread_mutex_t window_lock;
+  pthread_cond_t window_ready;
+  pthread_cond_t window_free;
+
+  FILE *fout;
+  ResultCache *cache;
+  double seconds; // Tempo limite de cada linha (<= 0: sem limite)
+};
+
+static void pipeline_task(void *arg) {
+  BatchJob *job = arg;
+  BatchPipeline *p = job->p;
+
+  char *res_str = execute_line(p->cache, job->line, job->len, p->seconds);
+
+  pthread_mutex_lock(&p->window_lock);
+  size_t slot = job->seq % p->window_capacity;
+  p->results[slot] = res_str;
+  p->ready[slot] = 1;
+  if (job->seq == p->next_write) {
+    pthread_cond_signal(&p->window_ready);
+  }
+  pthread_mutex_unlock(&p->window_lock);
+}
+
+static void *pipeline_writer(void *arg) {
+  BatchPipeline *p = arg;
+
+  pthread_mutex_lock(&p->window_lock);
+  while (1) {
+    size_t slot = p->next_write % p->window_capacity;
+    while (!p->ready[slot] &&
+           !(p->input_done && p->next_write == p->total)) {
+      pthread_cond_wait(&p->window_ready, &p->window_lock);
+    }
+    if (!p->ready[slot]) {
+      break; // Todas as operações foram escritas
+    }
+
+    char *res_str = p->results[slot];
+    p->results[slot] = NULL;
+    p->ready[slot] = 0;
+    p->next_write++;
+    pthread_cond_broadcast(&p->window_free);
+
+    // Escreve fora da região crítica para não segurar os workers
+    pthread_mutex_unlock(&p->window_lock);
+    write_result(p->fout, res_str);
+    pthread_mutex_lock(&p->window_lock);
+    count_result(&p->counts, res_str);
+    free(res_str);
+  }
+  pthread_mutex_unlock(&p->window_lock);
+  return NULL;
+}
+
+// Execução com N workers. Retorna 0 se não foi possível criar as threads
+static int run_pipeline(const InputFile *in, FILE *fout, size_t threads,
+                        ResultCache *cache, double seconds,
+                        BatchCounts *counts) {
+  BatchPipeline p;
+  memset(&p, 0, sizeof(p));
+  p.window_capacity = threads * BATCH_WINDOW_PER_THREAD;
+  p.jobs = malloc(p.window_capacity * sizeof(BatchJob));
+  p.results = calloc(p.window_capacity, sizeof(char *));
+  p.ready = calloc(p.window_capacity, sizeof(int));
+  p.fout = fout;
+  p.cache = cache;
+  p.seconds = seconds;
+  if (p.jobs == NULL || p.results == NULL || p.ready == NULL) {
+    free(p.jobs);
+    free(p.results);
+    free(p.ready);
+    return 0;
+  }
+
+  Scheduler *s = scheduler_create(threads);
+  if (s == NULL) {
+    free(p.jobs);
+    free(p.results);
+    free(p.ready);
+    return 0;
+  }
+
+  pthread_mutex_init(&p.window_lock, NULL);
+  pthread_cond_init(&p.window_ready, NULL);
+  pthread_cond_init(&p.window_free, NULL);
+
+  pthread_t writer;
+  int writer_ok = pthread_create(&writer, NULL, pipeline_writer, &p) == 0;
+
+  // Leitor: separa as linhas e as entrega ao escalonador em ordem
+  size_t seq = 0;
+  size_t pos = 0;
+  const char *line;
+  size_t len;
+  while (writer_ok && next_line(in, &pos, &line, &len)) {
+    // Janela cheia: espera o escritor liberar espaço
+    pthread_mutex_lock(&p.window_lock);
+    while (seq >= p.next_write + p.window_capacity) {
+      pthread_cond_wait(&p.window_free, &p.window_lock);
+    }
+    pthread_mutex_unlock(&p.window_lock);
+
+    BatchJob *job = &p.jobs[seq % p.window_capacity];
+    job->p = &p;
+    job->seq = seq++;
+    job->line = line;
+    job->len = len;
+    scheduler_spawn(s, NULL, pipeline_task, job);
+  }
+
+  pthread_mutex_lock(&p.window_lock);
+  p.total = seq;
+  p.input_done = 1;
+  pthread_cond_signal(&p.window_ready);
+  pthread_mutex_unlock(&p.window_lock);
+
+  if (writer_ok) {
+    pthread_join(writer, NULL);
+  }
+
+  fprintf(stderr, "Utilizacao dos workers:\n");
+  scheduler_print_stats(s, stderr);
+  scheduler_destroy(s);
+
+  *counts = p.counts;
+
+  pthread_mutex_destroy(&p.window_lock);
+  pthread_cond_destroy(&p.window_ready);
+  pthread_cond_destroy(&p.window_free);
+  free(p.jobs);
+  free(p.results);
+  free(p.ready);
+  return writer_ok;
+}
+
+// Processa um arquivo com uma operação por linha no formato "op a [b ...]"
+int batch_run(const char *input_filename, const char *output_filename,
+              size_t threads, ResultCache *cache, double seconds) {
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 1;
+  }
+
+  FILE *fout = fopen(output_filename, "w");
+  if (fout == NULL) {
+    perror("Erro ao abrir arquivo de saída");
+    inputfile_close(&in);
+    return 1;
+  }
+  setvbuf(fout, NULL, _IOFBF, BATCH_OUTPUT_BUFFER);
+
+  BatchCounts counts = {0, 0, 0};
+  if (threads <= 1 ||
+      !run_pipeline(&in, fout, threads, cache, seconds, &counts)) {
+    run_sequential(&in, fout, cache, seconds, &counts);
+  }
+
+  inputfile_close(&in);
+  if (fclose(fout) != 0) {
+    perror("Erro ao gravar arquivo de saída");
+    return 1;
+  }
+
+  fprintf(stderr, "%zu operacoes processadas, %zu com erro", counts.total,
+          counts.erros);
+  if (seconds > 0) {
+    fprintf(stderr, ", %zu com tempo esgotado", counts.esgotadas);
+  }
+  fprintf(stderr, "\n");
+  if (cache != NULL) {
+    cache_print_stats(cache, stderr);
+  }
+  return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Batch GCD de um arquivo: um número por token, resultado mdc(x_i, produto
+// dos demais) por linha, na ordem da entrada
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  const char **tokens;
+  size_t *lens;
+  BigInt **xs;
+  char **results;
+  size_t count;
+  const char *output_filename;
+  int status;
+} BatchGcdJob;
+
+static void parse_range(void *ctx, size_t begin, size_t end) {
+  BatchGcdJob *job = ctx;
+  for (size_t i = begin; i < end; i++) {
+    job->xs[i] = bigint_create_from_chars(job->tokens[i], job->lens[i]);
+  }
+}
+
+static void to_string_range(void *ctx, size_t begin, size_t end) {
+  BatchGcdJob *job = ctx;
+  for (size_t i = begin; i < end; i++) {
+    job->results[i] = bigint_to_string(job->xs[i]);
+  }
+}
+
+// Conversão, árvores e escrita; roda dentro de um worker quando há threads
+static void batch_gcd_task(void *arg) {
+  BatchGcdJob *job = arg;
+
+  scheduler_parallel_for(job->count, 64, parse_range, job);
+  for (size_t i = 0; i < job->count; i++) {
+    if (job->xs[i] == NULL || bigint_is_zero(job->xs[i])) {
+      fprintf(stderr, "Erro: numero invalido na posicao %zu\n", i + 1);
+      return;
+    }
+  }
+
+  BigInt **gcds = bigint_batch_gcd((const BigInt **)job->xs, job->count);
+  if (gcds == NULL) {
+    fprintf(stderr, "Erro: memoria insuficiente\n");
+    return;
+  }
+
+  // Reaproveita xs para os resultados e converte em paralelo
+  for (size_t i = 0; i < job->count; i++) {
+    bigint_destroy(job->xs[i]);
+    job->xs[i] = gcds[i];
+  }
+  free(gcds);
+  scheduler_parallel_for(job->count, 64, to_string_range, job);
+
+  FILE *fout = fopen(job->output_filename, "w");
+  if (fout == NULL) {
+    perror("Erro ao abrir arquivo de saída");
+    return;
+  }
+  setvbuf(fout, NULL, _IOFBF, BATCH_OUTPUT_BUFFER);
+
+  size_t comuns = 0;
+  for (size_t i = 0; i < job->count; i++) {
+    write_result(fout, job->results[i]);
+    if (job->results[i] != NULL && strcmp(job->results[i], "1") != 0) {
+      comuns++;
+    }
+  }
+  if (fclose(fout) != 0) {
+    perror("Erro ao gravar arquivo de saída");
+    return;
+  }
+
+  fprintf(stderr, "%zu numeros processados, %zu com fator comum\n",
+          job->count, comuns);
+  job->status = 0;
+}
+
+int batch_gcd_run(const char *input_filename, const char *output_filename,
+                  size_t threads) {
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 1;
+  }
+
+  // Primeira passada: conta os tokens; a segunda guarda os spans
+  size_t count = 0;
+  size_t pos = 0;
+  const char *token;
+  size_t len;
+  while (inputfile_next_token(in.data, in.size, &pos, &token, &len)) {
+    count++;
+  }
+
+  BatchGcdJob job = {NULL, NULL, NULL, NULL, count, output_filename, 1};
+  job.tokens = malloc((count > 0 ? count : 1) * sizeof(const char *));
+  job.lens = malloc((count > 0 ? count : 1) * sizeof(size_t));
+  job.xs = calloc(count > 0 ? count : 1, sizeof(BigInt *));
+  job.results = calloc(count > 0 ? count : 1, sizeof(char *));
+  if (job.tokens == NULL || job.lens == NULL || job.xs == NULL ||
+      job.results == NULL) {
+    fprintf(stderr, "Erro: memoria insuficiente\n");
+  } else if (count == 0) {
+    fprintf(stderr, "Erro: arquivo sem numeros\n");
+  } else {
+    pos = 0;
+    for (size_t i = 0; i < count; i++) {
+      inputfile_next_token(in.data, in.size, &pos, &job.tokens[i],
+                           &job.lens[i]);
+    }
+
+    Scheduler *s = threads > 1 ? scheduler_create(threads) : NULL;
+    if (s != NULL) {
+      scheduler_run(s, batch_gcd_task, &job);
+      fprintf(stderr, "Utilizacao dos workers:\n");
+      scheduler_print_stats(s, stderr);
+      scheduler_destroy(s);
+    } else {
+      batch_gcd_task(&job);
+    }
+  }
+
+  for (size_t i = 0; job.xs != NULL && i < count; i++) {
+    bigint_destroy(job.xs[i]);
+  }
+  for (size_t i = 0; job.results != NULL && i < count; i++) {
+    free(job.results[i]);
+  }
+  free(job.tokens);
+  free(job.lens);
+  free(job.xs);
+  free(job.results);
+  inputfile_close(&in);
+  return job.status;
+}
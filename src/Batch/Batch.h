@@ -0,0 +1,87 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "../BigInt/BigInt.h"
+#include "../ResultCache/ResultCache.h"
+#include <stddef.h>
+
+// Operações aceitas no modo batch (mesma numeração do menu interativo; 9 a
+// 11 só existem no batch, e as opções 20 e 21 do menu não são operações
+// do batch)
+typedef enum {
+  BATCH_OP_INVALIDA = 0,
+  BATCH_OP_SOMA = 1,
+  BATCH_OP_SUBTRACAO = 2,
+  BATCH_OP_MULTIPLICACAO = 3,
+  BATCH_OP_DIVISAO = 4,
+  BATCH_OP_MODULO = 5,
+  BATCH_OP_MDC = 6,
+  BATCH_OP_FATORIAL = 7,
+  BATCH_OP_BINOMIAL = 8,
+  BATCH_OP_PRODUTO = 9,
+  BATCH_OP_SOMATORIO = 10,
+  BATCH_OP_PRODUTO_ESCALAR = 11,
+  BATCH_OP_RAIZ_QUADRADA = 12,
+  BATCH_OP_RAIZ = 13,
+  BATCH_OP_POTENCIA_PERFEITA = 14,
+  BATCH_OP_POTENCIA = 15,
+  BATCH_OP_FIBONACCI = 16,
+  BATCH_OP_LUCAS = 17,
+  BATCH_OP_PRIMO = 18,
+  BATCH_OP_PROXIMO_PRIMO = 19
+} BatchOp;
+
+// Quantidade de operandos de operações que aceitam qualquer quantidade
+#define BATCH_OPERANDOS_VARIAVEL 0
+
+// Converte o token de operação de uma linha em BatchOp
+// Aceita o número do menu ("1".."19"), o símbolo ("+", "-", "*", "/", "%",
+// "!", "^") ou o nome ("soma", "sub", "mul", "div", "mod", "mdc"/"gcd", "fat",
+// "binom", "prod", "sum", "dot", "sqrt", "root", "ispow", "pow", "fib",
+// "lucas", "isprime", "nextprime")
+// "root x k" é a raiz k-ésima e "ispow x" resulta 1 se x for potência
+// perfeita e 0 caso contrário; "pow a e" é a^e e "fib n"/"lucas n" são os
+// n-ésimos números de Fibonacci e de Lucas; "isprime x" resulta 1 se x for
+// primo provável e "nextprime x" é o menor primo provável maior que x
+BatchOp batch_parse_op(const char *token, size_t len);
+
+// Retorna quantos operandos a operação recebe (1, 2 ou
+// BATCH_OPERANDOS_VARIAVEL, para produto, somatório e produto escalar de
+// uma lista; o produto escalar "dot a1 b1 a2 b2 ..." precisa de pares)
+int batch_op_operands(BatchOp op);
+
+// Executa uma operação sobre n operandos e retorna o resultado
+// Retorna NULL em erro, inclusive se n não combinar com a operação
+BigInt *batch_apply_n(BatchOp op, const BigInt **xs, size_t n);
+
+// Como batch_apply_n, mas consulta antes o cache de resultados e guarda nele
+// o resultado calculado. Com cache == NULL é o mesmo que batch_apply_n
+BigInt *batch_apply_cached(ResultCache *cache, BatchOp op, const BigInt **xs,
+                           size_t n);
+
+// Executa uma operação e retorna o resultado (NULL em erro)
+// Para operações de um operando, b deve ser NULL
+BigInt *batch_apply(BatchOp op, const BigInt *a, const BigInt *b);
+
+// Processa um arquivo com uma operação por linha no formato "op a [b ...]"
+// Cada resultado é escrito em uma linha do arquivo de saída, na mesma ordem
+// Linhas inválidas geram "ERRO". Linhas vazias ou iniciadas por '#' são
+// ignoradas. Com threads > 1 as operações são executadas por um pool de
+// workers e os resultados continuam saindo na ordem da entrada. Se cache não
+// for NULL, operações repetidas são respondidas pelo cache de resultados
+// Com seconds > 0 cada linha roda em um ExecContext com esse prazo; as que
+// estouram são interrompidas e geram "TEMPO ESGOTADO"
+// Retorna 0 em sucesso, 1 se não foi possível abrir os arquivos
+int batch_run(const char *input_filename, const char *output_filename,
+              size_t threads, ResultCache *cache, double seconds);
+
+// Batch GCD de um arquivo com um número por token (espaços ou linhas)
+// Escreve, na ordem da entrada, mdc(x_i, produto de todos os outros): um
+// resultado diferente de 1 indica fator primo compartilhado. Usa as árvores
+// de produto e de restos (bigint_batch_gcd); com threads > 1 a conversão e
+// cada nível das árvores rodam em um escalonador com N workers
+// Retorna 0 em sucesso e 1 em erro (arquivo, número inválido ou zero)
+int batch_gcd_run(const char *input_filename, const char *output_filename,
+                  size_t threads);
+
+#endif // BATCH_H
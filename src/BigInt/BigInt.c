@@ -1,167 +1,166 @@
 #include "BigInt.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Instrument/Instrument.h"
+#include "../Limbs/Limbs.h"
+#include "../Radix/Radix.h"
 #include <ctype.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Divide uma string decimal por um divisor e retorna o resto
-// Modifica a string in-place com o quociente
-static uint32_t divide_decimal_string_by_uint32(char *str, size_t len,
-                                                uint64_t divisor) {
-  uint64_t remainder = 0;
-
-  for (size_t i = 0; i < len; i++) {
-    remainder = remainder * 10 + (str[i] - '0');
-    str[i] = (char)(remainder / divisor) + '0';
-    remainder %= divisor;
-  }
-
-  return (uint32_t)remainder;
-}
-
-// Cria um BigInt a partir de uma string
-BigInt *bigint_create_from_string(const char *str) {
+// Cria um BigInt a partir de um span de caracteres (não precisa de '\0')
+BigInt *bigint_create_from_chars(const char *str, size_t len) {
   if (str == NULL) {
     return NULL;
   }
 
+  const char *end = str + len;
+
   // Ignora espaços em branco iniciais
-  while (*str == ' ' || *str == '\t') {
+  while (str < end && (*str == ' ' || *str == '\t')) {
     str++;
   }
 
   // Verifica o sinal
   int sign = 1;
-  if (*str == '+') {
-    sign = 1;
-    str++;
-  } else if (*str == '-') {
-    sign = -1;
-    str++;
-  }
-
-  // Ignora zeros à esquerda
-  while (*str == '0' && *(str + 1) != '\0') {
+  if (str < end && (*str == '+' || *str == '-')) {
+    sign = (*str == '-') ? -1 : 1;
     str++;
   }
 
   // Calcula o comprimento dos dígitos
   const char *digits_start = str;
-  while (*str >= '0' && *str <= '9') {
+  while (str < end && *str >= '0' && *str <= '9') {
     str++;
   }
-  size_t len = str - digits_start;
+  size_t ndigits = (size_t)(str - digits_start);
 
-  if (len == 0 && *digits_start == '0') {
-    len = 1;
-    str = digits_start;
+  if (ndigits == 0) {
+    return NULL;
   }
+  INSTR_BEGIN(instr_start);
 
-  if (len == 0) {
-    return NULL;
+  // Ignora zeros à esquerda
+  while (ndigits > 1 && *digits_start == '0') {
+    digits_start++;
+    ndigits--;
   }
 
-  // Aloca memória
-  BigInt *bi = malloc(sizeof(BigInt));
-  if (bi == NULL) {
+  // Converte de decimal para base 2^32 (divisão e conquista se for grande)
+  size_t used = 0;
+  uint32_t *limbs = radix_read_decimal(digits_start, ndigits, &used);
+  if (limbs == NULL) {
     return NULL;
   }
 
-  bi->digits = linkedlist_create();
-  if (bi->digits == NULL) {
-    free(bi);
+  BigInt *bi = bigint_import_limbs(limbs, used, sign);
+  free(limbs);
+  INSTR_END(INSTR_PARSE, used, 0, instr_start);
+  return bi;
+}
+
+// Cria um BigInt a partir de uma string
+BigInt *bigint_create_from_string(const char *str) {
+  if (str == NULL) {
     return NULL;
   }
+  return bigint_create_from_chars(str, strlen(str));
+}
 
-  bi->sign = (len == 1 && digits_start[0] == '0') ? 1 : sign;
+// Cria um BigInt a partir de um inteiro
+BigInt *bigint_create_from_int(int num) {
+  return bigint_create_from_i64(num);
+}
 
-  // Se for zero, apenas adiciona um zero
-  if (len == 1 && digits_start[0] == '0') {
-    linkedlist_append(bi->digits, 0);
-    return bi;
-  }
+// Magnitude de um int64_t (vale também para INT64_MIN)
+static uint64_t abs_i64(int64_t num) {
+  return num < 0 ? 0 - (uint64_t)num : (uint64_t)num;
+}
 
-  // Converte string decimal para base 2^32
-  // Fazemos divisões sucessivas por 2^32 até que o número seja zero
-  char *working_str = malloc(len + 1);
-  if (working_str == NULL) {
-    linkedlist_destroy(bi->digits);
-    free(bi);
+// BigInt com magnitude de 64 bits e o sinal dado (zero fica positivo)
+static BigInt *from_word(uint64_t magnitude, int sign) {
+  BigInt *bi = bigint_create_empty(0);
+  if (bi == NULL) {
     return NULL;
   }
 
-  memcpy(working_str, digits_start, len);
-  working_str[len] = '\0';
+  // Armazena os valores em ordem little-endian (LSB primeiro)
+  size_t count = magnitude > UINT32_MAX ? 2 : 1;
+  linkedlist_append(bi->digits, (uint32_t)magnitude);
+  if (count == 2) {
+    linkedlist_append(bi->digits, (uint32_t)(magnitude >> 32));
+  }
+  if (linkedlist_length(bi->digits) != count) {
+    bigint_destroy(bi);
+    return NULL;
+  }
+  bi->sign = magnitude != 0 && sign < 0 ? -1 : 1;
+  return bi;
+}
 
-  size_t working_len = len;
+// Cria um BigInt a partir de um inteiro de 64 bits com sinal
+BigInt *bigint_create_from_i64(int64_t num) {
+  return from_word(abs_i64(num), num < 0 ? -1 : 1);
+}
 
-  while (working_len > 0 && !(working_len == 1 && working_str[0] == '0')) {
-    uint64_t divisor = ((uint64_t)UINT32_MAX) + 1ULL; // 2^32
-    uint32_t remainder =
-        divide_decimal_string_by_uint32(working_str, working_len, divisor);
-    linkedlist_append(bi->digits, remainder);
+// Cria um BigInt a partir de um inteiro de 64 bits sem sinal
+BigInt *bigint_create_from_u64(uint64_t num) { return from_word(num, 1); }
 
-    // Atualiza o comprimento (remove zeros à esquerda)
-    size_t new_len = 0;
-    while (new_len < working_len && working_str[new_len] == '0') {
-      new_len++;
-    }
-    if (new_len == working_len) {
-      break; // Todas as posições são zero
+// Guarda |bi| em *magnitude se couber em 64 bits (retorna 1) ou retorna 0
+// Limbs zerados no topo são ignorados
+static int magnitude_u64(const BigInt *bi, uint64_t *magnitude) {
+  uint64_t m = 0;
+  size_t i = 0;
+  for (const ListNode *node = bi->digits->head; node != NULL;
+       node = node->next, i++) {
+    if (i >= 2) {
+      if (node->value != 0) {
+        return 0;
+      }
+    } else {
+      m |= (uint64_t)node->value << (32 * i);
     }
-    working_len -= new_len;
-    memmove(working_str, working_str + new_len, working_len);
-    working_str[working_len] = '\0';
+  }
+  *magnitude = m;
+  return 1;
+}
 
-    // Se depois de remover zeros restou apenas um dígito e é zero, paramos
-    if (working_len == 1 && working_str[0] == '0') {
-      break;
+// Converte para int64_t, saturando se não couber
+int64_t bigint_to_i64(const BigInt *bi, int *overflow) {
+  uint64_t m = 0;
+  int fits = bi != NULL && magnitude_u64(bi, &m);
+  int negative = bi != NULL && bi->sign < 0;
+  uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+  if (!fits || m > limit) {
+    if (overflow != NULL) {
+      *overflow = 1;
     }
+    return negative ? INT64_MIN : INT64_MAX;
   }
-
-  free(working_str);
-
-  // Se não adicionamos nenhum dígito, adiciona zero
-  if (linkedlist_length(bi->digits) == 0) {
-    linkedlist_append(bi->digits, 0);
-    bi->sign = 1;
+  if (overflow != NULL) {
+    *overflow = 0;
   }
-
-  return bi;
-}
-
-// Cria um BigInt a partir de um inteiro
-BigInt *bigint_create_from_int(int num) {
-  BigInt *bi = malloc(sizeof(BigInt));
-  if (bi == NULL) {
-    return NULL;
+  if (negative) {
+    // -(m - 1) - 1 evita o estouro de -(int64_t)m quando m = 2^63
+    return m == 0 ? 0 : -(int64_t)(m - 1) - 1;
   }
+  return (int64_t)m;
+}
 
-  bi->digits = linkedlist_create();
-  if (bi->digits == NULL) {
-    free(bi);
-    return NULL;
+// Converte para uint64_t, saturando se não couber
+uint64_t bigint_to_u64(const BigInt *bi, int *overflow) {
+  uint64_t m = 0;
+  int fits = bi != NULL && magnitude_u64(bi, &m);
+  int negative = bi != NULL && bi->sign < 0 && m != 0;
+  if (overflow != NULL) {
+    *overflow = !fits || negative;
   }
-
-  if (num == 0) {
-    bi->sign = 1;
-    linkedlist_append(bi->digits, 0);
-    return bi;
+  if (!fits) {
+    return bi != NULL && bi->sign < 0 ? 0 : UINT64_MAX;
   }
-
-  int sign = num >= 0 ? 1 : -1;
-  uint32_t abs_num = (num < 0) ? (uint32_t)(-(int64_t)num) : (uint32_t)num;
-
-  bi->sign = sign;
-
-  // Armazena os valores em ordem little-endian (LSB primeiro)
-  // Para números pequenos, apenas um uint32_t é necessário
-  linkedlist_append(bi->digits, abs_num);
-
-  return bi;
+  return negative ? 0 : m;
 }
-
 // Cria um BigInt vazio com capacidade inicial
 BigInt *bigint_create_empty(size_t initial_capacity) {
   BigInt *bi = malloc(sizeof(BigInt));
@@ -174,6 +173,7 @@ BigInt *bigint_create_empty(size_t initial_capacity) {
     free(bi);
     return NULL;
   }
+  INSTR_ALLOC(1, sizeof(BigInt));
 
   bi->sign = 1;
 
@@ -197,9 +197,10 @@ void bigint_destroy(BigInt *bi) {
     linkedlist_destroy(bi->digits);
   }
   free(bi);
+  INSTR_FREE(1, sizeof(BigInt));
 }
 
-// Cria uma cópia de um BigInt
+// Cria uma cópia de um BigInt (O(1), os limbs são compartilhados)
 BigInt *bigint_copy(const BigInt *bi) {
   if (bi == NULL) {
     return NULL;
@@ -216,10 +217,49 @@ BigInt *bigint_copy(const BigInt *bi) {
     free(copy);
     return NULL;
   }
+  INSTR_ALLOC(1, sizeof(BigInt));
 
   return copy;
 }
 
+// Retorna -x (zero continua positivo)
+BigInt *bigint_negate(const BigInt *x) {
+  BigInt *r = bigint_copy(x);
+  if (r != NULL && !bigint_is_zero(r)) {
+    r->sign = -r->sign;
+  }
+  return r;
+}
+
+// Retorna |x|
+BigInt *bigint_abs(const BigInt *x) {
+  BigInt *r = bigint_copy(x);
+  if (r != NULL) {
+    r->sign = 1;
+  }
+  return r;
+}
+
+// Compara |a| e |b| com os comprimentos já conhecidos (listas normalizadas)
+// Percorre os nós uma vez, do LSB para o MSB: a última diferença encontrada
+// é a mais significativa. Retorna: 1 se |a| > |b|, 0 se iguais, -1 se menor
+static int compare_abs_nodes(const BigInt *a, size_t a_len, const BigInt *b,
+                             size_t b_len) {
+  if (a_len != b_len) {
+    return a_len > b_len ? 1 : -1;
+  }
+
+  int cmp = 0;
+  const ListNode *x = a->digits->head;
+  const ListNode *y = b->digits->head;
+  for (; x != NULL && y != NULL; x = x->next, y = y->next) {
+    if (x->value != y->value) {
+      cmp = x->value > y->value ? 1 : -1;
+    }
+  }
+  return cmp;
+}
+
 // Compara dois BigInts
 // Retorna: 1 se a > b, 0 se a == b, -1 se a < b
 int bigint_compare(const BigInt *a, const BigInt *b) {
@@ -235,31 +275,89 @@ int bigint_compare(const BigInt *a, const BigInt *b) {
     return -1;
   }
 
-  // Sinais são iguais, compara os comprimentos
-  size_t a_len = linkedlist_length(a->digits);
-  size_t b_len = linkedlist_length(b->digits);
+  // Sinais iguais: compara as magnitudes
+  return a->sign * compare_abs_nodes(a, linkedlist_length(a->digits), b,
+                                     linkedlist_length(b->digits));
+}
+
+// Mistura de 64 bits (finalizador do MurmurHash3)
+static uint64_t hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
+}
 
-  if (a_len > b_len) {
-    return a->sign;
+// Hash de 64 bits dos limbs e do sinal
+// Limbs zerados no topo são ignorados (e zero tem sempre sinal positivo),
+// então valores iguais têm o mesmo hash mesmo sem normalização
+uint64_t bigint_hash(const BigInt *bi) {
+  if (bi == NULL) {
+    return 0;
   }
-  if (a_len < b_len) {
-    return -a->sign;
+
+  uint64_t h = UINT64_C(0x9e3779b97f4a7c15);
+  size_t zeros = 0; // Limbs zerados ainda não incluídos no hash
+  int nonzero = 0;
+  for (const ListNode *node = bi->digits->head; node != NULL;
+       node = node->next) {
+    if (node->value == 0) {
+      zeros++;
+      continue;
+    }
+    for (; zeros > 0; zeros--) {
+      h = hash_mix(h) + 1;
+    }
+    h = hash_mix(h ^ node->value) + 1;
+    nonzero = 1;
   }
+  return hash_mix(h ^ (nonzero && bi->sign < 0 ? 1 : 0));
+}
 
-  // Mesmo comprimento, compara valores do MSB para o LSB
-  for (int i = (int)a_len - 1; i >= 0; i--) {
-    uint32_t a_val = linkedlist_get(a->digits, i);
-    uint32_t b_val = linkedlist_get(b->digits, i);
+// Retorna 1 se os dois BigInts têm o mesmo valor (percorre as listas juntas)
+int bigint_equal(const BigInt *a, const BigInt *b) {
+  if (a == NULL || b == NULL) {
+    return a == b;
+  }
 
-    if (a_val > b_val) {
-      return a->sign;
-    }
-    if (a_val < b_val) {
-      return -a->sign;
+  const ListNode *x = a->digits->head;
+  const ListNode *y = b->digits->head;
+  int nonzero = 0;
+  while (x != NULL || y != NULL) {
+    uint32_t xv = x != NULL ? x->value : 0;
+    uint32_t yv = y != NULL ? y->value : 0;
+    if (xv != yv) {
+      return 0;
     }
+    nonzero |= xv != 0;
+    x = x != NULL ? x->next : NULL;
+    y = y != NULL ? y->next : NULL;
   }
+  return !nonzero || a->sign == b->sign;
+}
 
-  return 0;
+// Confere se todos os nós do resultado foram alocados e normaliza o zero
+static BigInt *finish_word_result(BigInt *res, size_t count) {
+  if (linkedlist_length(res->digits) != count) {
+    // Falha de alocação no meio da construção
+    bigint_destroy(res);
+    return NULL;
+  }
+  linkedlist_remove_leading_zeros(res->digits);
+  if (linkedlist_length(res->digits) == 0) {
+    linkedlist_append(res->digits, 0);
+    if (linkedlist_length(res->digits) == 0) {
+      bigint_destroy(res);
+      return NULL;
+    }
+  }
+  // A remoção mantém um nó: o zero (ex.: -5 - (-5)) é sempre positivo
+  if (linkedlist_length(res->digits) == 1 && res->digits->head->value == 0) {
+    res->sign = 1;
+  }
+  return res;
 }
 
 // Soma dois BigInts e retorna o resultado
@@ -285,10 +383,7 @@ BigInt *bigint_sum(const BigInt *a, const BigInt *b) {
     }
   }
 
-  // Obtém os comprimentos
-  size_t a_len = linkedlist_length(a->digits);
-  size_t b_len = linkedlist_length(b->digits);
-  size_t max_len = (a_len > b_len) ? a_len : b_len;
+  INSTR_BEGIN(instr_start);
 
   BigInt *result = bigint_create_empty(0);
   if (result == NULL) {
@@ -297,210 +392,137 @@ BigInt *bigint_sum(const BigInt *a, const BigInt *b) {
 
   result->sign = a->sign;
 
-  // Soma os valores em base 2^32
+  // Soma os valores em base 2^32, percorrendo as duas listas juntas
   uint64_t carry = 0;
-  size_t i = 0;
-
-  while (i < max_len || carry > 0) {
+  size_t count = 0;
+  const ListNode *x = a->digits->head;
+  const ListNode *y = b->digits->head;
+  while (x != NULL || y != NULL || carry > 0) {
     uint64_t sum = carry;
-
-    if (i < a_len) {
-      sum += (uint64_t)linkedlist_get(a->digits, i);
+    if (x != NULL) {
+      sum += x->value;
+      x = x->next;
     }
-    if (i < b_len) {
-      sum += (uint64_t)linkedlist_get(b->digits, i);
+    if (y != NULL) {
+      sum += y->value;
+      y = y->next;
     }
 
     linkedlist_append(result->digits, (uint32_t)(sum & UINT32_MAX));
     carry = sum >> 32;
-    i++;
+    count++;
   }
 
   // Remove zeros à esquerda
-  linkedlist_remove_leading_zeros(result->digits);
+  result = finish_word_result(result, count);
 
+  INSTR_END(INSTR_SUM, linkedlist_length(a->digits),
+            linkedlist_length(b->digits), instr_start);
   return result;
 }
 
-//Compara |a| e |b| (apenas magnitude).
-//Retorna: 1 se |a| > |b|, 0 se iguais, -1 se |a| < |b|
-static int bigint_compare_abs(const BigInt *a, const BigInt *b) {
-  size_t a_len = linkedlist_length(a->digits);
-  size_t b_len = linkedlist_length(b->digits);
-
-  if (a_len > b_len)
-    return 1;
-  if (a_len < b_len)
-    return -1;
-
-  // mesma quantidade de blocos: comparar do MSB -> LSB
-  for (long i = (long)a_len - 1; i >= 0; --i) {
-    uint32_t av = linkedlist_get(a->digits, (size_t)i);
-    uint32_t bv = linkedlist_get(b->digits, (size_t)i);
-    if (av > bv)
-      return 1;
-    if (av < bv)
-      return -1;
-  }
-  return 0;
-}
-
 BigInt *bigint_multiplicacao(const BigInt *a, const BigInt *b) {
   if (a == NULL || b == NULL) {
     return NULL;
   }
 
-  size_t a_len = linkedlist_length(a->digits);
-  size_t b_len = linkedlist_length(b->digits);
-
   // Se qualquer operando for zero o codigo retornará 0 com sinal positivo
-  if (a_len == 0 || (a_len == 1 && linkedlist_get(a->digits, 0) == 0) ||
-      b_len == 0 || (b_len == 1 && linkedlist_get(b->digits, 0) == 0)) {
-    BigInt *zero = bigint_create_from_int(0);
-    return zero;
+  if (bigint_is_zero(a) || bigint_is_zero(b) ||
+      linkedlist_length(a->digits) == 0 || linkedlist_length(b->digits) == 0) {
+    return bigint_create_from_int(0);
   }
 
-  // Cria BigInt resultado com zeros suficientes
-  BigInt *resultado = bigint_create_empty(0);
-
-  if (resultado == NULL) {
+  // Exporta os operandos para arrays contíguos e multiplica com os kernels
+  INSTR_BEGIN(instr_start);
+  size_t a_len, b_len;
+  uint32_t *a_limbs = bigint_export_limbs(a, &a_len);
+  uint32_t *b_limbs = bigint_export_limbs(b, &b_len);
+  uint32_t *produto = malloc((a_len + b_len) * sizeof(uint32_t));
+  if (a_limbs == NULL || b_limbs == NULL || produto == NULL) {
+    free(a_limbs);
+    free(b_limbs);
+    free(produto);
     return NULL;
   }
 
-  for (size_t h = 0; h < a_len + b_len; h++) {
-    linkedlist_append(resultado->digits, 0);
-  }
+  limbs_mul(produto, a_limbs, a_len, b_limbs, b_len);
 
   // Correção do sinal conforme a regra da multiplicacao
-  if (a->sign == b->sign) {
-    resultado->sign = +1;
-  } else {
-    resultado->sign = -1;
-  }
-
-  // Loop pra fazer a multiplicacao
-  for (size_t i = 0; i < a_len; i++) {
-
-    uint64_t ai = (uint64_t)linkedlist_get(a->digits, i);
-    uint64_t carry = 0;
-
-    for (size_t j = 0; j < b_len || carry > 0; j++) {
-      uint64_t bj;
-      if (j < b_len) {
-        bj = (uint64_t)linkedlist_get(b->digits, j);
-      } else {
-        bj = 0;
-      }
-
-      uint64_t existing = linkedlist_get(resultado->digits, i + j);
-      uint64_t sum = ai * bj + existing + carry;
-      linkedlist_set(resultado->digits, i + j, (uint32_t)(sum & UINT32_MAX));
-
-      carry = sum >> 32;
-    }
-  }
-
-  linkedlist_remove_leading_zeros(resultado->digits);
-
-  // Se o resultado é zero entao o resultado deve ser positivo
-  if (linkedlist_length(resultado->digits) == 1 &&
-      linkedlist_get(resultado->digits, 0) == 0) {
-    resultado->sign = +1;
-  }
+  BigInt *resultado =
+      bigint_import_limbs(produto, a_len + b_len, a->sign == b->sign ? 1 : -1);
 
+  free(a_limbs);
+  free(b_limbs);
+  free(produto);
+  INSTR_END(INSTR_MULTIPLY, a_len, b_len, instr_start);
   return resultado;
 }
 
-BigInt *bigint_divisao(const BigInt *a, const BigInt *b) {
-  if (a == NULL || b == NULL){
-    return NULL;
+// Divide |a| por |b| com os kernels de limbs
+// *q recebe o quociente e *r o resto (*bn limbs, com *b_limbs = |b|)
+// Retorna 0 se b for zero ou se faltar memória. Quem chamar libera os arrays
+static int divide_abs(const BigInt *a, const BigInt *b, uint32_t **q,
+                      size_t *qn, uint32_t **r, uint32_t **b_limbs,
+                      size_t *bn) {
+  size_t an;
+  uint32_t *a_limbs = bigint_export_limbs(a, &an);
+  *b_limbs = bigint_export_limbs(b, bn);
+  if (a_limbs == NULL || *b_limbs == NULL) {
+    free(a_limbs);
+    free(*b_limbs);
+    return 0;
   }
 
-  // Verifica se é divisão por zero
-  size_t b_len = linkedlist_length(b->digits);
-  if (b_len == 1 && linkedlist_get(b->digits, 0) == 0) {
-    // é divisão por zero
-    return NULL;
+  an = limbs_normalized_length(a_limbs, an);
+  *bn = limbs_normalized_length(*b_limbs, *bn);
+  if (*bn == 0) {
+    // Divisão por zero
+    free(a_limbs);
+    free(*b_limbs);
+    return 0;
   }
 
-  // Se a (dividendo) é 0 então o resultado é 0
-  size_t a_len = linkedlist_length(a->digits);
-  if (a_len == 1 && linkedlist_get(a->digits, 0) == 0) {
-    return bigint_create_from_int(0);
+  *qn = an >= *bn ? an - *bn + 1 : 1;
+  *q = calloc(*qn, sizeof(uint32_t));
+  *r = calloc(*bn, sizeof(uint32_t));
+  int ok = *q != NULL && *r != NULL;
+  if (ok && an < *bn) {
+    // |a| < |b|: quociente zero e resto |a|
+    memcpy(*r, a_limbs, an * sizeof(uint32_t));
+  } else if (ok) {
+    ok = limbs_divmod(*q, *r, a_limbs, an, *b_limbs, *bn);
   }
 
-  // Calcula o sinal do quociente
-  int result_sign;
-  if (a->sign == b->sign) {
-    result_sign = +1;
-  } else {
-    result_sign = -1;
+  free(a_limbs);
+  if (!ok) {
+    free(*q);
+    free(*r);
+    free(*b_limbs);
   }
+  return ok;
+}
 
-  // Faz o calculo somente com valores positivos
-  BigInt *dividendo = bigint_copy(a);
-  BigInt *divisor = bigint_copy(b);
-  dividendo->sign = 1;
-  divisor->sign = 1;
-
-  // Prepara o BigInt do quociente inicializando-o com zero
-  BigInt *quociente = bigint_create_from_int(0);
-  if (quociente == NULL){
+// Divisão inteira truncada para zero (como em C)
+BigInt *bigint_divisao(const BigInt *a, const BigInt *b) {
+  if (a == NULL || b == NULL){
     return NULL;
   }
 
-  while (bigint_compare(dividendo, divisor) >= 0) {
-
-    // acha maior potência de 2 * divisor <= dividendo
-    BigInt *temp = bigint_copy(divisor);
-    BigInt *mult = bigint_create_from_int(1);
-
-    while (1) {
-      // temp <<= 1
-      BigInt *temp2 = bigint_sum(temp, temp);
-
-      if (bigint_compare(temp2, dividendo) > 0) {
-        bigint_destroy(temp2);
-        break;
-      }
-
-      bigint_destroy(temp);
-      temp = temp2;
-
-      BigInt *mult2 = bigint_sum(mult, mult);
-      bigint_destroy(mult);
-      mult = mult2;
-    }
-
-    // Subtrai do dividendo
-    BigInt *novo_dividendo = bigint_subtract(dividendo, temp);
-    bigint_destroy(dividendo);
-    dividendo = novo_dividendo;
-
-    // adiciona ao quociente
-    BigInt *novo_quociente = bigint_sum(quociente, mult);
-    bigint_destroy(quociente);
-    quociente = novo_quociente;
-
-    bigint_destroy(temp);
-    bigint_destroy(mult);
-  }
-
-  // Aplica sinal final
-  quociente->sign = result_sign;
-
-  // remove zeros a esquerda
-  linkedlist_remove_leading_zeros(quociente->digits);
-
-  // Se zero, então o sinal é positivo
-  if (linkedlist_length(quociente->digits) == 1 &&
-      linkedlist_get(quociente->digits, 0) == 0) {
-    quociente->sign = +1;
+  INSTR_BEGIN(instr_start);
+  uint32_t *q, *r, *b_limbs;
+  size_t qn, bn;
+  if (!divide_abs(a, b, &q, &qn, &r, &b_limbs, &bn)) {
+    return NULL;
   }
 
-  bigint_destroy(dividendo);
-  bigint_destroy(divisor);
+  // O sinal do quociente é positivo se os sinais forem iguais
+  // (bigint_import_limbs normaliza o zero para positivo)
+  BigInt *quociente = bigint_import_limbs(q, qn, a->sign == b->sign ? 1 : -1);
 
+  free(q);
+  free(r);
+  free(b_limbs);
+  INSTR_END(INSTR_DIVIDE, linkedlist_length(a->digits), bn, instr_start);
   return quociente;
 }
 
@@ -518,16 +540,10 @@ BigInt *bigint_subtract(const BigInt *a, const BigInt *b) {
   }
 
   // sinais iguais: resultado tem sinal do maior em | |; subtraímos magnitudes
-  int cmp = bigint_compare_abs(a, b);
-  if (cmp == 0) {
-    // zero
-    BigInt *r = bigint_create_empty(0);
-    if (!r)
-      return NULL;
-    linkedlist_append(r->digits, 0);
-    r->sign = 1;
-    return r;
-  }
+  INSTR_BEGIN(instr_start);
+  size_t a_len = linkedlist_length(a->digits);
+  size_t b_len = linkedlist_length(b->digits);
+  int cmp = compare_abs_nodes(a, a_len, b, b_len);
 
   const BigInt *maj = (cmp >= 0) ? a : b; // maior magnitude
   const BigInt *min = (cmp >= 0) ? b : a; // menor magnitude
@@ -539,225 +555,361 @@ BigInt *bigint_subtract(const BigInt *a, const BigInt *b) {
   // se |a| >= |b| sinal = a->sign; caso contrário sinal = -a->sign
   res->sign = (cmp >= 0) ? a->sign : -a->sign;
 
+  // Percorre as duas listas juntas (|maj| >= |min|, então min acaba antes)
   uint64_t borrow = 0;
-  size_t max_len = linkedlist_length(maj->digits);
-  size_t min_len = linkedlist_length(min->digits);
-
-  for (size_t i = 0; i < max_len; ++i) {
-    uint64_t av = linkedlist_get(maj->digits, i);
-    uint64_t bv = (i < min_len) ? linkedlist_get(min->digits, i) : 0ULL;
-
-    uint64_t subtrahend = bv + borrow;
-    uint64_t out;
-    if (av >= subtrahend) {
-      out = av - subtrahend;
-      borrow = 0;
-    } else {
-      // empresta 1 bloco de 2^32
-      out = ((1ULL << 32) + av) - subtrahend;
-      borrow = 1;
+  size_t count = 0;
+  const ListNode *y = min->digits->head;
+  for (const ListNode *x = maj->digits->head; x != NULL; x = x->next) {
+    uint64_t subtrahend = (y != NULL ? y->value : 0ULL) + borrow;
+    // empresta 1 bloco de 2^32 quando x < subtraendo
+    borrow = x->value < subtrahend;
+    linkedlist_append(res->digits, (uint32_t)(x->value - subtrahend));
+    count++;
+    if (y != NULL) {
+      y = y->next;
     }
-    linkedlist_append(res->digits, (uint32_t)(out & 0xFFFFFFFFu));
   }
 
-  // remove zeros à esquerda (no fim da lista, pois está em LSB-first)
-  linkedlist_remove_leading_zeros(res->digits);
-
-  // se virou zero absoluto, normaliza
-  if (linkedlist_length(res->digits) == 0) {
-    linkedlist_append(res->digits, 0);
-    res->sign = 1;
-  }
+  // remove zeros à esquerda e normaliza o zero (|a| == |b|)
+  res = finish_word_result(res, count);
 
+  INSTR_END(INSTR_SUBTRACT, a_len, b_len, instr_start);
   return res;
 }
 
+// Resto da divisão, sempre no intervalo 0 <= r < |n|
 BigInt *bigint_mod(const BigInt *a, const BigInt *n) {
   if (a == NULL || n == NULL) {
     return NULL;
   }
 
-  // Verifica se tem divisor zero
-  size_t n_len = linkedlist_length(n->digits);
-  if (n_len == 1 && linkedlist_get(n->digits, 0) == 0) {
-    // Erro: mod por zero
+  INSTR_BEGIN(instr_start);
+  uint32_t *q, *r, *n_limbs;
+  size_t qn, nn;
+  if (!divide_abs(a, n, &q, &qn, &r, &n_limbs, &nn)) {
     return NULL;
   }
 
-  // Se a (dividendo) é 0, o resultado é 0
-  if (bigint_is_zero(a)) {
-    return bigint_create_from_int(0);
-  }
-
-  // Prepara as cópias para a divisão
-  // Copia os valores absolutos para calcular a divisão da magnitude |a|/|n|
-  BigInt *dividendo_abs = bigint_copy(a);
-  BigInt *divisor_abs = bigint_copy(n);
-
-  if (dividendo_abs == NULL || divisor_abs == NULL) {
-      bigint_destroy(dividendo_abs);
-      bigint_destroy(divisor_abs);
-      return NULL;
+  // Para a < 0 o resto de |a| / |n| é negativo: r = |n| - r
+  if (a->sign == -1 && limbs_normalized_length(r, nn) > 0) {
+    limbs_sub(r, n_limbs, nn, r, nn);
   }
 
-  dividendo_abs->sign = 1; // |a|
-  divisor_abs->sign = 1;   // |n|
+  BigInt *resto = bigint_import_limbs(r, nn, 1);
 
-  // Calcula q_abs = |a| / |n| (divisão inteira, que trunca para zero)
-  BigInt *q_abs = bigint_divisao(dividendo_abs, divisor_abs);
+  free(q);
+  free(r);
+  free(n_limbs);
+  INSTR_END(INSTR_MOD, linkedlist_length(a->digits), nn, instr_start);
+  return resto;
+}
 
-  bigint_destroy(dividendo_abs);
-  bigint_destroy(divisor_abs);
+// Kernels de palavra: percorrem os nós de |a| uma única vez (O(n), sem
+// linkedlist_get por índice) e só alocam os nós do resultado
 
-  if (q_abs == NULL) {
+// |a| + v com o sinal dado
+static BigInt *add_word(const BigInt *a, uint64_t v, int sign) {
+  BigInt *res = bigint_create_empty(0);
+  if (res == NULL) {
     return NULL;
   }
+  res->sign = sign;
 
-  // Aplica o sinal para obter o quociente de truncamento q = a/n
-  BigInt *q = q_abs;
-  if (a->sign != n->sign && bigint_is_zero(q) == 0) {
-    q->sign = -1; // Se os sinais de 'a' e 'n' forem diferentes, o quociente é negativo
-  } else {
-    q->sign = 1; // Senão, é positivo ou zero
+  uint64_t carry = v;
+  size_t count = 0;
+  for (const ListNode *node = a->digits->head; node != NULL;
+       node = node->next, count++) {
+    uint64_t sum = (uint64_t)node->value + (carry & UINT32_MAX);
+    carry = (carry >> 32) + (sum >> 32);
+    linkedlist_append(res->digits, (uint32_t)sum);
   }
+  for (; carry > 0; carry >>= 32, count++) {
+    linkedlist_append(res->digits, (uint32_t)carry);
+  }
+  return finish_word_result(res, count);
+}
 
-  // Calcula q*n
-  BigInt *multiplica_qn = bigint_multiplicacao(q, n);
-
-  if (multiplica_qn == NULL) {
-    bigint_destroy(q);
+// |a| - v com o sinal dado. Requer |a| >= v
+static BigInt *sub_word(const BigInt *a, uint64_t v, int sign) {
+  BigInt *res = bigint_create_empty(0);
+  if (res == NULL) {
     return NULL;
   }
+  res->sign = sign;
 
-  // Calcula o resto r = a - q*n
-  BigInt *resto = bigint_subtract(a, multiplica_qn);
-
-  bigint_destroy(q);
-  bigint_destroy(multiplica_qn);
+  uint64_t borrow = v;
+  size_t count = 0;
+  for (const ListNode *node = a->digits->head; node != NULL;
+       node = node->next, count++) {
+    uint64_t sub = borrow & UINT32_MAX;
+    borrow >>= 32;
+    if (node->value < sub) {
+      // empresta 1 bloco de 2^32
+      borrow++;
+    }
+    linkedlist_append(res->digits, (uint32_t)(node->value - sub));
+  }
+  return finish_word_result(res, count);
+}
 
-  if (resto == NULL) {
+// |a| * v com o sinal dado
+static BigInt *mul_word(const BigInt *a, uint64_t v, int sign) {
+  BigInt *res = bigint_create_empty(0);
+  if (res == NULL) {
     return NULL;
   }
+  res->sign = sign;
 
-  // Ajusta o resto para ser 0 <= r < |n|
+  // v = hi * 2^32 + lo. O carry nunca passa de 2^64 - 1: ele é o quociente
+  // de (limb * v + carry) por 2^32, que é menor que 2^96
+  uint64_t lo = v & UINT32_MAX;
+  uint64_t hi = v >> 32;
+  uint64_t carry = 0;
+  size_t count = 0;
+  for (const ListNode *node = a->digits->head; node != NULL;
+       node = node->next, count++) {
+    uint64_t low = (uint64_t)node->value * lo + (carry & UINT32_MAX);
+    carry = (carry >> 32) + (low >> 32) + (uint64_t)node->value * hi;
+    linkedlist_append(res->digits, (uint32_t)low);
+  }
+  for (; carry > 0; carry >>= 32, count++) {
+    linkedlist_append(res->digits, (uint32_t)carry);
+  }
+  return finish_word_result(res, count);
+}
 
-  // Cria |n| (magnitude do divisor)
-  BigInt *n_abs = bigint_copy(n);
-  if (n_abs == NULL) {
-      bigint_destroy(resto);
-      return NULL;
+// a + sign * v
+static BigInt *add_signed(const BigInt *a, uint64_t v, int sign) {
+  if (a == NULL) {
+    return NULL;
   }
-  n_abs->sign = 1;
 
-  // Se r < 0, então r = r + |n|
-  if (resto->sign == -1 && bigint_is_zero(resto) == 0) {
-    // r = r + |n|
-    BigInt *aj = bigint_sum(resto, n_abs);
-    bigint_destroy(resto);
-    resto = aj;
+  INSTR_BEGIN(instr_start);
+  uint64_t m;
+  int fits = magnitude_u64(a, &m);
+  BigInt *res;
+  if (fits && m == 0) {
+    res = from_word(v, sign);
+  } else if (a->sign == sign) {
+    res = add_word(a, v, sign);
+  } else if (fits && m < v) {
+    // |a| < v: o resultado tem o sinal de v e cabe em 64 bits
+    res = from_word(v - m, sign);
+  } else {
+    res = sub_word(a, v, a->sign);
   }
+  INSTR_END(a->sign == sign ? INSTR_SUM : INSTR_SUBTRACT,
+            linkedlist_length(a->digits), 1, instr_start);
+  return res;
+}
+
+BigInt *bigint_sum_si(const BigInt *a, int64_t b) {
+  return add_signed(a, abs_i64(b), b < 0 ? -1 : 1);
+}
 
-  bigint_destroy(n_abs);
+BigInt *bigint_sum_ui(const BigInt *a, uint64_t b) {
+  return add_signed(a, b, 1);
+}
+
+BigInt *bigint_subtract_si(const BigInt *a, int64_t b) {
+  return add_signed(a, abs_i64(b), b < 0 ? 1 : -1);
+}
+
+BigInt *bigint_subtract_ui(const BigInt *a, uint64_t b) {
+  return add_signed(a, b, -1);
+}
 
-  // Normaliza o zero se necessário
-  if (bigint_is_zero(resto)) {
-    resto->sign = 1;
+// a * sign * v
+static BigInt *mul_signed(const BigInt *a, uint64_t v, int sign) {
+  if (a == NULL) {
+    return NULL;
   }
 
-  return resto;
+  INSTR_BEGIN(instr_start);
+  BigInt *res = mul_word(a, v, a->sign * sign);
+  INSTR_END(INSTR_MULTIPLY, linkedlist_length(a->digits), 1, instr_start);
+  return res;
+}
+
+BigInt *bigint_multiplicacao_si(const BigInt *a, int64_t b) {
+  return mul_signed(a, abs_i64(b), b < 0 ? -1 : 1);
 }
 
+BigInt *bigint_multiplicacao_ui(const BigInt *a, uint64_t b) {
+  return mul_signed(a, b, 1);
+}
 
-// Multiplica um array decimal por um multiplicador e adiciona um valor
-// Retorna o novo comprimento do array
-static size_t multiply_decimal_array_by_uint32_and_add(char *arr, size_t len,
-                                                       uint64_t multiplier,
-                                                       uint64_t add_value) {
-  uint64_t carry = add_value;
+// Divide |a| por d != 0: *q recebe o quociente (*qn limbs, quem chamar
+// libera) e *r o resto. Se q for NULL só calcula o resto, e para d < 2^32
+// isso é feito nos nós, sem alocar: soma limb * (2^32i mod d) mod d
+// Retorna 0 se faltou memória
+static int divmod_word(const BigInt *a, uint64_t d, uint32_t **q, size_t *qn,
+                       uint64_t *r) {
+  if (q == NULL && d <= UINT32_MAX) {
+    uint64_t power = 1 % d;
+    uint64_t rem = 0;
+    for (const ListNode *node = a->digits->head; node != NULL;
+         node = node->next) {
+      rem = (rem + (uint64_t)node->value * power % d) % d;
+      power = (power << 32) % d;
+    }
+    *r = rem;
+    return 1;
+  }
 
-  for (size_t i = 0; i < len; i++) {
-    carry += (arr[i] - '0') * multiplier;
-    arr[i] = (char)(carry % 10) + '0';
-    carry /= 10;
+  size_t an;
+  uint32_t *limbs = bigint_export_limbs(a, &an);
+  if (limbs == NULL) {
+    return 0;
   }
+  an = limbs_normalized_length(limbs, an);
 
-  // Adiciona novos dígitos se houver carry
-  while (carry > 0) {
-    if (len >= 10000) { // Limite de segurança
-      break;
+  int ok = 1;
+  if (d <= UINT32_MAX) {
+    // Divisão por um limb, com o quociente no próprio array
+    *r = limbs_divmod_1(limbs, limbs, an, (uint32_t)d);
+  } else if (an < 2) {
+    *r = an == 1 ? limbs[0] : 0;
+    an = 0;
+  } else {
+    // Divisor de dois limbs: algoritmo D de Knuth
+    uint32_t dl[2] = {(uint32_t)d, (uint32_t)(d >> 32)};
+    uint32_t rl[2];
+    uint32_t *quot = malloc((an - 1) * sizeof(uint32_t));
+    ok = quot != NULL && limbs_divmod(quot, rl, limbs, an, dl, 2);
+    if (ok) {
+      *r = (uint64_t)rl[0] | (uint64_t)rl[1] << 32;
     }
-    arr[len++] = (char)(carry % 10) + '0';
-    carry /= 10;
+    free(limbs);
+    limbs = quot;
+    an--;
   }
 
-  return len;
+  if (ok && q != NULL) {
+    *q = limbs;
+    *qn = an;
+  } else {
+    free(limbs);
+  }
+  return ok;
 }
 
-// Converte BigInt para string (quem chamar deve liberar o resultado)
-char *bigint_to_string(const BigInt *bi) {
-  if (bi == NULL) {
+// Divisão truncada para zero por sign * v
+static BigInt *div_signed(const BigInt *a, uint64_t v, int sign) {
+  if (a == NULL || v == 0) {
     return NULL;
   }
 
-  size_t len = linkedlist_length(bi->digits);
-
-  if (len == 0) {
-    char *str = malloc(2);
-    if (str == NULL) {
-      return NULL;
-    }
-    str[0] = '0';
-    str[1] = '\0';
-    return str;
+  INSTR_BEGIN(instr_start);
+  uint32_t *q;
+  size_t qn;
+  uint64_t r;
+  if (!divmod_word(a, v, &q, &qn, &r)) {
+    return NULL;
   }
+  BigInt *quociente = bigint_import_limbs(q, qn, a->sign * sign);
+  free(q);
+  INSTR_END(INSTR_DIVIDE, linkedlist_length(a->digits), 1, instr_start);
+  return quociente;
+}
 
-  // Aloca um buffer temporário para construir a string decimal
-  // Estimativa: cada uint32_t pode representar até ~10 dígitos decimais
-  // Usamos um buffer grande para evitar realocações
-  char *decimal_buffer = malloc(10000);
-  if (decimal_buffer == NULL) {
-    return NULL;
+BigInt *bigint_divisao_si(const BigInt *a, int64_t b) {
+  return div_signed(a, abs_i64(b), b < 0 ? -1 : 1);
+}
+
+BigInt *bigint_divisao_ui(const BigInt *a, uint64_t b) {
+  return div_signed(a, b, 1);
+}
+
+// Resto em [0, v), como bigint_mod (o sinal do divisor não importa)
+int bigint_mod_ui(const BigInt *a, uint64_t b, uint64_t *resto) {
+  if (a == NULL || b == 0 || resto == NULL) {
+    return 0;
   }
 
-  decimal_buffer[0] = '0';
-  size_t decimal_len = 1;
+  INSTR_BEGIN(instr_start);
+  uint64_t r;
+  if (!divmod_word(a, b, NULL, NULL, &r)) {
+    return 0;
+  }
+  // Para a < 0 o resto de |a| / b é negativo: r = b - r
+  *resto = a->sign < 0 && r != 0 ? b - r : r;
+  INSTR_END(INSTR_MOD, linkedlist_length(a->digits), 1, instr_start);
+  return 1;
+}
 
-  // Converte de base 2^32 para decimal
-  // Começamos do MSB (mais significativo) para o LSB (menos significativo)
-  uint64_t base = ((uint64_t)UINT32_MAX) + 1ULL; // 2^32
+int bigint_mod_si(const BigInt *a, int64_t b, uint64_t *resto) {
+  return bigint_mod_ui(a, abs_i64(b), resto);
+}
 
-  for (int i = (int)len - 1; i >= 0; i--) {
-    uint32_t value = linkedlist_get(bi->digits, i);
+// Compara |a| com v. Retorna 1, 0 ou -1
+static int compare_abs_word(const BigInt *a, uint64_t v) {
+  uint64_t m;
+  if (!magnitude_u64(a, &m)) {
+    return 1;
+  }
+  return m > v ? 1 : (m < v ? -1 : 0);
+}
 
-    // Multiplica o resultado atual por 2^32 e adiciona o próximo valor
-    decimal_len = multiply_decimal_array_by_uint32_and_add(
-        decimal_buffer, decimal_len, base, value);
+// Compara a com sign * v
+static int compare_signed(const BigInt *a, uint64_t v, int sign) {
+  if (a == NULL) {
+    return 0;
   }
+  int a_sign = compare_abs_word(a, 0) == 0 ? 0 : a->sign;
+  int v_sign = v == 0 ? 0 : sign;
+  if (a_sign != v_sign) {
+    return a_sign > v_sign ? 1 : -1;
+  }
+  return a_sign * compare_abs_word(a, v);
+}
 
-  // Calcula o tamanho necessário para a string final (incluindo sinal e
-  // terminador)
-  size_t str_len = decimal_len + (bi->sign == -1 ? 1 : 0) + 1;
-  char *str = malloc(str_len);
-  if (str == NULL) {
-    free(decimal_buffer);
+int bigint_compare_si(const BigInt *a, int64_t b) {
+  return compare_signed(a, abs_i64(b), b < 0 ? -1 : 1);
+}
+
+int bigint_compare_ui(const BigInt *a, uint64_t b) {
+  return compare_signed(a, b, 1);
+}
+
+// Converte BigInt para string (quem chamar deve liberar o resultado)
+char *bigint_to_string(const BigInt *bi) {
+  if (bi == NULL) {
     return NULL;
   }
 
-  int index = 0;
-
-  // Adiciona o sinal se for negativo
-  if (bi->sign == -1) {
-    str[index++] = '-';
+  INSTR_BEGIN(instr_start);
+  size_t len = 0;
+  uint32_t *limbs = bigint_export_limbs(bi, &len);
+  if (limbs == NULL) {
+    return NULL;
   }
+  len = limbs_normalized_length(limbs, len);
 
-  // Copia os dígitos em ordem reversa (MSB para LSB)
-  for (int i = (int)decimal_len - 1; i >= 0; i--) {
-    str[index++] = decimal_buffer[i];
+  // Os dígitos são escritos alinhados ao fim do buffer (cada metade da
+  // conversão já sabe sua posição); depois o resultado é movido para o início
+  size_t capacity = radix_decimal_capacity(len) + 2;
+  char *str = malloc(capacity);
+  if (str == NULL) {
+    free(limbs);
+    return NULL;
   }
 
-  str[index] = '\0';
+  char *end = str + capacity - 1;
+  *end = '\0';
+  char *start = radix_write_decimal(end, limbs, len);
+  free(limbs);
+  if (start == NULL) {
+    free(str);
+    return NULL;
+  }
 
-  free(decimal_buffer);
+  // Adiciona o sinal se for negativo
+  if (bi->sign == -1 && len > 0) {
+    *--start = '-';
+  }
+  memmove(str, start, (size_t)(end - start) + 1);
+  INSTR_END(INSTR_TO_STRING, len, 0, instr_start);
   return str;
 }
 
@@ -783,18 +935,89 @@ int bigint_is_zero(const BigInt *bi) {
   return 0;
 }
 
+// Algoritmo de Euclides, com um ponto de verificação do ExecContext por resto
 BigInt *bigint_gcd(BigInt *a, BigInt *b) {
+  INSTR_BEGIN(instr_start);
   BigInt *temp_a = bigint_copy(a);
   BigInt *temp_b = bigint_copy(b);
   BigInt *resto = NULL;
+  size_t total = temp_a != NULL ? linkedlist_length(temp_a->digits) : 0;
 
-  while (!bigint_is_zero(temp_a)) {
+  while (temp_a != NULL && temp_b != NULL && !bigint_is_zero(temp_a)) {
+    // O progresso é medido pelos limbs já eliminados do menor operando
+    size_t restam = linkedlist_length(temp_a->digits);
+    if (exec_checkpoint("mdc", restam < total ? total - restam : 0, total)) {
+      break;
+    }
     resto = bigint_mod(temp_b, temp_a);
     bigint_destroy(temp_b);
     temp_b = temp_a;
     temp_a = resto;
   }
 
+  // Só há resultado se o laço chegou ao resto zero
+  if (temp_a == NULL || !bigint_is_zero(temp_a)) {
+    bigint_destroy(temp_b);
+    temp_b = NULL;
+  }
   bigint_destroy(temp_a);
+  INSTR_END(INSTR_GCD, a != NULL ? linkedlist_length(a->digits) : 0,
+            b != NULL ? linkedlist_length(b->digits) : 0, instr_start);
   return temp_b;
-}
\ No newline at end of file
+}
+// Exporta os limbs (LSB primeiro) para um array contíguo
+// Percorre os nós diretamente: O(n), sem linkedlist_get por índice
+uint32_t *bigint_export_limbs(const BigInt *bi, size_t *count) {
+  if (bi == NULL || bi->digits == NULL || count == NULL) {
+    return NULL;
+  }
+
+  size_t len = linkedlist_length(bi->digits);
+  uint32_t *limbs = malloc((len > 0 ? len : 1) * sizeof(uint32_t));
+  if (limbs == NULL) {
+    return NULL;
+  }
+
+  size_t i = 0;
+  for (ListNode *node = bi->digits->head; node != NULL; node = node->next) {
+    limbs[i++] = node->value;
+  }
+
+  *count = len;
+  return limbs;
+}
+
+// Cria um BigInt a partir de um array de limbs (LSB primeiro)
+BigInt *bigint_import_limbs(const uint32_t *limbs, size_t count, int sign) {
+  if (limbs == NULL && count > 0) {
+    return NULL;
+  }
+
+  // Ignora limbs zerados mais significativos
+  while (count > 0 && limbs[count - 1] == 0) {
+    count--;
+  }
+
+  BigInt *bi = bigint_create_empty(0);
+  if (bi == NULL) {
+    return NULL;
+  }
+
+  if (count == 0) {
+    linkedlist_append(bi->digits, 0);
+    return bi;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    linkedlist_append(bi->digits, limbs[i]);
+  }
+
+  if (linkedlist_length(bi->digits) != count) {
+    // Falha de alocação no meio da construção
+    bigint_destroy(bi);
+    return NULL;
+  }
+
+  bi->sign = (sign < 0) ? -1 : 1;
+  return bi;
+}
@@ -5,6 +5,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// Todas as funções são reentrantes: não há estado global mutável, então
+// BigInts distintos podem ser usados em threads diferentes ao mesmo tempo
+// e um mesmo BigInt pode ser lido (nunca modificado) por várias threads
+
 // Estrutura BigInt que armazena dígitos dinamicamente usando LinkedList
 // Cada nó armazena um valor de 32 bits (base 2^32)
 typedef struct {
@@ -16,18 +20,38 @@ typedef struct {
 // Cria um BigInt a partir de uma string
 BigInt *bigint_create_from_string(const char *str);
 
+// Cria um BigInt a partir de um span de caracteres (não precisa de '\0')
+// Aceita espaços iniciais, sinal opcional e lê os dígitos até o fim do span
+// ou até o primeiro caractere que não for dígito
+BigInt *bigint_create_from_chars(const char *str, size_t len);
+
 // Cria um BigInt a partir de um inteiro
 BigInt *bigint_create_from_int(int num);
 
+// Cria um BigInt a partir de um inteiro de 64 bits (com ou sem sinal)
+BigInt *bigint_create_from_i64(int64_t num);
+BigInt *bigint_create_from_u64(uint64_t num);
+
+// Converte para inteiro de 64 bits. Se o valor não couber, *overflow (se
+// não for NULL) recebe 1 e o retorno é saturado (INT64_MIN/INT64_MAX, ou
+// 0/UINT64_MAX); caso contrário *overflow recebe 0
+int64_t bigint_to_i64(const BigInt *bi, int *overflow);
+uint64_t bigint_to_u64(const BigInt *bi, int *overflow);
+
 // Cria um BigInt vazio com capacidade inicial
 BigInt *bigint_create_empty(size_t initial_capacity);
 
 // Destrói um BigInt e libera sua memória
 void bigint_destroy(BigInt *bi);
 
-// Cria uma cópia de um BigInt
+// Cria uma cópia de um BigInt em O(1): os limbs são compartilhados
+// (copy-on-write) e só são copiados se uma das cópias for modificada
 BigInt *bigint_copy(const BigInt *bi);
 
+// Retorna -x e |x| como cópias O(1) (compartilham os limbs de x)
+BigInt *bigint_negate(const BigInt *x);
+BigInt *bigint_abs(const BigInt *x);
+
 // Soma dois BigInts e retorna o resultado
 BigInt *bigint_sum(const BigInt *a, const BigInt *b);
 
@@ -47,6 +71,36 @@ BigInt *bigint_mod(const BigInt *a, const BigInt *b);
 // Retorna: 1 se a > b, 0 se a == b, -1 se a < b
 int bigint_compare(const BigInt *a, const BigInt *b);
 
+// Operações mistas com um inteiro nativo (_si: int64_t, _ui: uint64_t)
+// O inteiro não vira um BigInt temporário: os kernels de palavra percorrem
+// os nós de a uma única vez e só alocam o resultado. Mesma semântica das
+// versões BigInt/BigInt (divisão truncada para zero, resto em [0, |b|))
+BigInt *bigint_sum_si(const BigInt *a, int64_t b);
+BigInt *bigint_sum_ui(const BigInt *a, uint64_t b);
+BigInt *bigint_subtract_si(const BigInt *a, int64_t b);
+BigInt *bigint_subtract_ui(const BigInt *a, uint64_t b);
+BigInt *bigint_multiplicacao_si(const BigInt *a, int64_t b);
+BigInt *bigint_multiplicacao_ui(const BigInt *a, uint64_t b);
+
+// Retorna NULL se b for zero
+BigInt *bigint_divisao_si(const BigInt *a, int64_t b);
+BigInt *bigint_divisao_ui(const BigInt *a, uint64_t b);
+
+// O resto cabe em 64 bits e é guardado em *resto (sem alocar nada se
+// |b| < 2^32). Retorna 0 se b for zero ou se faltou memória
+int bigint_mod_si(const BigInt *a, int64_t b, uint64_t *resto);
+int bigint_mod_ui(const BigInt *a, uint64_t b, uint64_t *resto);
+
+// Retorna: 1 se a > b, 0 se a == b, -1 se a < b
+int bigint_compare_si(const BigInt *a, int64_t b);
+int bigint_compare_ui(const BigInt *a, uint64_t b);
+
+// Hash de 64 bits do valor (valores iguais têm o mesmo hash)
+uint64_t bigint_hash(const BigInt *bi);
+
+// Retorna 1 se a e b têm o mesmo valor, 0 caso contrário
+int bigint_equal(const BigInt *a, const BigInt *b);
+
 // Converte BigInt para string (quem chamar deve liberar o resultado)
 char *bigint_to_string(const BigInt *bi);
 
@@ -57,6 +111,15 @@ void bigint_print(const BigInt *bi);
 int bigint_is_zero(const BigInt *a);
 
 // Retorna o máximo divisor comum entre dois BigInts
+// Retorna NULL se faltou memória ou se o ExecContext da thread pediu para
+// parar (o mesmo vale para divisão e módulo)
 BigInt *bigint_gcd(BigInt *a, BigInt *b);
 
+// Exporta os limbs (LSB primeiro) para um array contíguo
+// Guarda a quantidade em *count (quem chamar deve liberar o resultado)
+uint32_t *bigint_export_limbs(const BigInt *bi, size_t *count);
+
+// Cria um BigInt a partir de um array de limbs (LSB primeiro)
+BigInt *bigint_import_limbs(const uint32_t *limbs, size_t count, int sign);
+
 #endif // BIGINT_H
@@ -0,0 +1,383 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "BigIntSerial.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME        0x100000001b3ULL
+
+// Tamanho do bloco usado para gravar os limbs (em limbs)
+#define SAVE_CHUNK_LIMBS 4096
+
+// Atualiza o checksum FNV-1a 64 com um bloco de bytes
+static uint64_t fnv1a_update(uint64_t hash, const unsigned char *data,
+                             size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// Retorna 1 se o host armazena inteiros em little-endian
+static int host_is_little_endian(void) {
+  const uint32_t probe = 1;
+  unsigned char first;
+  memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+static void write_u32_le(unsigned char *out, uint32_t value) {
+  out[0] = (unsigned char)(value & 0xFF);
+  out[1] = (unsigned char)((value >> 8) & 0xFF);
+  out[2] = (unsigned char)((value >> 16) & 0xFF);
+  out[3] = (unsigned char)((value >> 24) & 0xFF);
+}
+
+static void write_u64_le(unsigned char *out, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    out[i] = (unsigned char)((value >> (8 * i)) & 0xFF);
+  }
+}
+
+static uint32_t read_u32_le(const unsigned char *in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+         ((uint32_t)in[3] << 24);
+}
+
+static uint64_t read_u64_le(const unsigned char *in) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) {
+    value = (value << 8) | in[i];
+  }
+  return value;
+}
+
+// Valida cabeçalho, tamanho e checksum de um arquivo binário em memória
+// Retorna 1 se for válido, preenchendo *count e *sign
+static int validate_buffer(const unsigned char *buf, size_t size,
+                           size_t *count, int *sign) {
+  if (size < BIGINT_SERIAL_HEADER_SIZE + 8) {
+    return 0;
+  }
+  if (memcmp(buf, BIGINT_SERIAL_MAGIC, 4) != 0 ||
+      buf[4] != BIGINT_SERIAL_VERSION || buf[5] > 1 ||
+      buf[6] != sizeof(uint32_t) || buf[7] != 0) {
+    return 0;
+  }
+
+  uint64_t n = read_u64_le(buf + 8);
+  if (n > (SIZE_MAX - BIGINT_SERIAL_HEADER_SIZE - 8) / sizeof(uint32_t) ||
+      size != BIGINT_SERIAL_HEADER_SIZE + n * sizeof(uint32_t) + 8) {
+    return 0;
+  }
+
+  size_t payload = size - 8;
+  uint64_t expected = read_u64_le(buf + payload);
+  if (fnv1a_update(FNV_OFFSET_BASIS, buf, payload) != expected) {
+    return 0;
+  }
+
+  *count = (size_t)n;
+  *sign = buf[5] ? -1 : 1;
+  return 1;
+}
+
+// Grava um BigInt no formato binário. Retorna 1 em sucesso, 0 em erro
+int bigint_save(const BigInt *bi, const char *path) {
+  if (bi == NULL || bi->digits == NULL || path == NULL) {
+    return 0;
+  }
+
+  FILE *fout = fopen(path, "wb");
+  if (fout == NULL) {
+    return 0;
+  }
+
+  size_t count = linkedlist_length(bi->digits);
+  unsigned char header[BIGINT_SERIAL_HEADER_SIZE];
+  memcpy(header, BIGINT_SERIAL_MAGIC, 4);
+  header[4] = BIGINT_SERIAL_VERSION;
+  header[5] = (bi->sign == -1 && !bigint_is_zero(bi)) ? 1 : 0;
+  header[6] = sizeof(uint32_t);
+  header[7] = 0;
+  write_u64_le(header + 8, (uint64_t)count);
+
+  uint64_t hash = fnv1a_update(FNV_OFFSET_BASIS, header, sizeof(header));
+  int ok = fwrite(header, 1, sizeof(header), fout) == sizeof(header);
+
+  // Percorre a lista uma única vez, gravando em blocos
+  unsigned char chunk[SAVE_CHUNK_LIMBS * sizeof(uint32_t)];
+  size_t used = 0;
+  for (ListNode *node = bi->digits->head; ok && node != NULL;
+       node = node->next) {
+    write_u32_le(chunk + used, node->value);
+    used += sizeof(uint32_t);
+    if (used == sizeof(chunk) || node->next == NULL) {
+      hash = fnv1a_update(hash, chunk, used);
+      ok = fwrite(chunk, 1, used, fout) == used;
+      used = 0;
+    }
+  }
+
+  unsigned char trailer[8];
+  write_u64_le(trailer, hash);
+  if (ok) {
+    ok = fwrite(trailer, 1, sizeof(trailer), fout) == sizeof(trailer);
+  }
+
+  if (fclose(fout) != 0) {
+    ok = 0;
+  }
+  return ok;
+}
+
+// Mapeia o arquivo com mmap sem copiar os limbs (valida o checksum)
+int bigint_view_open(const char *path, BigIntView *view) {
+  if (path == NULL || view == NULL || !host_is_little_endian()) {
+    return 0;
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+
+  size_t size = (size_t)st.st_size;
+  void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return 0;
+  }
+
+  // Leitura sequencial: o kernel pode fazer read-ahead agressivo
+  posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+
+  size_t count;
+  int sign;
+  if (!validate_buffer(map, size, &count, &sign)) {
+    munmap(map, size);
+    return 0;
+  }
+
+  view->limbs =
+      (const uint32_t *)((const unsigned char *)map + BIGINT_SERIAL_HEADER_SIZE);
+  view->count = count;
+  view->sign = sign;
+  view->map = map;
+  view->map_size = size;
+  return 1;
+}
+
+// Desfaz o mapeamento de uma visão aberta com bigint_view_open
+void bigint_view_close(BigIntView *view) {
+  if (view == NULL || view->map == NULL) {
+    return;
+  }
+  munmap(view->map, view->map_size);
+  view->map = NULL;
+  view->limbs = NULL;
+  view->count = 0;
+}
+
+int bigint_temp_open(const char *path, char **temp_path) {
+  static const char suffix[] = ".tmp.XXXXXX";
+  size_t len = strlen(path);
+  char *name = malloc(len + sizeof(suffix));
+  if (name == NULL) {
+    return -1;
+  }
+  memcpy(name, path, len);
+  memcpy(name + len, suffix, sizeof(suffix));
+
+  int fd = mkstemp(name);
+  if (fd < 0) {
+    free(name);
+    return -1;
+  }
+  fchmod(fd, 0644); // mkstemp cria com 0600
+  *temp_path = name;
+  return fd;
+}
+
+// Libera os nomes e fecha o writer
+static void writer_release(BigIntWriter *w) {
+  free(w->path);
+  free(w->temp_path);
+  w->path = NULL;
+  w->temp_path = NULL;
+  w->map = NULL;
+  w->limbs = NULL;
+}
+
+// Cria o temporário com o tamanho final máximo (cabeçalho + limbs +
+// checksum) e mapeia para escrita; ftruncate deixa os limbs zerados sem
+// escrevê-los
+int bigint_writer_open(const char *path, size_t count, BigIntWriter *w) {
+  if (path == NULL || w == NULL || !host_is_little_endian() ||
+      count > (SIZE_MAX - BIGINT_SERIAL_HEADER_SIZE - 8) / sizeof(uint32_t)) {
+    return 0;
+  }
+
+  if (count == 0) {
+    count = 1; // Como bigint_save, o zero é gravado com um limb
+  }
+
+  w->path = malloc(strlen(path) + 1);
+  w->temp_path = NULL;
+  int fd = w->path != NULL ? bigint_temp_open(path, &w->temp_path) : -1;
+  if (fd < 0) {
+    free(w->path);
+    return 0;
+  }
+  strcpy(w->path, path);
+
+  size_t size = BIGINT_SERIAL_HEADER_SIZE + count * sizeof(uint32_t) + 8;
+  void *map = MAP_FAILED;
+  if (ftruncate(fd, (off_t)size) == 0) {
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  if (map == MAP_FAILED) {
+    close(fd);
+    unlink(w->temp_path);
+    writer_release(w);
+    return 0;
+  }
+
+  w->limbs = (uint32_t *)((unsigned char *)map + BIGINT_SERIAL_HEADER_SIZE);
+  w->count = count;
+  w->sign = 1;
+  w->fd = fd;
+  w->map = map;
+  w->map_size = size;
+  return 1;
+}
+
+void bigint_writer_abort(BigIntWriter *w) {
+  if (w == NULL || w->map == NULL) {
+    return;
+  }
+  munmap(w->map, w->map_size);
+  close(w->fd);
+  unlink(w->temp_path);
+  writer_release(w);
+}
+
+int bigint_writer_close(BigIntWriter *w) {
+  if (w == NULL || w->map == NULL) {
+    return 0;
+  }
+
+  size_t count = w->count;
+  while (count > 1 && w->limbs[count - 1] == 0) {
+    count--;
+  }
+  int negative = w->sign < 0 && w->limbs[count - 1] != 0;
+
+  unsigned char *header = w->map;
+  memcpy(header, BIGINT_SERIAL_MAGIC, 4);
+  header[4] = BIGINT_SERIAL_VERSION;
+  header[5] = negative ? 1 : 0;
+  header[6] = sizeof(uint32_t);
+  header[7] = 0;
+  write_u64_le(header + 8, (uint64_t)count);
+
+  size_t payload = BIGINT_SERIAL_HEADER_SIZE + count * sizeof(uint32_t);
+  write_u64_le(header + payload,
+               fnv1a_update(FNV_OFFSET_BASIS, header, payload));
+
+  int ok = msync(w->map, w->map_size, MS_SYNC) == 0;
+  munmap(w->map, w->map_size);
+  ok = ftruncate(w->fd, (off_t)(payload + 8)) == 0 && ok;
+  ok = close(w->fd) == 0 && ok;
+  // Só agora o destino é substituído (os mapeamentos dele seguem válidos)
+  ok = ok && rename(w->temp_path, w->path) == 0;
+  if (!ok) {
+    unlink(w->temp_path);
+  }
+  writer_release(w);
+  return ok;
+}
+
+// Carrega lendo o arquivo inteiro e convertendo cada limb (hosts big-endian)
+static BigInt *load_by_reading(const char *path) {
+  FILE *fin = fopen(path, "rb");
+  if (fin == NULL) {
+    return NULL;
+  }
+
+  if (fseek(fin, 0, SEEK_END) != 0) {
+    fclose(fin);
+    return NULL;
+  }
+  long file_size = ftell(fin);
+  rewind(fin);
+  if (file_size <= 0) {
+    fclose(fin);
+    return NULL;
+  }
+
+  size_t size = (size_t)file_size;
+  unsigned char *buf = malloc(size);
+  if (buf == NULL) {
+    fclose(fin);
+    return NULL;
+  }
+  size_t got = fread(buf, 1, size, fin);
+  fclose(fin);
+
+  size_t count;
+  int sign;
+  if (got != size || !validate_buffer(buf, size, &count, &sign)) {
+    free(buf);
+    return NULL;
+  }
+
+  uint32_t *limbs = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+  if (limbs == NULL) {
+    free(buf);
+    return NULL;
+  }
+  for (size_t i = 0; i < count; i++) {
+    limbs[i] =
+        read_u32_le(buf + BIGINT_SERIAL_HEADER_SIZE + i * sizeof(uint32_t));
+  }
+  free(buf);
+
+  BigInt *bi = bigint_import_limbs(limbs, count, sign);
+  free(limbs);
+  return bi;
+}
+
+// Carrega um BigInt do formato binário (valida o checksum)
+BigInt *bigint_load(const char *path) {
+  if (path == NULL) {
+    return NULL;
+  }
+
+  if (!host_is_little_endian()) {
+    return load_by_reading(path);
+  }
+
+  BigIntView view;
+  if (!bigint_view_open(path, &view)) {
+    return NULL;
+  }
+
+  BigInt *bi = bigint_import_limbs(view.limbs, view.count, view.sign);
+  bigint_view_close(&view);
+  return bi;
+}
@@ -0,0 +1,85 @@
+#ifndef BIGINTSERIAL_H
+#define BIGINTSERIAL_H
+
+#include "../BigInt/BigInt.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Formato binário do BigInt em disco (todos os campos em little-endian)
+//
+//   offset  tamanho  campo
+//   0       4        magic "PEBI"
+//   4       1        versão do formato (BIGINT_SERIAL_VERSION)
+//   5       1        sinal (0 = positivo, 1 = negativo)
+//   6       1        largura do limb em bytes (4)
+//   7       1        endianness dos limbs (0 = little-endian)
+//   8       8        quantidade de limbs (n)
+//   16      4 * n    limbs, LSB primeiro
+//   16+4n   8        checksum FNV-1a 64 de todos os bytes anteriores
+//
+// Os limbs começam em um offset múltiplo de 4, então em hosts little-endian
+// o arquivo mapeado com mmap já é um array uint32_t válido (zero-copy).
+#define BIGINT_SERIAL_MAGIC       "PEBI"
+#define BIGINT_SERIAL_VERSION     1
+#define BIGINT_SERIAL_HEADER_SIZE 16
+
+// Visão somente leitura de um arquivo binário mapeado em memória
+typedef struct {
+  const uint32_t *limbs; // Limbs apontando direto para o mapeamento
+  size_t count;          // Quantidade de limbs
+  int sign;              // 1 para positivo, -1 para negativo
+  void *map;             // Início do mapeamento (uso interno)
+  size_t map_size;       // Tamanho do mapeamento (uso interno)
+} BigIntView;
+
+// Grava um BigInt no formato binário. Retorna 1 em sucesso, 0 em erro
+int bigint_save(const BigInt *bi, const char *path);
+
+// Carrega um BigInt do formato binário (valida o checksum)
+// Retorna NULL se o arquivo não existir ou for inválido
+BigInt *bigint_load(const char *path);
+
+// Mapeia o arquivo com mmap sem copiar os limbs (valida o checksum)
+// Só é possível quando o layout dos limbs coincide com o do host
+// Retorna 1 em sucesso, 0 em erro
+int bigint_view_open(const char *path, BigIntView *view);
+
+// Desfaz o mapeamento de uma visão aberta com bigint_view_open
+void bigint_view_close(BigIntView *view);
+
+// Arquivo binário em construção, mapeado para escrita (MAP_SHARED): os
+// limbs são escritos direto no arquivo, sem passar por um BigInt
+// O arquivo é criado com um nome temporário no diretório do destino e só
+// substitui o destino (rename) ao ser finalizado. Assim o destino pode ser
+// um dos operandos ainda mapeados: eles continuam vendo o conteúdo antigo
+typedef struct {
+  uint32_t *limbs; // count limbs, inicialmente zerados
+  size_t count;    // Capacidade reservada (em limbs)
+  int sign;        // Sinal gravado ao finalizar (1 ou -1)
+  int fd;          // Uso interno
+  void *map;       // Uso interno
+  size_t map_size; // Uso interno
+  char *path;      // Destino (uso interno)
+  char *temp_path; // Arquivo temporário (uso interno)
+} BigIntWriter;
+
+// Cria o arquivo temporário com espaço para count limbs zerados
+// Só é possível quando o layout dos limbs coincide com o do host
+// Retorna 1 em sucesso, 0 em erro
+int bigint_writer_open(const char *path, size_t count, BigIntWriter *w);
+
+// Descarta os limbs zerados do topo, grava cabeçalho, sinal e checksum
+// (uma passada sequencial), ajusta o tamanho e renomeia para o destino
+// Retorna 1 em sucesso, 0 em erro; o writer é fechado nos dois casos
+int bigint_writer_close(BigIntWriter *w);
+
+// Fecha sem finalizar, quando a operação falhou: o temporário é removido e
+// o destino não muda
+void bigint_writer_abort(BigIntWriter *w);
+
+// Cria um arquivo temporário (modo 0644) no mesmo diretório de path, para
+// depois substituir path com rename. Retorna o descritor e o nome alocado
+// em *temp_path (quem chamar libera), ou -1 em erro
+int bigint_temp_open(const char *path, char **temp_path);
+
+#endif // BIGINTSERIAL_H
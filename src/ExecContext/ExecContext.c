@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ExecContext.h"
+#include <pthread.h>
+#include <time.h>
+
+static pthread_key_t current_key;
+static pthread_once_t current_once = PTHREAD_ONCE_INIT;
+
+static void create_current_key(void) {
+  pthread_key_create(&current_key, NULL);
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void exec_init(ExecContext *ctx) {
+  ctx->deadline_ns = 0;
+  ctx->status = EXEC_OK;
+  ctx->progress = NULL;
+  ctx->progress_arg = NULL;
+  ctx->last_report_ns = 0;
+}
+
+void exec_set_deadline(ExecContext *ctx, double seconds) {
+  ctx->deadline_ns =
+      seconds > 0 ? now_ns() + (uint64_t)(seconds * 1e9) : 0;
+}
+
+// O primeiro relatório só sai depois de um intervalo: operações rápidas
+// não chamam o callback
+void exec_set_progress(ExecContext *ctx, ExecProgressFn fn, void *arg) {
+  ctx->progress = fn;
+  ctx->progress_arg = arg;
+  ctx->last_report_ns = now_ns();
+}
+
+// Registra o motivo da parada; o primeiro motivo prevalece
+static void stop(ExecContext *ctx, ExecStatus status) {
+  int expected = EXEC_OK;
+  __atomic_compare_exchange_n(&ctx->status, &expected, (int)status, 0,
+                              __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+
+void exec_cancel(ExecContext *ctx) { stop(ctx, EXEC_CANCELLED); }
+
+ExecStatus exec_status(const ExecContext *ctx) {
+  return (ExecStatus)__atomic_load_n(&ctx->status, __ATOMIC_ACQUIRE);
+}
+
+const char *exec_status_message(ExecStatus status) {
+  switch (status) {
+  case EXEC_CANCELLED: return "cancelado";
+  case EXEC_TIMEOUT: return "tempo esgotado";
+  default: return "ok";
+  }
+}
+
+ExecContext *exec_enter(ExecContext *ctx) {
+  pthread_once(&current_once, create_current_key);
+  ExecContext *previous = pthread_getspecific(current_key);
+  pthread_setspecific(current_key, ctx);
+  return previous;
+}
+
+void exec_leave(ExecContext *previous) {
+  pthread_setspecific(current_key, previous);
+}
+
+ExecContext *exec_current(void) {
+  pthread_once(&current_once, create_current_key);
+  return pthread_getspecific(current_key);
+}
+
+int exec_checkpoint(const char *stage, size_t done, size_t total) {
+  ExecContext *ctx = exec_current();
+  if (ctx == NULL) {
+    return 0;
+  }
+  if (__atomic_load_n(&ctx->status, __ATOMIC_ACQUIRE) != EXEC_OK) {
+    return 1;
+  }
+  if (ctx->deadline_ns == 0 && (ctx->progress == NULL || stage == NULL)) {
+    return 0;
+  }
+
+  uint64_t now = now_ns();
+  if (ctx->deadline_ns != 0 && now >= ctx->deadline_ns) {
+    stop(ctx, EXEC_TIMEOUT);
+    return 1;
+  }
+  if (ctx->progress != NULL && stage != NULL && total > 0) {
+    // Só a thread que avança o instante do último relatório chama o
+    // callback
+    uint64_t last = __atomic_load_n(&ctx->last_report_ns, __ATOMIC_RELAXED);
+    if (now - last >= EXEC_PROGRESS_INTERVAL_NS &&
+        __atomic_compare_exchange_n(&ctx->last_report_ns, &last, now, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      ctx->progress(ctx->progress_arg, stage, (double)done / (double)total);
+    }
+  }
+  return 0;
+}
+
+int exec_stopped(void) {
+  ExecContext *ctx = exec_current();
+  return ctx != NULL &&
+         __atomic_load_n(&ctx->status, __ATOMIC_ACQUIRE) != EXEC_OK;
+}
@@ -0,0 +1,76 @@
+#ifndef EXECCONTEXT_H
+#define EXECCONTEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Contexto de execução cooperativo: prazo, pedido de cancelamento e
+// callback de progresso de uma operação longa
+// O contexto é instalado na thread com exec_enter e herdado pelas tarefas
+// que ela agenda no Scheduler. Os algoritmos longos (divisão, mdc,
+// potências, fatorial, primalidade...) chamam exec_checkpoint nos laços
+// externos e, quando ele pede para parar, desistem e retornam como se
+// tivesse faltado memória (NULL ou 0). Quem executou a operação distingue
+// os casos por exec_status: com status diferente de EXEC_OK, o resultado
+// (mesmo que não seja NULL) deve ser descartado
+// Uma única multiplicação não é interrompida no meio
+
+typedef enum {
+  EXEC_OK = 0,
+  EXEC_CANCELLED, // exec_cancel foi chamado
+  EXEC_TIMEOUT    // O prazo acabou
+} ExecStatus;
+
+// Progresso de uma etapa ("divisao", "mdc", ...), com fraction em [0, 1]
+// Pode ser chamado de qualquer worker que esteja executando a operação
+typedef void (*ExecProgressFn)(void *arg, const char *stage,
+                               double fraction);
+
+// Intervalo mínimo entre duas chamadas do callback de progresso
+#define EXEC_PROGRESS_INTERVAL_NS 200000000ULL
+
+typedef struct {
+  uint64_t deadline_ns;    // Instante limite (CLOCK_MONOTONIC); 0: sem
+  int status;              // ExecStatus (acesso atômico)
+  ExecProgressFn progress; // NULL: sem progresso
+  void *progress_arg;
+  uint64_t last_report_ns; // Acesso atômico
+} ExecContext;
+
+// Inicializa sem prazo, sem progresso e com status EXEC_OK
+void exec_init(ExecContext *ctx);
+
+// Prazo de seconds segundos a partir de agora (<= 0: sem prazo)
+void exec_set_deadline(ExecContext *ctx, double seconds);
+
+void exec_set_progress(ExecContext *ctx, ExecProgressFn fn, void *arg);
+
+// Pede que a operação pare no próximo ponto de verificação
+// Pode ser chamado de qualquer thread, antes ou durante a execução
+void exec_cancel(ExecContext *ctx);
+
+// Motivo pelo qual a operação parou, ou EXEC_OK
+ExecStatus exec_status(const ExecContext *ctx);
+
+// Mensagem curta do status ("ok", "cancelado", "tempo esgotado")
+const char *exec_status_message(ExecStatus status);
+
+// Instala ctx (pode ser NULL) como contexto da thread atual e retorna o
+// anterior, que deve ser restaurado com exec_leave
+ExecContext *exec_enter(ExecContext *ctx);
+void exec_leave(ExecContext *previous);
+
+// Contexto da thread atual (NULL fora de uma operação com contexto)
+ExecContext *exec_current(void);
+
+// Ponto de verificação dos laços longos: confere o cancelamento e o prazo
+// do contexto atual e, se stage não for NULL, reporta done de total ao
+// callback (no máximo a cada EXEC_PROGRESS_INTERVAL_NS)
+// Retorna 1 se a operação deve parar. Sem contexto custa uma leitura de
+// variável da thread
+int exec_checkpoint(const char *stage, size_t done, size_t total);
+
+// Retorna 1 se o contexto atual já parou (sem consultar o relógio)
+int exec_stopped(void);
+
+#endif // EXECCONTEXT_H
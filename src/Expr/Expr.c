@@ -0,0 +1,921 @@
+#include "Expr.h"
+#include "../Limbs/Limbs.h"
+#include "../Power/Power.h"
+#include "../ProductTree/ProductTree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXPR_NONE ((size_t)-1)
+
+// Quantidade inicial de buckets da tabela de nós (dobra quando enche)
+#define EXPR_INITIAL_BUCKETS 64
+
+// Aninhamento máximo de parênteses/operadores (protege a pilha do parser)
+#define EXPR_MAX_DEPTH 2000
+
+// A partir deste tamanho (limbs) o módulo de powmod/mulmod é reduzido com
+// o recíproco calculado uma única vez (Barrett) em vez do algoritmo D
+#define EXPR_PREINV_THRESHOLD 1000
+
+typedef enum {
+  EXPR_CONST,
+  EXPR_ADD,
+  EXPR_SUB,
+  EXPR_MUL,
+  EXPR_DIV,
+  EXPR_MOD,
+  EXPR_NEG,
+  EXPR_ABS,
+  EXPR_POW,
+  EXPR_GCD,
+  EXPR_FAT,
+  EXPR_BINOM,
+  EXPR_FIB,
+  EXPR_LUCAS,
+  EXPR_POWMOD,
+  EXPR_MULMOD
+} ExprOp;
+
+typedef struct {
+  // Operação executada (a fusão pode trocá-la por powmod/mulmod)
+  ExprOp op;
+  size_t args[3];
+  // Chave do hash-consing: a operação como foi escrita
+  ExprOp key_op;
+  size_t key_args[3];
+  BigInt *literal; // Valor de EXPR_CONST
+  uint64_t hash;
+  size_t next; // Próximo nó no bucket
+} ExprNode;
+
+typedef struct {
+  char *name;
+  size_t node;
+} ExprVar;
+
+struct ExprProgram {
+  ExprNode *nodes;
+  size_t count, capacity;
+  size_t *buckets;
+  size_t bucket_count;
+  ExprVar *vars;
+  size_t var_count, var_capacity;
+  size_t *outputs; // Nó de cada saída (EXPR_NONE se não compilou)
+  size_t output_count, output_capacity;
+  ExprStats stats;
+  char error[160];
+};
+
+static uint64_t mix64(uint64_t h) {
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
+}
+
+static void set_error(ExprProgram *p, const char *msg) {
+  if (p->error[0] == '\0') {
+    snprintf(p->error, sizeof(p->error), "%s", msg);
+  }
+}
+
+ExprProgram *expr_create(void) {
+  ExprProgram *p = calloc(1, sizeof(ExprProgram));
+  if (p == NULL) {
+    return NULL;
+  }
+  p->buckets = malloc(EXPR_INITIAL_BUCKETS * sizeof(size_t));
+  if (p->buckets == NULL) {
+    free(p);
+    return NULL;
+  }
+  for (size_t i = 0; i < EXPR_INITIAL_BUCKETS; i++) {
+    p->buckets[i] = EXPR_NONE;
+  }
+  p->bucket_count = EXPR_INITIAL_BUCKETS;
+  return p;
+}
+
+void expr_destroy(ExprProgram *p) {
+  if (p == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < p->count; i++) {
+    bigint_destroy(p->nodes[i].literal);
+  }
+  for (size_t i = 0; i < p->var_count; i++) {
+    free(p->vars[i].name);
+  }
+  free(p->nodes);
+  free(p->buckets);
+  free(p->vars);
+  free(p->outputs);
+  free(p);
+}
+
+// Dobra um array dinâmico se estiver cheio. Retorna 0 se faltou memória
+static int grow(void **array, size_t *capacity, size_t count, size_t size) {
+  if (count < *capacity) {
+    return 1;
+  }
+  size_t cap = *capacity > 0 ? *capacity * 2 : 16;
+  void *bigger = realloc(*array, cap * size);
+  if (bigger == NULL) {
+    return 0;
+  }
+  *array = bigger;
+  *capacity = cap;
+  return 1;
+}
+
+static void rehash(ExprProgram *p) {
+  size_t count = p->bucket_count * 2;
+  size_t *buckets = malloc(count * sizeof(size_t));
+  if (buckets == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    buckets[i] = EXPR_NONE;
+  }
+  for (size_t i = 0; i < p->count; i++) {
+    size_t b = p->nodes[i].hash & (count - 1);
+    p->nodes[i].next = buckets[b];
+    buckets[b] = i;
+  }
+  free(p->buckets);
+  p->buckets = buckets;
+  p->bucket_count = count;
+}
+
+// Retorna o nó (op, a, b, c, literal), criando-o se ainda não existir
+// Assume a posse de literal. Retorna EXPR_NONE se algum filho for inválido
+// ou se faltou memória
+static size_t node_get(ExprProgram *p, ExprOp op, size_t a, size_t b,
+                       size_t c, BigInt *literal) {
+  size_t args[3] = {a, b, c};
+  int arity = op == EXPR_CONST                                 ? 0
+              : op == EXPR_NEG || op == EXPR_ABS || op == EXPR_FAT ||
+                      op == EXPR_FIB || op == EXPR_LUCAS
+                  ? 1
+              : op == EXPR_POWMOD || op == EXPR_MULMOD         ? 3
+                                                               : 2;
+  for (int i = 0; i < arity; i++) {
+    if (args[i] == EXPR_NONE) {
+      bigint_destroy(literal);
+      return EXPR_NONE;
+    }
+  }
+  if (op == EXPR_CONST && literal == NULL) {
+    return EXPR_NONE;
+  }
+
+  // Operações comutativas: a ordem dos operandos não muda o nó
+  if ((op == EXPR_ADD || op == EXPR_MUL || op == EXPR_GCD) &&
+      args[0] > args[1]) {
+    size_t t = args[0];
+    args[0] = args[1];
+    args[1] = t;
+  }
+
+  uint64_t h = mix64((uint64_t)op + 1);
+  for (int i = 0; i < 3; i++) {
+    h = mix64(h ^ (uint64_t)args[i]) + (uint64_t)i;
+  }
+  if (literal != NULL) {
+    h = mix64(h ^ bigint_hash(literal));
+  }
+
+  for (size_t i = p->buckets[h & (p->bucket_count - 1)]; i != EXPR_NONE;
+       i = p->nodes[i].next) {
+    ExprNode *n = &p->nodes[i];
+    if (n->hash == h && n->key_op == op && n->key_args[0] == args[0] &&
+        n->key_args[1] == args[1] && n->key_args[2] == args[2] &&
+        (op != EXPR_CONST || bigint_equal(n->literal, literal))) {
+      bigint_destroy(literal);
+      p->stats.shared++;
+      return i;
+    }
+  }
+
+  if (!grow((void **)&p->nodes, &p->capacity, p->count, sizeof(ExprNode))) {
+    bigint_destroy(literal);
+    return EXPR_NONE;
+  }
+  size_t id = p->count++;
+  ExprNode *n = &p->nodes[id];
+  n->op = n->key_op = op;
+  memcpy(n->args, args, sizeof(args));
+  memcpy(n->key_args, args, sizeof(args));
+  n->literal = literal;
+  n->hash = h;
+  size_t bucket = h & (p->bucket_count - 1);
+  n->next = p->buckets[bucket];
+  p->buckets[bucket] = id;
+  p->stats.nodes = p->count;
+  if (p->count > p->bucket_count) {
+    rehash(p);
+  }
+  return id;
+}
+
+static ExprVar *find_var(ExprProgram *p, const char *name, size_t len) {
+  for (size_t i = 0; i < p->var_count; i++) {
+    if (strlen(p->vars[i].name) == len &&
+        memcmp(p->vars[i].name, name, len) == 0) {
+      return &p->vars[i];
+    }
+  }
+  return NULL;
+}
+
+static int bind_var(ExprProgram *p, const char *name, size_t len,
+                    size_t node) {
+  ExprVar *v = find_var(p, name, len);
+  if (v != NULL) {
+    v->node = node;
+    return 1;
+  }
+  if (!grow((void **)&p->vars, &p->var_capacity, p->var_count,
+            sizeof(ExprVar))) {
+    return 0;
+  }
+  char *copy = malloc(len + 1);
+  if (copy == NULL) {
+    return 0;
+  }
+  memcpy(copy, name, len);
+  copy[len] = '\0';
+  p->vars[p->var_count].name = copy;
+  p->vars[p->var_count].node = node;
+  p->var_count++;
+  return 1;
+}
+
+int expr_define(ExprProgram *p, const char *name, const BigInt *value) {
+  if (p == NULL || name == NULL || value == NULL) {
+    return 0;
+  }
+  size_t node = node_get(p, EXPR_CONST, EXPR_NONE, EXPR_NONE, EXPR_NONE,
+                         bigint_copy(value));
+  return node != EXPR_NONE && bind_var(p, name, strlen(name), node);
+}
+
+// ---------------------------------------------------------------------------
+// Parser (descida recursiva)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  ExprProgram *p;
+  const char *s;
+  size_t len;
+  size_t pos;
+  int depth;
+  int failed;
+} Parser;
+
+static int is_ident_start(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int is_ident_char(char c) {
+  return is_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+// Pula espaços e comentários (sem passar da quebra de linha)
+static void skip_spaces(Parser *ps) {
+  while (ps->pos < ps->len) {
+    char c = ps->s[ps->pos];
+    if (c == ' ' || c == '\t' || c == '\r') {
+      ps->pos++;
+    } else if (c == '#') {
+      while (ps->pos < ps->len && ps->s[ps->pos] != '\n') {
+        ps->pos++;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+static char peek(Parser *ps) {
+  skip_spaces(ps);
+  return ps->pos < ps->len ? ps->s[ps->pos] : '\0';
+}
+
+static size_t fail(Parser *ps, const char *msg) {
+  if (!ps->failed) {
+    size_t line = 1, column = 1;
+    for (size_t i = 0; i < ps->pos && i < ps->len; i++) {
+      column++;
+      if (ps->s[i] == '\n') {
+        line++;
+        column = 1;
+      }
+    }
+    char buf[sizeof(ps->p->error)];
+    snprintf(buf, sizeof(buf), "linha %zu, coluna %zu: %s", line, column, msg);
+    set_error(ps->p, buf);
+    ps->failed = 1;
+  }
+  return EXPR_NONE;
+}
+
+// Lê um identificador na posição atual (depois de peek)
+static size_t read_ident(Parser *ps, const char **name) {
+  size_t start = ps->pos;
+  while (ps->pos < ps->len && is_ident_char(ps->s[ps->pos])) {
+    ps->pos++;
+  }
+  *name = ps->s + start;
+  return ps->pos - start;
+}
+
+// Verifica se a palavra-chave word vem a seguir (sem consumir)
+static int at_keyword(Parser *ps, const char *word) {
+  size_t n = strlen(word);
+  peek(ps);
+  return ps->pos + n <= ps->len && memcmp(ps->s + ps->pos, word, n) == 0 &&
+         (ps->pos + n == ps->len || !is_ident_char(ps->s[ps->pos + n]));
+}
+
+static size_t parse_expr(Parser *ps);
+static size_t parse_unary(Parser *ps);
+
+typedef struct {
+  const char *name;
+  ExprOp op;
+  int arity;
+} ExprFunction;
+
+static const ExprFunction expr_functions[] = {
+    {"gcd", EXPR_GCD, 2},       {"mdc", EXPR_GCD, 2},
+    {"pow", EXPR_POW, 2},       {"powmod", EXPR_POWMOD, 3},
+    {"mulmod", EXPR_MULMOD, 3}, {"binom", EXPR_BINOM, 2},
+    {"fat", EXPR_FAT, 1},       {"abs", EXPR_ABS, 1},
+    {"fib", EXPR_FIB, 1},       {"lucas", EXPR_LUCAS, 1},
+};
+
+static size_t parse_call(Parser *ps, const char *name, size_t len) {
+  const ExprFunction *fn = NULL;
+  for (size_t i = 0; i < sizeof(expr_functions) / sizeof(expr_functions[0]);
+       i++) {
+    if (strlen(expr_functions[i].name) == len &&
+        memcmp(expr_functions[i].name, name, len) == 0) {
+      fn = &expr_functions[i];
+    }
+  }
+  if (fn == NULL) {
+    return fail(ps, "funcao desconhecida");
+  }
+
+  ps->pos++; // '('
+  size_t args[3] = {EXPR_NONE, EXPR_NONE, EXPR_NONE};
+  for (int i = 0; i < fn->arity; i++) {
+    if (i > 0) {
+      if (peek(ps) != ',') {
+        return fail(ps, "esperado ','");
+      }
+      ps->pos++;
+    }
+    args[i] = parse_expr(ps);
+    if (ps->failed) {
+      return EXPR_NONE;
+    }
+  }
+  if (peek(ps) != ')') {
+    return fail(ps, "esperado ')' (quantidade de argumentos errada?)");
+  }
+  ps->pos++;
+  return node_get(ps->p, fn->op, args[0], args[1], args[2], NULL);
+}
+
+static size_t parse_primary(Parser *ps) {
+  char c = peek(ps);
+  if (c >= '0' && c <= '9') {
+    size_t start = ps->pos;
+    while (ps->pos < ps->len && ps->s[ps->pos] >= '0' &&
+           ps->s[ps->pos] <= '9') {
+      ps->pos++;
+    }
+    BigInt *literal = bigint_create_from_chars(ps->s + start, ps->pos - start);
+    if (literal == NULL) {
+      return fail(ps, "memoria insuficiente");
+    }
+    return node_get(ps->p, EXPR_CONST, EXPR_NONE, EXPR_NONE, EXPR_NONE,
+                    literal);
+  }
+  if (is_ident_start(c)) {
+    size_t start = ps->pos;
+    const char *name;
+    size_t len = read_ident(ps, &name);
+    if (peek(ps) == '(') {
+      return parse_call(ps, name, len);
+    }
+    ExprVar *v = find_var(ps->p, name, len);
+    if (v == NULL) {
+      ps->pos = start;
+      return fail(ps, "variavel indefinida");
+    }
+    return v->node;
+  }
+  if (c == '(') {
+    ps->pos++;
+    size_t node = parse_expr(ps);
+    if (ps->failed) {
+      return EXPR_NONE;
+    }
+    if (peek(ps) != ')') {
+      return fail(ps, "esperado ')'");
+    }
+    ps->pos++;
+    return node;
+  }
+  return fail(ps, c == '\0' ? "expressao incompleta" : "caractere inesperado");
+}
+
+// primário com '!' pós-fixo e '^' (associa à direita)
+static size_t parse_power(Parser *ps) {
+  size_t base = parse_primary(ps);
+  while (!ps->failed && peek(ps) == '!') {
+    ps->pos++;
+    base = node_get(ps->p, EXPR_FAT, base, EXPR_NONE, EXPR_NONE, NULL);
+  }
+  if (ps->failed || peek(ps) != '^') {
+    return base;
+  }
+  ps->pos++;
+  size_t exp = parse_unary(ps);
+  return ps->failed ? EXPR_NONE
+                    : node_get(ps->p, EXPR_POW, base, exp, EXPR_NONE, NULL);
+}
+
+static size_t parse_unary(Parser *ps) {
+  if (++ps->depth > EXPR_MAX_DEPTH) {
+    return fail(ps, "expressao muito aninhada");
+  }
+  size_t node;
+  char c = peek(ps);
+  if (c == '-' || c == '+') {
+    ps->pos++;
+    node = parse_unary(ps);
+    if (c == '-' && !ps->failed) {
+      node = node_get(ps->p, EXPR_NEG, node, EXPR_NONE, EXPR_NONE, NULL);
+    }
+  } else {
+    node = parse_power(ps);
+  }
+  ps->depth--;
+  return node;
+}
+
+static size_t parse_term(Parser *ps) {
+  size_t left = parse_unary(ps);
+  while (!ps->failed) {
+    char c = peek(ps);
+    ExprOp op;
+    if (c == '*') {
+      op = EXPR_MUL;
+      ps->pos++;
+    } else if (c == '/') {
+      op = EXPR_DIV;
+      ps->pos++;
+    } else if (c == '%') {
+      op = EXPR_MOD;
+      ps->pos++;
+    } else if (at_keyword(ps, "mod")) {
+      op = EXPR_MOD;
+      ps->pos += 3;
+    } else {
+      break;
+    }
+    size_t right = parse_unary(ps);
+    if (!ps->failed) {
+      left = node_get(ps->p, op, left, right, EXPR_NONE, NULL);
+    }
+  }
+  return ps->failed ? EXPR_NONE : left;
+}
+
+static size_t parse_expr(Parser *ps) {
+  if (++ps->depth > EXPR_MAX_DEPTH) {
+    return fail(ps, "expressao muito aninhada");
+  }
+  size_t left = parse_term(ps);
+  while (!ps->failed) {
+    char c = peek(ps);
+    if (c != '+' && c != '-') {
+      break;
+    }
+    ps->pos++;
+    size_t right = parse_term(ps);
+    if (!ps->failed) {
+      left = node_get(ps->p, c == '+' ? EXPR_ADD : EXPR_SUB, left, right,
+                      EXPR_NONE, NULL);
+    }
+  }
+  ps->depth--;
+  if (!ps->failed && left == EXPR_NONE) {
+    return fail(ps, "memoria insuficiente");
+  }
+  return ps->failed ? EXPR_NONE : left;
+}
+
+static int add_output(ExprProgram *p, size_t node) {
+  if (!grow((void **)&p->outputs, &p->output_capacity, p->output_count,
+            sizeof(size_t))) {
+    return 0;
+  }
+  p->outputs[p->output_count++] = node;
+  return 1;
+}
+
+// Compila um comando (atribuição ou expressão). Retorna 0 em erro
+static int parse_statement(Parser *ps) {
+  size_t start = ps->pos;
+  const char *name = NULL;
+  size_t name_len = 0;
+
+  // "nome = ..." (mas não "nome == ...")
+  if (is_ident_start(peek(ps))) {
+    name_len = read_ident(ps, &name);
+    if (!(peek(ps) == '=' &&
+          (ps->pos + 1 >= ps->len || ps->s[ps->pos + 1] != '='))) {
+      name = NULL;
+      ps->pos = start;
+    } else {
+      ps->pos++;
+    }
+  }
+
+  size_t node = parse_expr(ps);
+  char c = peek(ps);
+  if (!ps->failed && c != '\0' && c != ';' && c != '\n') {
+    fail(ps, "caractere inesperado");
+  }
+
+  if (name != NULL) {
+    if (!ps->failed && !bind_var(ps->p, name, name_len, node)) {
+      fail(ps, "memoria insuficiente");
+    }
+  } else if (!add_output(ps->p, ps->failed ? EXPR_NONE : node)) {
+    fail(ps, "memoria insuficiente");
+  }
+  return !ps->failed;
+}
+
+int expr_compile(ExprProgram *p, const char *src, size_t len) {
+  if (p == NULL || src == NULL) {
+    return 0;
+  }
+
+  Parser ps = {p, src, len, 0, 0, 0};
+  int ok = 1;
+  while (1) {
+    // Comandos vazios são ignorados
+    char c = peek(&ps);
+    while (c == ';' || c == '\n') {
+      ps.pos++;
+      c = peek(&ps);
+    }
+    if (c == '\0') {
+      break;
+    }
+
+    ps.failed = 0;
+    ps.depth = 0;
+    if (!parse_statement(&ps)) {
+      ok = 0;
+      // Continua no próximo comando
+      while (ps.pos < ps.len && ps.s[ps.pos] != ';' && ps.s[ps.pos] != '\n') {
+        ps.pos++;
+      }
+    }
+  }
+  return ok;
+}
+
+const char *expr_error(const ExprProgram *p) {
+  return p != NULL && p->error[0] != '\0' ? p->error : NULL;
+}
+
+size_t expr_outputs(const ExprProgram *p) {
+  return p != NULL ? p->output_count : 0;
+}
+
+void expr_stats(const ExprProgram *p, ExprStats *out) { *out = p->stats; }
+
+// ---------------------------------------------------------------------------
+// Avaliação
+// ---------------------------------------------------------------------------
+
+static int node_arity(const ExprNode *n) {
+  int arity = 0;
+  while (arity < 3 && n->args[arity] != EXPR_NONE) {
+    arity++;
+  }
+  return arity;
+}
+
+// Conta quantas vezes cada nó é usado pelos nós vivos e pelas saídas
+// Os filhos sempre têm índice menor que o pai, então basta uma passada de
+// trás para frente
+static void count_uses(const ExprProgram *p, size_t *uses) {
+  memset(uses, 0, p->count * sizeof(size_t));
+  for (size_t i = 0; i < p->output_count; i++) {
+    if (p->outputs[i] != EXPR_NONE) {
+      uses[p->outputs[i]]++;
+    }
+  }
+  for (size_t i = p->count; i-- > 0;) {
+    if (uses[i] == 0) {
+      continue;
+    }
+    const ExprNode *n = &p->nodes[i];
+    for (int k = 0; k < node_arity(n); k++) {
+      uses[n->args[k]]++;
+    }
+  }
+}
+
+// (a ^ e) mod m -> powmod(a, e, m) e (a * b) mod m -> mulmod(a, b, m),
+// quando a potência/o produto só é usado pelo módulo
+static void fuse(ExprProgram *p, const size_t *uses) {
+  for (size_t i = 0; i < p->count; i++) {
+    ExprNode *n = &p->nodes[i];
+    if (n->op != EXPR_MOD || uses[i] == 0) {
+      continue;
+    }
+    const ExprNode *inner = &p->nodes[n->args[0]];
+    if (uses[n->args[0]] != 1 ||
+        (inner->op != EXPR_POW && inner->op != EXPR_MUL)) {
+      continue;
+    }
+    n->op = inner->op == EXPR_POW ? EXPR_POWMOD : EXPR_MULMOD;
+    n->args[2] = n->args[1];
+    n->args[0] = inner->args[0];
+    n->args[1] = inner->args[1];
+    p->stats.fused++;
+  }
+}
+
+// Redução módulo m com buffers (e recíproco) reaproveitados em todos os
+// passos de uma exponenciação
+typedef struct {
+  const uint32_t *m;
+  size_t mn;
+  uint32_t *inv; // NULL abaixo de EXPR_PREINV_THRESHOLD
+  uint32_t *q;
+} Modulus;
+
+static int modulus_init(Modulus *md, const uint32_t *m, size_t mn) {
+  md->m = m;
+  md->mn = mn;
+  md->inv = NULL;
+  md->q = malloc((mn + 2) * sizeof(uint32_t));
+  if (md->q == NULL) {
+    return 0;
+  }
+  if (mn >= EXPR_PREINV_THRESHOLD) {
+    md->inv = malloc((mn + 2) * sizeof(uint32_t));
+    if (md->inv == NULL || !limbs_reciprocal(md->inv, m, mn)) {
+      free(md->inv);
+      free(md->q);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void modulus_free(Modulus *md) {
+  free(md->inv);
+  free(md->q);
+}
+
+// r (mn limbs) = x mod m, com x de até 2 * mn limbs
+static int modulus_reduce(Modulus *md, uint32_t *r, const uint32_t *x,
+                          size_t xn) {
+  xn = limbs_normalized_length(x, xn);
+  if (xn < md->mn) {
+    memcpy(r, x, xn * sizeof(uint32_t));
+    memset(r + xn, 0, (md->mn - xn) * sizeof(uint32_t));
+    return 1;
+  }
+  if (md->inv != NULL) {
+    return limbs_divmod_preinv(md->q, r, x, xn, md->m, md->mn, md->inv);
+  }
+  return limbs_divmod(md->q, r, x, xn, md->m, md->mn);
+}
+
+// prod = a * b (mn limbs cada, produto com 2 * mn limbs)
+static void mul_padded(uint32_t *prod, const uint32_t *a, const uint32_t *b,
+                       size_t mn) {
+  size_t an = limbs_normalized_length(a, mn);
+  size_t bn = limbs_normalized_length(b, mn);
+  memset(prod, 0, 2 * mn * sizeof(uint32_t));
+  if (an > 0 && bn > 0) {
+    limbs_mul(prod, a, an, b, bn);
+  }
+}
+
+// Exporta x mod m (em [0, |m|)) para um array de mn limbs
+static uint32_t *residue(const BigInt *x, const BigInt *m, size_t mn) {
+  BigInt *r = bigint_mod(x, m);
+  if (r == NULL) {
+    return NULL;
+  }
+  size_t rn = 0;
+  uint32_t *limbs = bigint_export_limbs(r, &rn);
+  bigint_destroy(r);
+  if (limbs == NULL) {
+    return NULL;
+  }
+  rn = limbs_normalized_length(limbs, rn);
+  uint32_t *out = calloc(mn, sizeof(uint32_t));
+  if (out != NULL) {
+    memcpy(out, limbs, (rn < mn ? rn : mn) * sizeof(uint32_t));
+  }
+  free(limbs);
+  return out;
+}
+
+// Exporta |m| normalizado. Retorna NULL se m for zero
+static uint32_t *modulus_limbs(const BigInt *m, size_t *mn) {
+  uint32_t *limbs = bigint_export_limbs(m, mn);
+  if (limbs == NULL) {
+    return NULL;
+  }
+  *mn = limbs_normalized_length(limbs, *mn);
+  if (*mn == 0) {
+    free(limbs);
+    return NULL;
+  }
+  return limbs;
+}
+
+static BigInt *eval_mulmod(const BigInt *a, const BigInt *b, const BigInt *m) {
+  size_t mn;
+  uint32_t *ml = modulus_limbs(m, &mn);
+  if (ml == NULL) {
+    return NULL;
+  }
+  uint32_t *ra = residue(a, m, mn);
+  uint32_t *rb = residue(b, m, mn);
+  uint32_t *prod = malloc(2 * mn * sizeof(uint32_t));
+  Modulus md;
+  BigInt *result = NULL;
+  if (ra != NULL && rb != NULL && prod != NULL && modulus_init(&md, ml, mn)) {
+    mul_padded(prod, ra, rb, mn);
+    if (modulus_reduce(&md, ra, prod, 2 * mn)) {
+      result = bigint_import_limbs(ra, mn, 1);
+    }
+    modulus_free(&md);
+  }
+  free(ml);
+  free(ra);
+  free(rb);
+  free(prod);
+  return result;
+}
+
+// a^e mod |m| por quadrados sucessivos, da esquerda para a direita
+static BigInt *eval_powmod(const BigInt *a, const BigInt *e, const BigInt *m) {
+  if (e->sign < 0 && !bigint_is_zero(e)) {
+    return NULL;
+  }
+  size_t mn, en;
+  uint32_t *ml = modulus_limbs(m, &mn);
+  if (ml == NULL) {
+    return NULL;
+  }
+  uint32_t *el = bigint_export_limbs(e, &en);
+  uint32_t *base = residue(a, m, mn);
+  uint32_t *r = calloc(mn, sizeof(uint32_t));
+  uint32_t *prod = calloc(2 * mn, sizeof(uint32_t));
+  Modulus md;
+  int ok = el != NULL && base != NULL && r != NULL && prod != NULL &&
+           modulus_init(&md, ml, mn);
+  BigInt *result = NULL;
+  if (ok) {
+    // r = 1 mod m (zero quando |m| = 1)
+    prod[0] = 1;
+    ok = modulus_reduce(&md, r, prod, 1);
+    en = limbs_normalized_length(el, en);
+    for (size_t i = en; ok && i-- > 0;) {
+      for (int bit = 31; ok && bit >= 0; bit--) {
+        mul_padded(prod, r, r, mn);
+        ok = modulus_reduce(&md, r, prod, 2 * mn);
+        if (ok && ((el[i] >> bit) & 1)) {
+          mul_padded(prod, r, base, mn);
+          ok = modulus_reduce(&md, r, prod, 2 * mn);
+        }
+      }
+    }
+    if (ok) {
+      result = bigint_import_limbs(r, mn, 1);
+    }
+    modulus_free(&md);
+  }
+  free(ml);
+  free(el);
+  free(base);
+  free(r);
+  free(prod);
+  return result;
+}
+
+static BigInt *eval_node(const ExprNode *n, BigInt **values) {
+  const BigInt *a = n->args[0] != EXPR_NONE ? values[n->args[0]] : NULL;
+  const BigInt *b = n->args[1] != EXPR_NONE ? values[n->args[1]] : NULL;
+  const BigInt *c = n->args[2] != EXPR_NONE ? values[n->args[2]] : NULL;
+  int arity = node_arity(n);
+  if ((arity > 0 && a == NULL) || (arity > 1 && b == NULL) ||
+      (arity > 2 && c == NULL)) {
+    return NULL; // Erro em um filho
+  }
+
+  switch (n->op) {
+  case EXPR_CONST: return bigint_copy(n->literal);
+  case EXPR_ADD: return bigint_sum(a, b);
+  case EXPR_SUB: return bigint_subtract(a, b);
+  case EXPR_MUL: return bigint_multiplicacao(a, b);
+  case EXPR_DIV: return bigint_divisao(a, b);
+  case EXPR_MOD: return bigint_mod(a, b);
+  case EXPR_NEG: return bigint_negate(a);
+  case EXPR_ABS: return bigint_abs(a);
+  case EXPR_POW: return bigint_pow(a, b);
+  case EXPR_GCD: {
+    BigInt *g = bigint_gcd((BigInt *)a, (BigInt *)b);
+    BigInt *abs_g = bigint_abs(g);
+    bigint_destroy(g);
+    return abs_g;
+  }
+  case EXPR_FAT: return bigint_factorial(a);
+  case EXPR_BINOM: return bigint_binomial(a, b);
+  case EXPR_FIB: return bigint_fib(a);
+  case EXPR_LUCAS: return bigint_lucas(a);
+  case EXPR_POWMOD: return eval_powmod(a, b, c);
+  case EXPR_MULMOD: return eval_mulmod(a, b, c);
+  }
+  return NULL;
+}
+
+int expr_evaluate(ExprProgram *p, BigInt **results) {
+  if (p == NULL || results == NULL) {
+    return 0;
+  }
+
+  size_t *uses = malloc((p->count > 0 ? p->count : 1) * sizeof(size_t));
+  BigInt **values = calloc(p->count > 0 ? p->count : 1, sizeof(BigInt *));
+  if (uses == NULL || values == NULL) {
+    free(uses);
+    free(values);
+    return 0;
+  }
+  count_uses(p, uses);
+  fuse(p, uses);
+  count_uses(p, uses);
+
+  // Os nós estão em ordem topológica (filhos antes dos pais)
+  for (size_t i = 0; i < p->count; i++) {
+    if (uses[i] == 0) {
+      continue;
+    }
+    const ExprNode *n = &p->nodes[i];
+    values[i] = eval_node(n, values);
+    if (values[i] == NULL) {
+      int child_failed = 0;
+      for (int k = 0; k < node_arity(n); k++) {
+        child_failed |= values[n->args[k]] == NULL;
+      }
+      if (!child_failed) {
+        set_error(p,
+                  "operacao invalida (divisao por zero, expoente negativo "
+                  "ou grande demais, ou argumento fora do dominio)");
+      }
+    }
+    // Libera os filhos que não serão mais usados
+    for (int k = 0; k < node_arity(n); k++) {
+      size_t child = n->args[k];
+      if (--uses[child] == 0) {
+        bigint_destroy(values[child]);
+        values[child] = NULL;
+      }
+    }
+  }
+
+  int ok = 1;
+  for (size_t i = 0; i < p->output_count; i++) {
+    size_t node = p->outputs[i];
+    results[i] = node != EXPR_NONE ? bigint_copy(values[node]) : NULL;
+    ok &= results[i] != NULL;
+  }
+  for (size_t i = 0; i < p->count; i++) {
+    bigint_destroy(values[i]);
+  }
+  free(uses);
+  free(values);
+  return ok;
+}
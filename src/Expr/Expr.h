@@ -0,0 +1,66 @@
+#ifndef EXPR_H
+#define EXPR_H
+
+#include "../BigInt/BigInt.h"
+#include <stddef.h>
+
+// Expressões aritméticas com variáveis, compiladas em um DAG de operações
+// Sintaxe (comandos separados por ';' ou quebra de linha, '#' comenta até o
+// fim da linha):
+//   nome = expressão      atribui (a variável passa a ser o nó da expressão)
+//   expressão             calcula e gera uma saída
+// Operadores, do menos para o mais prioritário: + -, * / % mod, - unário,
+// ^ (associa à direita) e ! (fatorial). Funções: gcd/mdc(a, b),
+// pow(a, e), powmod(a, e, m), mulmod(a, b, m), binom(n, k), fat(n), abs(x),
+// fib(n) e lucas(n)
+// / trunca para zero e % / mod dão o resto em [0, |m|), como no menu
+//
+// Otimizações do DAG:
+// - subexpressões comuns viram um único nó (hash-consing; +, * e gcd são
+//   normalizados como comutativos), inclusive entre comandos diferentes;
+// - (a ^ e) mod m e (a * b) mod m viram powmod/mulmod quando a potência ou
+//   o produto não é usado em outro lugar: a potência nunca é calculada por
+//   inteiro e a redução reaproveita os mesmos buffers (e, para módulos
+//   grandes, o mesmo recíproco) em todos os passos;
+// - cada valor intermediário é liberado assim que o último nó que o usa é
+//   calculado. Os intermediários ficam sempre em binário, nunca em decimal
+
+typedef struct ExprProgram ExprProgram;
+
+typedef struct {
+  size_t nodes;  // Nós distintos no DAG
+  size_t shared; // Subexpressões reaproveitadas (CSE)
+  size_t fused;  // Padrões powmod/mulmod fundidos
+} ExprStats;
+
+// Cria um programa vazio. Retorna NULL se faltou memória
+ExprProgram *expr_create(void);
+
+// Destrói o programa
+void expr_destroy(ExprProgram *p);
+
+// Define uma variável com um valor pronto. Retorna 1 em sucesso
+int expr_define(ExprProgram *p, const char *name, const BigInt *value);
+
+// Compila os comandos de src (len bytes) e acrescenta ao programa
+// Cada expressão sem atribuição gera uma saída, mesmo que tenha erro (a
+// saída fica com erro e a compilação continua no próximo comando)
+// Retorna 1 se tudo compilou ou 0 se houve erro (veja expr_error)
+int expr_compile(ExprProgram *p, const char *src, size_t len);
+
+// Mensagem do primeiro erro (de compilação ou de avaliação) ou NULL
+const char *expr_error(const ExprProgram *p);
+
+// Quantidade de saídas
+size_t expr_outputs(const ExprProgram *p);
+
+// Avalia o DAG e preenche results (expr_outputs entradas) com os valores
+// das saídas, na ordem. Saídas com erro (divisão por zero, expoente
+// negativo, erro de compilação...) ficam NULL
+// Retorna 1 se todas as saídas foram calculadas
+int expr_evaluate(ExprProgram *p, BigInt **results);
+
+// Copia as estatísticas do DAG para out
+void expr_stats(const ExprProgram *p, ExprStats *out);
+
+#endif // EXPR_H
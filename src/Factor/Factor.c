@@ -0,0 +1,706 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "Factor.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Limbs/Limbs.h"
+#include "../Montgomery/Montgomery.h"
+#include "../Prime/Prime.h"
+#include "../Roots/Roots.h"
+#include "../Scheduler/Scheduler.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Passos do rho entre dois mdc: os |x - y| do lote são multiplicados e o mdc
+// é tirado uma vez do produto
+#define FACTOR_RHO_BATCH 128
+
+// Passos de rho por tarefa antes de passar para a ECM (o rho acha um primo
+// p em ~sqrt(p) passos: com 2^20 passos, fatores de até ~12 dígitos)
+#define FACTOR_RHO_STEPS (1u << 20)
+
+// Primos testados no estágio 1 da ECM entre duas verificações de parada
+#define FACTOR_ECM_CHECK 64
+
+// Níveis da ECM: limite B1 do estágio 1 e curvas por nível (a tabela usual
+// para fatores de 15, 20, 25, 30 e 35 dígitos). O último nível se repete
+// até o tempo acabar
+static const struct {
+  uint32_t b1;
+  size_t curves;
+} ecm_levels[] = {
+    {2000, 25}, {11000, 90}, {50000, 300}, {250000, 700}, {1000000, 1800}};
+
+#define ECM_LEVELS (sizeof(ecm_levels) / sizeof(ecm_levels[0]))
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static size_t trailing_zeros(const uint32_t *a, size_t an) {
+  size_t bits = 0, i = 0;
+  while (i < an && a[i] == 0) {
+    bits += 32;
+    i++;
+  }
+  for (uint32_t low = i < an ? a[i] : 1; (low & 1) == 0; low >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// Desloca a para a direita em s bits (no próprio array)
+static void shift_right(uint32_t *a, size_t an, size_t s) {
+  size_t words = s / 32;
+  unsigned bits = (unsigned)(s % 32);
+  for (size_t i = 0; i < an; i++) {
+    uint64_t lo = i + words < an ? a[i + words] : 0;
+    uint64_t hi = i + words + 1 < an ? a[i + words + 1] : 0;
+    a[i] = (uint32_t)((lo | (hi << 32)) >> bits);
+  }
+}
+
+static uint32_t mod_word(const uint32_t *a, size_t an, uint32_t d) {
+  uint64_t r = 0;
+  for (size_t i = an; i-- > 0;) {
+    r = ((r << 32) | a[i]) % d;
+  }
+  return (uint32_t)r;
+}
+
+// mdc(a, n) binário para n ímpar (a e n com nn limbs), usando u e v (nn
+// limbs cada) como área. Retorna o buffer com o resultado e seu tamanho
+static const uint32_t *gcd_odd(const uint32_t *a, const uint32_t *n,
+                               size_t nn, uint32_t *u, uint32_t *v,
+                               size_t *gn) {
+  memcpy(u, a, nn * sizeof(uint32_t));
+  memcpy(v, n, nn * sizeof(uint32_t));
+  size_t un = limbs_normalized_length(u, nn), vn = nn;
+  while (un > 0) {
+    shift_right(u, un, trailing_zeros(u, un));
+    un = limbs_normalized_length(u, un);
+    if (limbs_cmp(u, un, v, vn) < 0) {
+      uint32_t *t = u;
+      u = v;
+      v = t;
+      size_t tn = un;
+      un = vn;
+      vn = tn;
+    }
+    limbs_sub(u, u, un, v, vn);
+    un = limbs_normalized_length(u, un);
+  }
+  *gn = vn;
+  return v;
+}
+
+// Divisão de n entre as tarefas de rho ou ECM: a primeira que acha um
+// divisor o guarda e para as outras
+typedef struct {
+  const uint32_t *n;
+  size_t nn;
+  double deadline;        // 0: sem limite
+  uint64_t first;         // Parâmetro (c do rho ou sigma da ECM) da tarefa 0
+  size_t tasks;           // Tarefas do lote (passo entre os c do rho)
+  const uint32_t *primes; // ECM: primos até B1
+  size_t prime_count;
+  uint32_t b1;
+  pthread_mutex_t lock;
+  uint32_t *factor; // Divisor encontrado (protegido por lock)
+  size_t factor_n;
+  int stop;   // Divisor encontrado ou tempo esgotado (acesso atômico)
+  int failed; // Faltou memória (acesso atômico)
+} SplitJob;
+
+static int stopped(SplitJob *job) {
+  if (__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) {
+    return 1;
+  }
+  if ((job->deadline > 0 && now_seconds() > job->deadline) ||
+      exec_checkpoint(NULL, 0, 0)) {
+    __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+    return 1;
+  }
+  return 0;
+}
+
+// Classifica g = mdc(x, n): 1 se for divisor não trivial (e o guarda), 0 se
+// for 1 e -1 se for o próprio n
+static int check_gcd(SplitJob *job, const uint32_t *g, size_t gn) {
+  if (gn == 1 && g[0] == 1) {
+    return 0;
+  }
+  if (limbs_cmp(g, gn, job->n, job->nn) == 0) {
+    return -1;
+  }
+  pthread_mutex_lock(&job->lock);
+  if (job->factor == NULL) {
+    job->factor = malloc(gn * sizeof(uint32_t));
+    if (job->factor != NULL) {
+      memcpy(job->factor, g, gn * sizeof(uint32_t));
+      job->factor_n = gn;
+    } else {
+      __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    }
+  }
+  pthread_mutex_unlock(&job->lock);
+  __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Pollard-Brent rho
+// ---------------------------------------------------------------------------
+
+// Uma caminhada com f(y) = y^2 + c (Brent: x fica parado enquanto y anda
+// r passos, com r dobrando a cada rodada). area tem 7·nn limbs e *budget
+// os passos restantes. Retorna 1 se achou um divisor, 0 se a caminhada
+// falhou ou parou e -1 se faltou memória
+static int rho_walk(SplitJob *job, MontgomeryContext *ctx, uint32_t c_word,
+                    uint64_t *budget, uint32_t *area) {
+  size_t nn = job->nn;
+  uint32_t *c = area, *x = c + nn, *y = x + nn, *ys = y + nn, *q = ys + nn;
+  uint32_t *u = q + nn, *v = u + nn;
+  if (!montgomery_to(ctx, c, &c_word, 1)) {
+    return -1;
+  }
+  montgomery_add(ctx, y, ctx->one, ctx->one); // y0 = 2
+  memcpy(q, ctx->one, nn * sizeof(uint32_t));
+
+  size_t gn;
+  const uint32_t *g;
+  int found = 0;
+  for (uint64_t r = 1; !found; r *= 2) {
+    memcpy(x, y, nn * sizeof(uint32_t));
+    for (uint64_t i = 0; i < r; i++) {
+      montgomery_mul(ctx, y, y, y);
+      montgomery_add(ctx, y, y, c);
+    }
+    for (uint64_t k = 0; k < r && !found; k += FACTOR_RHO_BATCH) {
+      memcpy(ys, y, nn * sizeof(uint32_t));
+      uint64_t m = r - k < FACTOR_RHO_BATCH ? r - k : FACTOR_RHO_BATCH;
+      for (uint64_t i = 0; i < m; i++) {
+        montgomery_mul(ctx, y, y, y);
+        montgomery_add(ctx, y, y, c);
+        montgomery_sub(ctx, u, x, y);
+        montgomery_mul(ctx, q, q, u);
+      }
+      g = gcd_odd(q, job->n, nn, u, v, &gn);
+      found = !(gn == 1 && g[0] == 1);
+      *budget = *budget > m ? *budget - m : 0;
+      if (!found && (*budget == 0 || stopped(job))) {
+        return 0;
+      }
+    }
+  }
+
+  if (limbs_cmp(g, gn, job->n, nn) == 0) {
+    // O lote juntou todos os fatores: refaz os passos um a um desde ys
+    do {
+      montgomery_mul(ctx, ys, ys, ys);
+      montgomery_add(ctx, ys, ys, c);
+      montgomery_sub(ctx, q, x, ys);
+      g = gcd_odd(q, job->n, nn, u, v, &gn);
+    } while (gn == 1 && g[0] == 1);
+  }
+  return check_gcd(job, g, gn) == 1;
+}
+
+static void rho_range(void *arg, size_t begin, size_t end) {
+  SplitJob *job = arg;
+  MontgomeryContext *ctx = montgomery_create(job->n, job->nn);
+  uint32_t *area = malloc(7 * job->nn * sizeof(uint32_t));
+  if (ctx == NULL || area == NULL) {
+    __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+  }
+  for (size_t i = begin; ctx != NULL && area != NULL && i < end; i++) {
+    // Cada tarefa tenta c = first + i, first + i + tasks, ... até gastar
+    // seus passos
+    uint64_t budget = FACTOR_RHO_STEPS;
+    for (uint64_t c = job->first + i; budget > 0 && !stopped(job);
+         c += job->tasks) {
+      int r = rho_walk(job, ctx, (uint32_t)c, &budget, area);
+      if (r == -1) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+      }
+      if (r != 0) {
+        break;
+      }
+    }
+  }
+  montgomery_destroy(ctx);
+  free(area);
+}
+
+// ---------------------------------------------------------------------------
+// ECM (estágio 1)
+// ---------------------------------------------------------------------------
+
+// Curva de Montgomery B·y^2 = x^3 + A·x^2 + x com (A + 2) / 4 = num / den,
+// em coordenadas (X : Z); t1..t3 são temporários
+typedef struct {
+  MontgomeryContext *ctx;
+  uint32_t *num, *den;
+  uint32_t *t1, *t2, *t3;
+} Curve;
+
+// (X2 : Z2) = 2·(X : Z). Com (A + 2) / 4 = num / den, as fórmulas usuais
+// X2 = (X + Z)^2 (X - Z)^2 e Z2 = 4XZ ((X - Z)^2 + (A + 2) / 4 · 4XZ)
+// são multiplicadas por den, sem inverso modular. X2/Z2 podem ser X/Z
+static void curve_double(Curve *cv, uint32_t *x2, uint32_t *z2,
+                         const uint32_t *x, const uint32_t *z) {
+  MontgomeryContext *ctx = cv->ctx;
+  montgomery_add(ctx, cv->t1, x, z);
+  montgomery_mul(ctx, cv->t1, cv->t1, cv->t1);
+  montgomery_sub(ctx, cv->t2, x, z);
+  montgomery_mul(ctx, cv->t2, cv->t2, cv->t2);
+  montgomery_sub(ctx, cv->t3, cv->t1, cv->t2); // 4XZ
+  montgomery_mul(ctx, x2, cv->t1, cv->t2);
+  montgomery_mul(ctx, x2, x2, cv->den);
+  montgomery_mul(ctx, z2, cv->t2, cv->den);
+  montgomery_mul(ctx, cv->t1, cv->t3, cv->num);
+  montgomery_add(ctx, z2, z2, cv->t1);
+  montgomery_mul(ctx, z2, z2, cv->t3);
+}
+
+// (Xr : Zr) = P + Q, sabendo P - Q = (Xd : Zd). Xr/Zr podem ser P ou Q
+static void curve_add(Curve *cv, uint32_t *xr, uint32_t *zr,
+                      const uint32_t *xp, const uint32_t *zp,
+                      const uint32_t *xq, const uint32_t *zq,
+                      const uint32_t *xd, const uint32_t *zd) {
+  MontgomeryContext *ctx = cv->ctx;
+  montgomery_sub(ctx, cv->t1, xp, zp);
+  montgomery_add(ctx, cv->t2, xq, zq);
+  montgomery_mul(ctx, cv->t1, cv->t1, cv->t2);
+  montgomery_add(ctx, cv->t2, xp, zp);
+  montgomery_sub(ctx, cv->t3, xq, zq);
+  montgomery_mul(ctx, cv->t2, cv->t2, cv->t3);
+  montgomery_add(ctx, cv->t3, cv->t1, cv->t2);
+  montgomery_mul(ctx, cv->t3, cv->t3, cv->t3);
+  montgomery_sub(ctx, cv->t1, cv->t1, cv->t2);
+  montgomery_mul(ctx, cv->t1, cv->t1, cv->t1);
+  montgomery_mul(ctx, xr, zd, cv->t3);
+  montgomery_mul(ctx, zr, xd, cv->t1);
+}
+
+// (X : Z) = k·(X : Z) pela escada de Montgomery; p e r1 são pontos
+// temporários (2·nn limbs cada)
+static void curve_multiply(Curve *cv, uint32_t *x, uint32_t *z, uint32_t k,
+                           uint32_t *p, uint32_t *r1) {
+  size_t nn = cv->ctx->n;
+  uint32_t *xp = p, *zp = p + nn, *x1 = r1, *z1 = r1 + nn;
+  memcpy(xp, x, nn * sizeof(uint32_t));
+  memcpy(zp, z, nn * sizeof(uint32_t));
+  curve_double(cv, x1, z1, x, z);
+  int top = 31;
+  while (!((k >> top) & 1)) {
+    top--;
+  }
+  for (int bit = top - 1; bit >= 0; bit--) {
+    if ((k >> bit) & 1) {
+      curve_add(cv, x, z, x1, z1, x, z, xp, zp);
+      curve_double(cv, x1, z1, x1, z1);
+    } else {
+      curve_add(cv, x1, z1, x, z, x1, z1, xp, zp);
+      curve_double(cv, x, z, x, z);
+    }
+  }
+}
+
+// Uma curva com o sigma dado (Suyama: u = sigma^2 - 5, v = 4·sigma,
+// ponto (u^3 : v^3) e (A + 2) / 4 = (v - u)^3 (3u + v) / (16 u^3 v))
+// area tem 15·nn limbs. Retorna 1 se achou um divisor, 0 se não e -1 se
+// faltou memória
+static int ecm_curve(SplitJob *job, MontgomeryContext *ctx, uint32_t sigma,
+                     uint32_t *area) {
+  size_t nn = job->nn;
+  uint32_t *x = area, *z = x + nn, *u = z + nn, *v = u + nn;
+  uint32_t *p = v + nn, *r1 = p + 2 * nn, *g1 = r1 + 2 * nn, *g2 = g1 + nn;
+  Curve cv = {ctx, g2 + nn, g2 + 2 * nn, g2 + 3 * nn, g2 + 4 * nn,
+              g2 + 5 * nn};
+  uint32_t five = 5;
+  if (!montgomery_to(ctx, u, &sigma, 1) || !montgomery_to(ctx, x, &five, 1)) {
+    return -1;
+  }
+  montgomery_add(ctx, v, u, u);
+  montgomery_add(ctx, v, v, v);
+  montgomery_mul(ctx, u, u, u);
+  montgomery_sub(ctx, u, u, x);
+
+  montgomery_mul(ctx, x, u, u);
+  montgomery_mul(ctx, x, x, u); // u^3
+  montgomery_mul(ctx, z, v, v);
+  montgomery_mul(ctx, z, z, v); // v^3
+  montgomery_sub(ctx, cv.t1, v, u);
+  montgomery_mul(ctx, cv.num, cv.t1, cv.t1);
+  montgomery_mul(ctx, cv.num, cv.num, cv.t1);
+  montgomery_add(ctx, cv.t2, u, u);
+  montgomery_add(ctx, cv.t2, cv.t2, u);
+  montgomery_add(ctx, cv.t2, cv.t2, v);
+  montgomery_mul(ctx, cv.num, cv.num, cv.t2);
+  montgomery_mul(ctx, cv.den, x, v);
+  for (int i = 0; i < 4; i++) {
+    montgomery_add(ctx, cv.den, cv.den, cv.den);
+  }
+
+  size_t gn;
+  const uint32_t *g = gcd_odd(cv.den, job->n, nn, g1, g2, &gn);
+  if (!(gn == 1 && g[0] == 1)) {
+    // Curva degenerada; o mdc pode até ser um divisor
+    return check_gcd(job, g, gn) == 1;
+  }
+
+  for (size_t i = 0; i < job->prime_count; i++) {
+    if (i % FACTOR_ECM_CHECK == 0 && stopped(job)) {
+      return 0;
+    }
+    uint32_t q = job->primes[i];
+    uint32_t pk = q;
+    while (pk <= job->b1 / q) {
+      pk *= q;
+    }
+    curve_multiply(&cv, x, z, pk, p, r1);
+  }
+  g = gcd_odd(z, job->n, nn, g1, g2, &gn);
+  return check_gcd(job, g, gn) == 1;
+}
+
+static void ecm_range(void *arg, size_t begin, size_t end) {
+  SplitJob *job = arg;
+  MontgomeryContext *ctx = montgomery_create(job->n, job->nn);
+  uint32_t *area = malloc(15 * job->nn * sizeof(uint32_t));
+  if (ctx == NULL || area == NULL) {
+    __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+  }
+  for (size_t i = begin;
+       ctx != NULL && area != NULL && i < end && !stopped(job); i++) {
+    if (ecm_curve(job, ctx, (uint32_t)(job->first + i), area) == -1) {
+      __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+      break;
+    }
+  }
+  montgomery_destroy(ctx);
+  free(area);
+}
+
+// Primos até limit (crivo de Eratóstenes)
+static uint32_t *sieve_primes(uint32_t limit, size_t *count) {
+  unsigned char *composite = calloc((size_t)limit + 1, 1);
+  uint32_t *primes = malloc(((size_t)limit / 2 + 2) * sizeof(uint32_t));
+  if (composite == NULL || primes == NULL) {
+    free(composite);
+    free(primes);
+    return NULL;
+  }
+  size_t k = 0;
+  for (uint32_t i = 2; i <= limit; i++) {
+    if (!composite[i]) {
+      primes[k++] = i;
+      for (uint64_t j = (uint64_t)i * i; j <= limit; j += i) {
+        composite[j] = 1;
+      }
+    }
+  }
+  free(composite);
+  *count = k;
+  return primes;
+}
+
+// Procura um divisor não trivial de n (ímpar, composto, sem fatores da
+// tabela e que não é potência perfeita): primeiro rho, depois ECM com B1
+// crescente. Retorna 1 (divisor em *d, com *dn limbs), 0 (tempo esgotado)
+// ou -1 (faltou memória)
+static int split(const uint32_t *n, size_t nn, double deadline, uint32_t **d,
+                 size_t *dn) {
+  SplitJob job;
+  memset(&job, 0, sizeof(job));
+  job.n = n;
+  job.nn = nn;
+  job.deadline = deadline;
+  pthread_mutex_init(&job.lock, NULL);
+
+  Scheduler *s = scheduler_current();
+  size_t walks = s != NULL ? scheduler_workers(s) : 1;
+  job.first = 1;
+  job.tasks = walks;
+  scheduler_parallel_for(walks, 1, rho_range, &job);
+
+  uint32_t sigma = 6;
+  for (size_t level = 0; !job.stop && !job.failed;) {
+    job.b1 = ecm_levels[level].b1;
+    job.primes = sieve_primes(job.b1, &job.prime_count);
+    if (job.primes == NULL) {
+      job.failed = 1;
+      break;
+    }
+    job.first = sigma;
+    job.tasks = ecm_levels[level].curves;
+    scheduler_parallel_for(job.tasks, 1, ecm_range, &job);
+    free((uint32_t *)job.primes);
+    sigma += (uint32_t)job.tasks;
+    if (level + 1 < ECM_LEVELS) {
+      level++;
+    }
+  }
+  pthread_mutex_destroy(&job.lock);
+
+  if (job.factor != NULL) {
+    *d = job.factor;
+    *dn = job.factor_n;
+    return 1;
+  }
+  return job.failed ? -1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Fatoração completa
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  BigInt *value;
+  size_t mult; // Multiplicidade
+} Pending;
+
+// Acrescenta mult cópias de x à fatoração (assume a posse de x)
+static int add_factor(Factorization *f, BigInt *x, size_t mult, int prime,
+                      size_t *capacity) {
+  if (f->count + mult > *capacity) {
+    size_t cap = (*capacity + mult) * 2;
+    BigInt **factors = realloc(f->factors, cap * sizeof(BigInt *));
+    if (factors != NULL) {
+      f->factors = factors;
+    }
+    int *flags = realloc(f->prime, cap * sizeof(int));
+    if (flags != NULL) {
+      f->prime = flags;
+    }
+    if (factors == NULL || flags == NULL) {
+      bigint_destroy(x);
+      return 0;
+    }
+    *capacity = cap;
+  }
+  for (size_t i = 0; i < mult; i++) {
+    f->factors[f->count] = i + 1 < mult ? bigint_copy(x) : x;
+    f->prime[f->count] = prime;
+    if (f->factors[f->count] == NULL) {
+      bigint_destroy(x);
+      return 0;
+    }
+    f->count++;
+  }
+  if (!prime) {
+    f->complete = 0;
+  }
+  return 1;
+}
+
+static int add_word(Factorization *f, uint32_t p, size_t mult,
+                    size_t *capacity) {
+  if (mult == 0) {
+    return 1;
+  }
+  BigInt *x = bigint_import_limbs(&p, 1, 1);
+  return x != NULL && add_factor(f, x, mult, 1, capacity);
+}
+
+// Separa um cofator composto: potência perfeita ou split. Empilha as partes
+// em pending. Retorna 1, 0 (tempo esgotado: x vai para a fatoração como
+// composto) ou -1 (faltou memória)
+static int process_composite(Factorization *f, Pending item, double deadline,
+                             Pending *pending, size_t *top,
+                             size_t *capacity) {
+  BigInt *root = NULL;
+  uint32_t k = 0;
+  if (bigint_is_perfect_power(item.value, &root, &k)) {
+    bigint_destroy(item.value);
+    pending[(*top)++] = (Pending){root, item.mult * k};
+    return 1;
+  }
+
+  size_t xn = 0;
+  uint32_t *xl = bigint_export_limbs(item.value, &xn);
+  if (xl == NULL) {
+    bigint_destroy(item.value);
+    return -1;
+  }
+  xn = limbs_normalized_length(xl, xn);
+  uint32_t *dl = NULL;
+  size_t dn = 0;
+  int r = split(xl, xn, deadline, &dl, &dn);
+  free(xl);
+  if (r == 0) {
+    return add_factor(f, item.value, item.mult, 0, capacity) ? 0 : -1;
+  }
+  if (r == -1) {
+    bigint_destroy(item.value);
+    return -1;
+  }
+  BigInt *d = bigint_import_limbs(dl, dn, 1);
+  free(dl);
+  BigInt *q = d != NULL ? bigint_divisao(item.value, d) : NULL;
+  bigint_destroy(item.value);
+  if (q == NULL) {
+    bigint_destroy(d);
+    return -1;
+  }
+  pending[(*top)++] = (Pending){d, item.mult};
+  pending[(*top)++] = (Pending){q, item.mult};
+  return 1;
+}
+
+static void sort_factors(Factorization *f) {
+  for (size_t i = 1; i < f->count; i++) {
+    BigInt *x = f->factors[i];
+    int prime = f->prime[i];
+    size_t j = i;
+    while (j > 0 && bigint_compare(f->factors[j - 1], x) > 0) {
+      f->factors[j] = f->factors[j - 1];
+      f->prime[j] = f->prime[j - 1];
+      j--;
+    }
+    f->factors[j] = x;
+    f->prime[j] = prime;
+  }
+}
+
+Factorization *bigint_factor(const BigInt *n, double seconds) {
+  size_t table_count;
+  const uint32_t *table = prime_table(&table_count);
+  if (n == NULL || bigint_is_zero(n) || table == NULL) {
+    return NULL;
+  }
+  double deadline = seconds > 0 ? now_seconds() + seconds : 0;
+  Factorization *f = calloc(1, sizeof(Factorization));
+  size_t nn = 0;
+  uint32_t *m = bigint_export_limbs(n, &nn);
+  if (f == NULL || m == NULL) {
+    free(f);
+    free(m);
+    return NULL;
+  }
+  f->sign = n->sign < 0 ? -1 : 1;
+  f->complete = 1;
+  nn = limbs_normalized_length(m, nn);
+  size_t capacity = 0;
+
+  // Divisão por tentativa: 2 e a tabela
+  size_t twos = trailing_zeros(m, nn);
+  shift_right(m, nn, twos);
+  nn = limbs_normalized_length(m, nn);
+  int ok = add_word(f, 2, twos, &capacity);
+  for (size_t i = 0; ok && i < table_count; i++) {
+    uint32_t p = table[i];
+    if (nn == 1 && (uint64_t)p * p > m[0]) {
+      break;
+    }
+    size_t mult = 0;
+    while (mod_word(m, nn, p) == 0) {
+      limbs_divmod_1(m, m, nn, p);
+      nn = limbs_normalized_length(m, nn);
+      mult++;
+    }
+    ok = add_word(f, p, mult, &capacity);
+  }
+
+  // O que sobrou é 1, primo (sem divisores até a raiz) ou vai para a pilha
+  // de cofatores; cada split acrescenta no máximo um item
+  Pending *pending = NULL;
+  size_t top = 0;
+  if (ok && !(nn == 1 && m[0] == 1)) {
+    BigInt *rest = bigint_import_limbs(m, nn, 1);
+    pending = malloc((8 * nn * 32 + 2) * sizeof(Pending));
+    ok = rest != NULL && pending != NULL;
+    if (ok) {
+      pending[top++] = (Pending){rest, 1};
+    } else {
+      bigint_destroy(rest);
+    }
+  }
+  free(m);
+
+  while (ok && top > 0) {
+    Pending item = pending[--top];
+    if (bigint_is_probable_prime(item.value, PRIME_DEFAULT_ROUNDS)) {
+      ok = add_factor(f, item.value, item.mult, 1, &capacity);
+    } else {
+      ok = process_composite(f, item, deadline, pending, &top, &capacity) !=
+           -1;
+    }
+  }
+  for (size_t i = 0; i < top; i++) {
+    bigint_destroy(pending[i].value);
+  }
+  free(pending);
+
+  if (!ok) {
+    factorization_destroy(f);
+    return NULL;
+  }
+  sort_factors(f);
+  return f;
+}
+
+// Acrescenta s ao buffer, que cresce sob demanda
+static int append(char **buf, size_t *len, size_t *cap, const char *s) {
+  size_t sl = strlen(s);
+  if (*len + sl + 1 > *cap) {
+    size_t ncap = (*len + sl + 1) * 2;
+    char *bigger = realloc(*buf, ncap);
+    if (bigger == NULL) {
+      return 0;
+    }
+    *buf = bigger;
+    *cap = ncap;
+  }
+  memcpy(*buf + *len, s, sl + 1);
+  *len += sl;
+  return 1;
+}
+
+char *factorization_to_string(const Factorization *f) {
+  char *buf = NULL;
+  size_t len = 0, cap = 0;
+  int ok = append(&buf, &len, &cap, f->sign < 0 ? "-1" : "");
+  if (ok && f->count == 0) {
+    ok = append(&buf, &len, &cap, f->sign < 0 ? "" : "1");
+  }
+  for (size_t i = 0; ok && i < f->count;) {
+    size_t j = i + 1;
+    while (j < f->count && bigint_compare(f->factors[j], f->factors[i]) == 0) {
+      j++;
+    }
+    char *digits = bigint_to_string(f->factors[i]);
+    char exponent[32] = "";
+    if (j - i > 1) {
+      snprintf(exponent, sizeof(exponent), "^%zu", j - i);
+    }
+    ok = digits != NULL && append(&buf, &len, &cap, len > 0 ? " * " : "") &&
+         append(&buf, &len, &cap, digits) &&
+         append(&buf, &len, &cap, exponent) &&
+         append(&buf, &len, &cap, f->prime[i] ? "" : " (composto)");
+    free(digits);
+    i = j;
+  }
+  if (!ok) {
+    free(buf);
+    return NULL;
+  }
+  return buf;
+}
+
+void factorization_destroy(Factorization *f) {
+  if (f == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < f->count; i++) {
+    bigint_destroy(f->factors[i]);
+  }
+  free(f->factors);
+  free(f->prime);
+  free(f);
+}
@@ -0,0 +1,40 @@
+#ifndef FACTOR_H
+#define FACTOR_H
+
+#include "../BigInt/BigInt.h"
+
+// Fatoração de inteiros de tamanho médio (até ~70 dígitos)
+// Etapas, do mais barato para o mais caro:
+//   1. divisão pelos primos abaixo de 65536 (tabela de src/Prime);
+//   2. para cada cofator composto: potência perfeita (src/Roots) e
+//      Pollard-Brent rho, com uma caminhada independente (constante c
+//      diferente) por worker do Scheduler;
+//   3. ECM (curvas de Montgomery, parametrização de Suyama, só o
+//      estágio 1), com uma curva por tarefa e limites B1 crescentes.
+// Cada caminhada ou curva tem seu próprio contexto de Montgomery: os passos
+// só usam os buffers do contexto, sem alocar BigInt. A primeira tarefa que
+// acha um divisor encerra as outras
+
+typedef struct {
+  int sign;         // -1 se n < 0 (o -1 não entra na lista)
+  BigInt **factors; // Fatores em ordem crescente, com repetição
+  int *prime;       // prime[i] = 0 se factors[i] ficou composto
+  size_t count;
+  int complete;     // 1 se todos os fatores são primos (prováveis)
+} Factorization;
+
+// Fatora n com um tempo limite em segundos (<= 0: sem limite). Quando o
+// tempo acaba (ou o ExecContext da thread pede para parar), os cofatores
+// ainda compostos ficam na lista com prime[i] = 0
+// Dentro de um worker do Scheduler as caminhadas e curvas rodam em paralelo
+// Retorna NULL se n for zero ou se faltou memória
+Factorization *bigint_factor(const BigInt *n, double seconds);
+
+// Texto da fatoração, ex.: "-1 * 2^3 * 3 * 1000000007"; fatores compostos
+// aparecem como "N (composto)" e n = 1 vira "1"
+// Retorna NULL se faltou memória (quem chamar deve liberar)
+char *factorization_to_string(const Factorization *f);
+
+void factorization_destroy(Factorization *f);
+
+#endif // FACTOR_H
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "InputFile.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INPUTFILE_READ_CHUNK 65536
+
+static int is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+// Lê o descritor inteiro para um buffer que cresce sob demanda
+static int read_all(int fd, InputFile *in) {
+  size_t capacity = INPUTFILE_READ_CHUNK;
+  size_t len = 0;
+  char *buffer = malloc(capacity);
+  if (buffer == NULL) {
+    return 0;
+  }
+
+  while (1) {
+    if (len == capacity) {
+      char *maior = realloc(buffer, capacity * 2);
+      if (maior == NULL) {
+        free(buffer);
+        return 0;
+      }
+      buffer = maior;
+      capacity *= 2;
+    }
+    ssize_t got = read(fd, buffer + len, capacity - len);
+    if (got < 0) {
+      free(buffer);
+      return 0;
+    }
+    if (got == 0) {
+      break;
+    }
+    len += (size_t)got;
+  }
+
+  in->owned = buffer;
+  in->data = buffer;
+  in->size = len;
+  return 1;
+}
+
+// Abre o arquivo. Retorna 1 em sucesso, 0 em erro
+int inputfile_open(const char *path, InputFile *in) {
+  if (path == NULL || in == NULL) {
+    return 0;
+  }
+  memset(in, 0, sizeof(*in));
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    if (st.st_size == 0) {
+      // mmap não aceita tamanho zero; arquivo vazio é um span vazio
+      close(fd);
+      in->data = "";
+      return 1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+      close(fd);
+      in->map = map;
+      in->map_size = size;
+      in->data = map;
+      in->size = size;
+      return 1;
+    }
+  }
+
+  int ok = read_all(fd, in);
+  close(fd);
+  return ok;
+}
+
+// Libera o mapeamento ou o buffer do arquivo
+void inputfile_close(InputFile *in) {
+  if (in == NULL) {
+    return;
+  }
+  if (in->map != NULL) {
+    munmap(in->map, in->map_size);
+  }
+  free(in->owned);
+  memset(in, 0, sizeof(*in));
+}
+
+// Procura o próximo token (sequência sem espaços) em data[*pos, end)
+int inputfile_next_token(const char *data, size_t end, size_t *pos,
+                         const char **token, size_t *len) {
+  size_t i = *pos;
+  while (i < end && is_space(data[i])) {
+    i++;
+  }
+  if (i >= end) {
+    *pos = end;
+    return 0;
+  }
+
+  size_t start = i;
+  while (i < end && !is_space(data[i])) {
+    i++;
+  }
+
+  *token = data + start;
+  *len = i - start;
+  *pos = i;
+  return 1;
+}
@@ -0,0 +1,28 @@
+#ifndef INPUTFILE_H
+#define INPUTFILE_H
+
+#include <stddef.h>
+
+// Arquivo de entrada inteiro visível como um único span de bytes
+// Arquivos regulares são mapeados com mmap (sem cópia); outros (pipes,
+// dispositivos) são lidos para um buffer que cresce sob demanda
+typedef struct {
+  const char *data; // Conteúdo do arquivo (não é terminado em '\0')
+  size_t size;      // Tamanho do conteúdo em bytes
+  void *map;        // Mapeamento mmap (uso interno)
+  size_t map_size;  // Tamanho do mapeamento (uso interno)
+  char *owned;      // Buffer alocado quando não foi possível mapear
+} InputFile;
+
+// Abre o arquivo. Retorna 1 em sucesso, 0 em erro
+int inputfile_open(const char *path, InputFile *in);
+
+// Libera o mapeamento ou o buffer do arquivo
+void inputfile_close(InputFile *in);
+
+// Procura o próximo token (sequência sem espaços) em data[*pos, end)
+// Retorna 1 e preenche *token/*len se encontrou; avança *pos após o token
+int inputfile_next_token(const char *data, size_t end, size_t *pos,
+                         const char **token, size_t *len);
+
+#endif // INPUTFILE_H
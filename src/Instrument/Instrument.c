@@ -0,0 +1,220 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "Instrument.h"
+
+#ifdef PE_INSTRUMENT
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Faixas de tamanho: [2^k, 2^(k+1)) limbs
+#define INSTR_SIZE_BUCKETS 40
+
+// Faixas de latência: [2^k, 2^(k+1)) ns (até ~39 horas)
+#define INSTR_LATENCY_BUCKETS 48
+
+typedef struct {
+  uint64_t calls;
+  uint64_t total_ns;
+  uint64_t max_ns;
+  uint64_t limbs; // Soma dos limbs dos operandos
+  uint64_t latency[INSTR_LATENCY_BUCKETS];
+} SizeStats;
+
+static const char *instr_op_names[INSTR_OPS] = {
+    "parse", "to_string", "sum", "subtract", "multiply", "divide", "mod",
+    "gcd"};
+
+static const char *instr_counter_names[INSTR_COUNTERS] = {
+    "node_visits", "appends", "prepends", "copies", "detaches",
+    "nodes_copied"};
+
+static SizeStats op_stats[INSTR_OPS][INSTR_SIZE_BUCKETS];
+static uint64_t counters[INSTR_COUNTERS];
+static uint64_t allocs, frees, live_bytes, peak_bytes;
+static uint64_t started_ns;
+
+// Serializa os dumps (SIGUSR1 e saída do programa)
+static pthread_mutex_t dump_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void add(uint64_t *counter, uint64_t n) {
+  __atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+}
+
+static uint64_t load(const uint64_t *counter) {
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+static void store_max(uint64_t *counter, uint64_t value) {
+  uint64_t current = load(counter);
+  while (value > current &&
+         !__atomic_compare_exchange_n(counter, &current, value, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+// Índice da potência de 2 que contém x (0 para x <= 1)
+static int log2_bucket(uint64_t x, int buckets) {
+  int k = 0;
+  while (x > 1 && k < buckets - 1) {
+    x >>= 1;
+    k++;
+  }
+  return k;
+}
+
+uint64_t instrument_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void instrument_op(InstrOp op, size_t a_limbs, size_t b_limbs,
+                   uint64_t start) {
+  uint64_t ns = instrument_now() - start;
+  size_t largest = a_limbs > b_limbs ? a_limbs : b_limbs;
+  SizeStats *s = &op_stats[op][log2_bucket(largest, INSTR_SIZE_BUCKETS)];
+  add(&s->calls, 1);
+  add(&s->total_ns, ns);
+  add(&s->limbs, (uint64_t)a_limbs + b_limbs);
+  add(&s->latency[log2_bucket(ns, INSTR_LATENCY_BUCKETS)], 1);
+  store_max(&s->max_ns, ns);
+}
+
+void instrument_count(InstrCounter c, uint64_t n) { add(&counters[c], n); }
+
+void instrument_alloc(size_t count, size_t bytes) {
+  add(&allocs, count);
+  uint64_t live =
+      __atomic_add_fetch(&live_bytes, (uint64_t)bytes, __ATOMIC_RELAXED);
+  store_max(&peak_bytes, live);
+}
+
+void instrument_free(size_t count, size_t bytes) {
+  add(&frees, count);
+  __atomic_fetch_sub(&live_bytes, (uint64_t)bytes, __ATOMIC_RELAXED);
+}
+
+static void write_json(FILE *f) {
+  fprintf(f, "{\n  \"elapsed_ns\": %llu,\n  \"ops\": [",
+          (unsigned long long)(instrument_now() - started_ns));
+  int first_op = 1;
+  for (int op = 0; op < INSTR_OPS; op++) {
+    uint64_t calls = 0, total_ns = 0, limbs = 0;
+    for (int b = 0; b < INSTR_SIZE_BUCKETS; b++) {
+      calls += load(&op_stats[op][b].calls);
+      total_ns += load(&op_stats[op][b].total_ns);
+      limbs += load(&op_stats[op][b].limbs);
+    }
+    if (calls == 0) {
+      continue;
+    }
+    fprintf(f,
+            "%s\n    {\"op\": \"%s\", \"calls\": %llu, \"total_ns\": %llu, "
+            "\"limbs\": %llu, \"sizes\": [",
+            first_op ? "" : ",", instr_op_names[op],
+            (unsigned long long)calls, (unsigned long long)total_ns,
+            (unsigned long long)limbs);
+    first_op = 0;
+
+    int first_size = 1;
+    for (int b = 0; b < INSTR_SIZE_BUCKETS; b++) {
+      const SizeStats *s = &op_stats[op][b];
+      if (load(&s->calls) == 0) {
+        continue;
+      }
+      fprintf(f,
+              "%s\n      {\"limbs_min\": %llu, \"limbs_max\": %llu, "
+              "\"calls\": %llu, \"total_ns\": %llu, \"max_ns\": %llu, "
+              "\"limbs\": %llu, \"latency_ns\": [",
+              first_size ? "" : ",", b == 0 ? 0ULL : 1ULL << b,
+              (2ULL << b) - 1, (unsigned long long)load(&s->calls),
+              (unsigned long long)load(&s->total_ns),
+              (unsigned long long)load(&s->max_ns),
+              (unsigned long long)load(&s->limbs));
+      first_size = 0;
+      int first_latency = 1;
+      for (int l = 0; l < INSTR_LATENCY_BUCKETS; l++) {
+        uint64_t count = load(&s->latency[l]);
+        if (count == 0) {
+          continue;
+        }
+        fprintf(f, "%s{\"min\": %llu, \"count\": %llu}",
+                first_latency ? "" : ", ", l == 0 ? 0ULL : 1ULL << l,
+                (unsigned long long)count);
+        first_latency = 0;
+      }
+      fprintf(f, "]}");
+    }
+    fprintf(f, "\n    ]}");
+  }
+
+  fprintf(f, "\n  ],\n  \"linkedlist\": {");
+  for (int c = 0; c < INSTR_COUNTERS; c++) {
+    fprintf(f, "%s\"%s\": %llu", c == 0 ? "" : ", ", instr_counter_names[c],
+            (unsigned long long)load(&counters[c]));
+  }
+  fprintf(f,
+          "},\n  \"memory\": {\"allocs\": %llu, \"frees\": %llu, "
+          "\"live_bytes\": %llu, \"peak_live_bytes\": %llu}\n}\n",
+          (unsigned long long)load(&allocs), (unsigned long long)load(&frees),
+          (unsigned long long)load(&live_bytes),
+          (unsigned long long)load(&peak_bytes));
+}
+
+int instrument_dump(void) {
+  pthread_mutex_lock(&dump_lock);
+  const char *path = getenv("PE_INSTRUMENT_FILE");
+  int ok = 1;
+  if (path != NULL && *path != '\0') {
+    // Cada dump substitui o anterior
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+      perror("Erro ao gravar a instrumentacao");
+      ok = 0;
+    } else {
+      write_json(f);
+      ok = fclose(f) == 0;
+    }
+  } else {
+    write_json(stderr);
+    fflush(stderr);
+  }
+  pthread_mutex_unlock(&dump_lock);
+  return ok;
+}
+
+static void dump_at_exit(void) { instrument_dump(); }
+
+// Atende SIGUSR1 fora do handler de sinal (o dump usa stdio e mutex)
+static void *signal_thread(void *arg) {
+  sigset_t *set = arg;
+  int sig;
+  for (;;) {
+    if (sigwait(set, &sig) == 0) {
+      instrument_dump();
+    }
+  }
+  return NULL;
+}
+
+void instrument_init(void) {
+  static sigset_t set;
+  started_ns = instrument_now();
+  atexit(dump_at_exit);
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGUSR1);
+  pthread_sigmask(SIG_BLOCK, &set, NULL);
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, signal_thread, &set) == 0) {
+    pthread_detach(thread);
+  } else {
+    fprintf(stderr, "Aviso: SIGUSR1 nao vai gerar dump da instrumentacao\n");
+  }
+}
+
+#endif // PE_INSTRUMENT
@@ -0,0 +1,85 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Instrumentação dos caminhos quentes (make INSTRUMENT=1, que define
+// PE_INSTRUMENT)
+// BigInt.c e LinkedList.c contam chamadas de cada operação com um
+// histograma de latência por faixa de tamanho do maior operando (potências
+// de 2 em limbs), os limbs processados, as visitas a nós da lista e as
+// alocações da representação (BigInt, listas e nós), com o pico de bytes
+// vivos. Os contadores são atômicos e podem ser atualizados de qualquer
+// thread. O JSON é gravado na saída do programa e a cada SIGUSR1, em
+// stderr ou no arquivo de PE_INSTRUMENT_FILE
+//
+// Sem PE_INSTRUMENT as macros abaixo não geram código e Instrument.c fica
+// vazio
+
+typedef enum {
+  INSTR_PARSE,
+  INSTR_TO_STRING,
+  INSTR_SUM,
+  INSTR_SUBTRACT,
+  INSTR_MULTIPLY,
+  INSTR_DIVIDE,
+  INSTR_MOD,
+  INSTR_GCD,
+  INSTR_OPS
+} InstrOp;
+
+// Eventos da lista encadeada
+typedef enum {
+  INSTR_NODE_VISITS,  // Nós percorridos por linkedlist_get/set
+  INSTR_APPENDS,
+  INSTR_PREPENDS,
+  INSTR_COPIES,       // Cópias O(1) (compartilham os nós)
+  INSTR_DETACHES,     // Cópias reais dos nós antes de modificar
+  INSTR_NODES_COPIED, // Nós copiados por essas cópias reais
+  INSTR_COUNTERS
+} InstrCounter;
+
+#ifdef PE_INSTRUMENT
+
+// Registra o dump na saída (atexit) e a thread que atende SIGUSR1
+// Deve ser chamada no início do main, antes de criar outras threads (elas
+// herdam o SIGUSR1 bloqueado)
+void instrument_init(void);
+
+// Relógio monotônico em nanossegundos
+uint64_t instrument_now(void);
+
+// Fim de uma operação iniciada em start, com operandos de a e b limbs
+void instrument_op(InstrOp op, size_t a_limbs, size_t b_limbs,
+                   uint64_t start);
+
+void instrument_count(InstrCounter c, uint64_t n);
+
+// count blocos somando bytes foram alocados / liberados
+void instrument_alloc(size_t count, size_t bytes);
+void instrument_free(size_t count, size_t bytes);
+
+// Grava o JSON com os contadores atuais. Retorna 0 em erro de escrita
+int instrument_dump(void);
+
+#define INSTR_INIT() instrument_init()
+#define INSTR_BEGIN(var) uint64_t var = instrument_now()
+#define INSTR_END(op, a_limbs, b_limbs, var)                                 \
+  instrument_op(op, a_limbs, b_limbs, var)
+#define INSTR_COUNT(c, n) instrument_count(c, n)
+#define INSTR_ALLOC(count, bytes) instrument_alloc(count, bytes)
+#define INSTR_FREE(count, bytes) instrument_free(count, bytes)
+
+#else
+
+#define INSTR_INIT() ((void)0)
+#define INSTR_BEGIN(var) ((void)0)
+#define INSTR_END(op, a_limbs, b_limbs, var) ((void)0)
+#define INSTR_COUNT(c, n) ((void)0)
+#define INSTR_ALLOC(count, bytes) ((void)0)
+#define INSTR_FREE(count, bytes) ((void)0)
+
+#endif // PE_INSTRUMENT
+
+#endif // INSTRUMENT_H
@@ -0,0 +1,843 @@
+#include "Limbs.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Tuning/Tuning.h"
+#include <stdlib.h>
+#include <string.h>
+
+__extension__ typedef unsigned __int128 limb_u128;
+
+// Abaixo deste tamanho (limbs do menor operando) usa a multiplicação escolar
+// (ajustável por máquina: make tune ou PE_KARATSUBA_THRESHOLD)
+#define LIMBS_KARATSUBA_THRESHOLD tuning_get(TUNE_KARATSUBA)
+
+// A partir deste tamanho (limbs do menor operando) usa a NTT
+// (make tune ou PE_NTT_THRESHOLD)
+#define LIMBS_NTT_THRESHOLD tuning_get(TUNE_NTT)
+
+// Produto mínimo (an * bn, em limbs) para dividir a escolar em tarefas
+#define LIMBS_PARALLEL_MUL_MIN (1u << 20)
+
+// Menor bloco de linhas entregue a uma tarefa na escolar paralela
+#define LIMBS_PARALLEL_BLOCK_MIN 256
+
+// Menor tamanho (limbs) em que os subprodutos de Karatsuba viram tarefas
+#define LIMBS_PARALLEL_KARATSUBA_MIN 1024
+
+// Menor transformada (pontos) em que as borboletas da NTT são paralelizadas
+#define LIMBS_PARALLEL_NTT_MIN (1u << 15)
+
+// Menor quantidade de itens por tarefa em laços paralelos
+#define LIMBS_PARALLEL_GRAIN 4096
+
+// Trabalho (em produtos de limbs) entre dois pontos de verificação do
+// ExecContext na divisão de Knuth
+#define LIMBS_CHECKPOINT_WORK (1u << 20)
+
+// ---------------------------------------------------------------------------
+// Soma e subtração
+// ---------------------------------------------------------------------------
+
+// Soma src (len limbs) em out a partir de offset, propagando o carry
+static void add_at(uint32_t *out, size_t out_len, const uint32_t *src,
+                   size_t len, size_t offset) {
+  uint64_t carry = 0;
+  size_t i = 0;
+
+  for (; i < len; i++) {
+    uint64_t cur = (uint64_t)out[offset + i] + src[i] + carry;
+    out[offset + i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  for (size_t k = offset + i; carry > 0 && k < out_len; k++) {
+    uint64_t cur = (uint64_t)out[k] + carry;
+    out[k] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+}
+
+// out = a + b (an >= bn); out deve ter an + 1 limbs
+static void add_limbs(uint32_t *out, const uint32_t *a, size_t an,
+                      const uint32_t *b, size_t bn) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < an; i++) {
+    uint64_t cur = (uint64_t)a[i] + (i < bn ? b[i] : 0) + carry;
+    out[i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  out[an] = (uint32_t)carry;
+}
+
+// a -= b (a >= b, an >= bn)
+static void sub_in_place(uint32_t *a, size_t an, const uint32_t *b,
+                         size_t bn) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < an && (i < bn || borrow); i++) {
+    uint64_t sub = (i < bn ? b[i] : 0) + borrow;
+    uint64_t av = a[i];
+    borrow = av < sub;
+    a[i] = (uint32_t)((av - sub) & UINT32_MAX);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Multiplicação escolar
+// ---------------------------------------------------------------------------
+
+// Multiplicação escolar: out deve ter an + bn limbs e não pode ser a nem b
+void limbs_mul_schoolbook(uint32_t *out, const uint32_t *a, size_t an,
+                          const uint32_t *b, size_t bn) {
+  memset(out, 0, (an + bn) * sizeof(uint32_t));
+
+  for (size_t i = 0; i < an; i++) {
+    uint64_t ai = a[i];
+    uint64_t carry = 0;
+
+    for (size_t j = 0; j < bn; j++) {
+      uint64_t cur = ai * b[j] + out[i + j] + carry;
+      out[i + j] = (uint32_t)(cur & UINT32_MAX);
+      carry = cur >> 32;
+    }
+
+    out[i + bn] = (uint32_t)carry;
+  }
+}
+
+// Bloco de linhas de uma multiplicação paralela
+typedef struct {
+  uint32_t *out; // Produto parcial: an + bn limbs
+  const uint32_t *a;
+  size_t an;
+  const uint32_t *b;
+  size_t bn;
+} MulBlock;
+
+static void mul_block_task(void *arg) {
+  MulBlock *block = arg;
+  limbs_mul(block->out, block->a, block->an, block->b, block->bn);
+}
+
+// Divide a em blocos, multiplica cada um por b em uma tarefa e soma os
+// produtos parciais nos deslocamentos certos
+// Retorna 0 se faltou memória (quem chamar faz a versão serial)
+static int mul_blocked(Scheduler *s, uint32_t *out, const uint32_t *a,
+                       size_t an, const uint32_t *b, size_t bn,
+                       size_t block_len) {
+  size_t nblocks = (an + block_len - 1) / block_len;
+  MulBlock *blocks = malloc(nblocks * sizeof(MulBlock));
+  uint32_t *partials = malloc((an + nblocks * bn) * sizeof(uint32_t));
+  if (blocks == NULL || partials == NULL) {
+    free(blocks);
+    free(partials);
+    return 0;
+  }
+
+  TaskGroup group = {0};
+  size_t used = 0;
+  for (size_t k = 0; k < nblocks; k++) {
+    size_t start = k * block_len;
+    size_t len = (an - start < block_len) ? an - start : block_len;
+    blocks[k].out = partials + used;
+    blocks[k].a = a + start;
+    blocks[k].an = len;
+    blocks[k].b = b;
+    blocks[k].bn = bn;
+    used += len + bn;
+    if (s != NULL) {
+      scheduler_spawn(s, &group, mul_block_task, &blocks[k]);
+    } else {
+      mul_block_task(&blocks[k]);
+    }
+  }
+  if (s != NULL) {
+    scheduler_wait(s, &group);
+  }
+
+  memset(out, 0, (an + bn) * sizeof(uint32_t));
+  for (size_t k = 0; k < nblocks; k++) {
+    add_at(out, an + bn, blocks[k].out, blocks[k].an + bn, k * block_len);
+  }
+
+  free(blocks);
+  free(partials);
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Karatsuba (operandos do mesmo tamanho)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  uint32_t *out;
+  const uint32_t *a;
+  size_t an;
+  const uint32_t *b;
+  size_t bn;
+} MulJob;
+
+static void mul_job_task(void *arg) {
+  MulJob *job = arg;
+  limbs_mul(job->out, job->a, job->an, job->b, job->bn);
+}
+
+// a = a1 * B^h + a0, b = b1 * B^h + b0
+// a * b = z2 * B^2h + (z1 - z2 - z0) * B^h + z0, com z1 = (a0 + a1)(b0 + b1)
+// Retorna 0 se faltou memória
+static int mul_karatsuba(uint32_t *out, const uint32_t *a, const uint32_t *b,
+                         size_t n) {
+  size_t h = n / 2;
+  size_t hi = n - h; // hi >= h
+  uint32_t *sa = malloc((hi + 1) * sizeof(uint32_t));
+  uint32_t *sb = malloc((hi + 1) * sizeof(uint32_t));
+  uint32_t *z1 = malloc(2 * (hi + 1) * sizeof(uint32_t));
+  if (sa == NULL || sb == NULL || z1 == NULL) {
+    free(sa);
+    free(sb);
+    free(z1);
+    return 0;
+  }
+
+  add_limbs(sa, a + h, hi, a, h);
+  add_limbs(sb, b + h, hi, b, h);
+
+  // z0 e z2 são escritos direto nas duas metades de out
+  MulJob z0 = {out, a, h, b, h};
+  MulJob z2 = {out + 2 * h, a + h, hi, b + h, hi};
+
+  Scheduler *s = scheduler_current();
+  if (s != NULL && n >= LIMBS_PARALLEL_KARATSUBA_MIN) {
+    TaskGroup group = {0};
+    scheduler_spawn(s, &group, mul_job_task, &z0);
+    scheduler_spawn(s, &group, mul_job_task, &z2);
+    limbs_mul(z1, sa, hi + 1, sb, hi + 1);
+    scheduler_wait(s, &group);
+  } else {
+    mul_job_task(&z0);
+    mul_job_task(&z2);
+    limbs_mul(z1, sa, hi + 1, sb, hi + 1);
+  }
+
+  sub_in_place(z1, 2 * (hi + 1), out, 2 * h);
+  sub_in_place(z1, 2 * (hi + 1), out + 2 * h, 2 * hi);
+
+  // O termo do meio cabe em n + 1 limbs a partir de h
+  size_t z1_len = 2 * (hi + 1);
+  while (z1_len > 0 && z1[z1_len - 1] == 0) {
+    z1_len--;
+  }
+  add_at(out, 2 * n, z1, z1_len, h);
+
+  free(sa);
+  free(sb);
+  free(z1);
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// NTT sobre o primo p = 2^64 - 2^32 + 1
+// Cada limb é dividido em dois dígitos de 16 bits; os coeficientes da
+// convolução ficam abaixo de n * 2^32 < p para até 2^32 dígitos
+// ---------------------------------------------------------------------------
+
+#define NTT_P       0xFFFFFFFF00000001ULL
+#define NTT_EPSILON 0xFFFFFFFFULL // 2^64 mod p
+#define NTT_ROOT    7ULL          // Gerador do grupo multiplicativo
+
+// Reduz um valor de 128 bits módulo p usando 2^64 = 2^32 - 1 e 2^96 = -1
+static uint64_t ntt_reduce(limb_u128 x) {
+  uint64_t lo = (uint64_t)x;
+  uint64_t hi = (uint64_t)(x >> 64);
+  uint64_t hi_hi = hi >> 32;
+  uint64_t hi_lo = hi & NTT_EPSILON;
+
+  uint64_t t0 = lo - hi_hi;
+  if (lo < hi_hi) {
+    t0 -= NTT_EPSILON;
+  }
+  uint64_t t1 = hi_lo * NTT_EPSILON;
+  uint64_t r = t0 + t1;
+  if (r < t1) {
+    r += NTT_EPSILON;
+  }
+  return r >= NTT_P ? r - NTT_P : r;
+}
+
+static uint64_t ntt_mul(uint64_t a, uint64_t b) {
+  return ntt_reduce((limb_u128)a * b);
+}
+
+static uint64_t ntt_add(uint64_t a, uint64_t b) {
+  uint64_t r = a + b;
+  if (r < a) {
+    return r + NTT_EPSILON;
+  }
+  return r >= NTT_P ? r - NTT_P : r;
+}
+
+static uint64_t ntt_sub(uint64_t a, uint64_t b) {
+  return a >= b ? a - b : a + (NTT_P - b);
+}
+
+static uint64_t ntt_pow(uint64_t base, uint64_t e) {
+  uint64_t r = 1;
+  while (e > 0) {
+    if (e & 1) {
+      r = ntt_mul(r, base);
+    }
+    base = ntt_mul(base, base);
+    e >>= 1;
+  }
+  return r;
+}
+
+// Contexto de um estágio de borboletas
+typedef struct {
+  uint64_t *data;
+  const uint64_t *twiddles; // twiddles[i] = w^i, i < size / 2
+  size_t size;
+  size_t half; // Metade do bloco do estágio atual
+} NttStage;
+
+static void ntt_stage_range(void *ctx, size_t begin, size_t end) {
+  NttStage *st = ctx;
+  size_t stride = st->size / (2 * st->half);
+
+  for (size_t k = begin; k < end; k++) {
+    size_t j = k % st->half;
+    size_t base = (k / st->half) * 2 * st->half;
+    uint64_t *x = st->data + base + j;
+    uint64_t *y = x + st->half;
+    uint64_t t = ntt_mul(*y, st->twiddles[j * stride]);
+    *y = ntt_sub(*x, t);
+    *x = ntt_add(*x, t);
+  }
+}
+
+// Transformada in-place (Cooley-Tukey iterativa); size é potência de 2
+static void ntt_transform(uint64_t *data, size_t size,
+                          const uint64_t *twiddles) {
+  // Permutação bit-reversa
+  for (size_t i = 1, j = 0; i < size; i++) {
+    size_t bit = size >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      uint64_t t = data[i];
+      data[i] = data[j];
+      data[j] = t;
+    }
+  }
+
+  NttStage st = {data, twiddles, size, 1};
+  for (st.half = 1; st.half < size; st.half *= 2) {
+    if (size >= LIMBS_PARALLEL_NTT_MIN) {
+      scheduler_parallel_for(size / 2, LIMBS_PARALLEL_GRAIN, ntt_stage_range,
+                             &st);
+    } else {
+      ntt_stage_range(&st, 0, size / 2);
+    }
+  }
+}
+
+typedef struct {
+  uint64_t *fa;
+  const uint64_t *fb;
+  uint64_t scale; // size^-1, aplicado junto com o produto ponto a ponto
+} NttPointwise;
+
+static void ntt_pointwise_range(void *ctx, size_t begin, size_t end) {
+  NttPointwise *pw = ctx;
+  for (size_t i = begin; i < end; i++) {
+    pw->fa[i] = ntt_mul(ntt_mul(pw->fa[i], pw->fb[i]), pw->scale);
+  }
+}
+
+// Preenche twiddles[i] = w^i para i < size / 2
+static void ntt_twiddles(uint64_t *twiddles, size_t size, uint64_t w) {
+  twiddles[0] = 1;
+  for (size_t i = 1; i < size / 2; i++) {
+    twiddles[i] = ntt_mul(twiddles[i - 1], w);
+  }
+}
+
+// Retorna 0 se faltou memória
+static int mul_ntt(uint32_t *out, const uint32_t *a, size_t an,
+                   const uint32_t *b, size_t bn) {
+  size_t digits = 2 * (an + bn);
+  size_t size = 1;
+  while (size < digits) {
+    size *= 2;
+  }
+
+  uint64_t *fa = calloc(size, sizeof(uint64_t));
+  uint64_t *fb = calloc(size, sizeof(uint64_t));
+  uint64_t *tw = malloc((size / 2 + 1) * sizeof(uint64_t));
+  if (fa == NULL || fb == NULL || tw == NULL) {
+    free(fa);
+    free(fb);
+    free(tw);
+    return 0;
+  }
+
+  for (size_t i = 0; i < an; i++) {
+    fa[2 * i] = a[i] & 0xFFFF;
+    fa[2 * i + 1] = a[i] >> 16;
+  }
+  for (size_t i = 0; i < bn; i++) {
+    fb[2 * i] = b[i] & 0xFFFF;
+    fb[2 * i + 1] = b[i] >> 16;
+  }
+
+  uint64_t w = ntt_pow(NTT_ROOT, (NTT_P - 1) / size);
+  ntt_twiddles(tw, size, w);
+  ntt_transform(fa, size, tw);
+  ntt_transform(fb, size, tw);
+
+  NttPointwise pw = {fa, fb, ntt_pow(size, NTT_P - 2)};
+  scheduler_parallel_for(size, LIMBS_PARALLEL_GRAIN, ntt_pointwise_range, &pw);
+
+  ntt_twiddles(tw, size, ntt_pow(w, NTT_P - 2));
+  ntt_transform(fa, size, tw);
+
+  // Propaga o carry em base 2^16 e junta pares de dígitos em limbs
+  limb_u128 carry = 0;
+  for (size_t i = 0; i < an + bn; i++) {
+    carry += fa[2 * i];
+    uint32_t lo = (uint32_t)(carry & 0xFFFF);
+    carry >>= 16;
+    carry += fa[2 * i + 1];
+    uint32_t hi = (uint32_t)(carry & 0xFFFF);
+    carry >>= 16;
+    out[i] = lo | (hi << 16);
+  }
+
+  free(fa);
+  free(fb);
+  free(tw);
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Seleção do algoritmo
+// ---------------------------------------------------------------------------
+
+// Multiplica a (an limbs) por b (bn limbs); out deve ter an + bn limbs
+void limbs_mul(uint32_t *out, const uint32_t *a, size_t an, const uint32_t *b,
+               size_t bn) {
+  // Mantém a como o operando maior
+  if (an < bn) {
+    const uint32_t *tp = a;
+    a = b;
+    b = tp;
+    size_t tn = an;
+    an = bn;
+    bn = tn;
+  }
+
+  if (bn == 0) {
+    memset(out, 0, an * sizeof(uint32_t));
+    return;
+  }
+
+  Scheduler *s = scheduler_current();
+
+  if (bn < LIMBS_KARATSUBA_THRESHOLD) {
+    // Escolar; para tamanhos médios divide em blocos de linhas
+    if (s != NULL && an * bn >= LIMBS_PARALLEL_MUL_MIN) {
+      size_t nblocks = 2 * scheduler_workers(s);
+      if (nblocks > an / LIMBS_PARALLEL_BLOCK_MIN) {
+        nblocks = an / LIMBS_PARALLEL_BLOCK_MIN;
+      }
+      if (nblocks >= 2 &&
+          mul_blocked(s, out, a, an, b, bn, (an + nblocks - 1) / nblocks)) {
+        return;
+      }
+    }
+    limbs_mul_schoolbook(out, a, an, b, bn);
+    return;
+  }
+
+  if (bn >= LIMBS_NTT_THRESHOLD && mul_ntt(out, a, an, b, bn)) {
+    return;
+  }
+
+  if (an == bn) {
+    if (!mul_karatsuba(out, a, b, an)) {
+      limbs_mul_schoolbook(out, a, an, b, bn);
+    }
+    return;
+  }
+
+  // Operandos desbalanceados: fatia a em pedaços do tamanho de b
+  if (!mul_blocked(an >= 2 * bn ? s : NULL, out, a, an, b, bn, bn)) {
+    limbs_mul_schoolbook(out, a, an, b, bn);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Comparação e divisão
+// ---------------------------------------------------------------------------
+
+// Abaixo deste tamanho (limbs do divisor e do quociente) usa Knuth D
+// (make tune ou PE_DIV_NEWTON_THRESHOLD)
+#define LIMBS_DIV_NEWTON_THRESHOLD tuning_get(TUNE_DIV_NEWTON)
+
+// Tamanho em que o recíproco é calculado diretamente por Knuth D
+#define LIMBS_RECIPROCAL_BASECASE 40
+
+// Retorna o comprimento sem os limbs zerados mais significativos
+size_t limbs_normalized_length(const uint32_t *a, size_t n) {
+  while (n > 0 && a[n - 1] == 0) {
+    n--;
+  }
+  return n;
+}
+
+// Compara magnitudes. Retorna 1 se a > b, 0 se iguais, -1 se a < b
+int limbs_cmp(const uint32_t *a, size_t an, const uint32_t *b, size_t bn) {
+  an = limbs_normalized_length(a, an);
+  bn = limbs_normalized_length(b, bn);
+  if (an != bn) {
+    return an > bn ? 1 : -1;
+  }
+  for (size_t i = an; i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] > b[i] ? 1 : -1;
+    }
+  }
+  return 0;
+}
+
+// Divide a por um único limb; q recebe an limbs. Retorna o resto
+uint32_t limbs_divmod_1(uint32_t *q, const uint32_t *a, size_t an,
+                        uint32_t d) {
+  uint64_t remainder = 0;
+  for (size_t i = an; i-- > 0;) {
+    uint64_t cur = (remainder << 32) | a[i];
+    q[i] = (uint32_t)(cur / d);
+    remainder = cur % d;
+  }
+  return (uint32_t)remainder;
+}
+
+static int count_leading_zeros(uint32_t x) {
+  int n = 0;
+  while ((x & 0x80000000u) == 0) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+}
+
+// Algoritmo D de Knuth (TAOCP vol. 2, 4.3.1) com dígitos de 32 bits
+// Requer an >= bn >= 2 e b[bn - 1] != 0. Retorna 0 se faltou memória ou se
+// o ExecContext pediu para parar
+static int divmod_knuth(uint32_t *q, uint32_t *r, const uint32_t *a,
+                        size_t an, const uint32_t *b, size_t bn) {
+  uint32_t *vn = malloc(bn * sizeof(uint32_t));
+  uint32_t *un = malloc((an + 1) * sizeof(uint32_t));
+  if (vn == NULL || un == NULL) {
+    free(vn);
+    free(un);
+    return 0;
+  }
+
+  // Normaliza para que o limb mais significativo do divisor tenha o bit
+  // mais alto ligado; isso limita o erro da estimativa de qhat a 2
+  int s = count_leading_zeros(b[bn - 1]);
+  for (size_t i = bn - 1; i > 0; i--) {
+    vn[i] = (b[i] << s) | (s ? b[i - 1] >> (32 - s) : 0);
+  }
+  vn[0] = b[0] << s;
+  un[an] = s ? a[an - 1] >> (32 - s) : 0;
+  for (size_t i = an - 1; i > 0; i--) {
+    un[i] = (a[i] << s) | (s ? a[i - 1] >> (32 - s) : 0);
+  }
+  un[0] = a[0] << s;
+
+  const uint64_t base = 1ULL << 32;
+  size_t work = 0;
+  for (size_t j = an - bn + 1; j-- > 0;) {
+    work += bn;
+    if (work >= LIMBS_CHECKPOINT_WORK) {
+      work = 0;
+      if (exec_checkpoint("divisao", an - bn - j, an - bn + 1)) {
+        free(vn);
+        free(un);
+        return 0;
+      }
+    }
+    uint64_t num = ((uint64_t)un[j + bn] << 32) | un[j + bn - 1];
+    uint64_t qhat = num / vn[bn - 1];
+    uint64_t rhat = num % vn[bn - 1];
+    while (qhat >= base ||
+           qhat * vn[bn - 2] > ((rhat << 32) | un[j + bn - 2])) {
+      qhat--;
+      rhat += vn[bn - 1];
+      if (rhat >= base) {
+        break;
+      }
+    }
+
+    // Multiplica e subtrai
+    int64_t k = 0;
+    int64_t t;
+    for (size_t i = 0; i < bn; i++) {
+      uint64_t p = qhat * vn[i];
+      t = (int64_t)un[i + j] - k - (int64_t)(p & UINT32_MAX);
+      un[i + j] = (uint32_t)t;
+      k = (int64_t)(p >> 32) - (t >> 32);
+    }
+    t = (int64_t)un[j + bn] - k;
+    un[j + bn] = (uint32_t)t;
+
+    // Estimativa uma unidade acima: soma o divisor de volta
+    if (t < 0) {
+      qhat--;
+      uint64_t carry = 0;
+      for (size_t i = 0; i < bn; i++) {
+        uint64_t cur = (uint64_t)un[i + j] + vn[i] + carry;
+        un[i + j] = (uint32_t)cur;
+        carry = cur >> 32;
+      }
+      un[j + bn] += (uint32_t)carry;
+    }
+    q[j] = (uint32_t)qhat;
+  }
+
+  // Desfaz a normalização do resto
+  for (size_t i = 0; i < bn; i++) {
+    r[i] = (un[i] >> s) | (s ? un[i + 1] << (32 - s) : 0);
+  }
+
+  free(vn);
+  free(un);
+  return 1;
+}
+
+// out = a - b, com a >= b (an >= bn); out pode ser igual a a
+void limbs_sub(uint32_t *out, const uint32_t *a, size_t an, const uint32_t *b,
+               size_t bn) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < an; i++) {
+    uint64_t sub = (i < bn ? b[i] : 0) + borrow;
+    uint64_t av = a[i];
+    borrow = av < sub;
+    out[i] = (uint32_t)((av - sub) & UINT32_MAX);
+  }
+}
+
+// a += 1 (propaga o carry); retorna o carry final
+static uint32_t increment(uint32_t *a, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (++a[i] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void decrement(uint32_t *a, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (a[i]-- != 0) {
+      return;
+    }
+  }
+}
+
+// Calcula inv = floor(B^2m / d), B = 2^32, d com m limbs e d[m - 1] != 0
+// inv deve ter m + 2 limbs. Usa iteração de Newton dobrando a precisão:
+// o recíproco dos h limbs mais significativos de d é estendido com um passo
+// X1 = X0 + X0 * (B^2m - d * X0) / B^2m e corrigido até ficar exato
+// Retorna 0 se faltou memória
+int limbs_reciprocal(uint32_t *inv, const uint32_t *d, size_t m) {
+  size_t pn = 2 * m + 1;
+  uint32_t *power = calloc(pn, sizeof(uint32_t)); // B^2m
+  if (power == NULL) {
+    return 0;
+  }
+  power[2 * m] = 1;
+
+  if (m <= LIMBS_RECIPROCAL_BASECASE) {
+    uint32_t *r = malloc(m * sizeof(uint32_t));
+    int ok = r != NULL;
+    if (ok && m == 1) {
+      limbs_divmod_1(inv, power, pn, d[0]);
+    } else if (ok) {
+      ok = divmod_knuth(inv, r, power, pn, d, m);
+    }
+    free(r);
+    free(power);
+    return ok;
+  }
+
+  // Recíproco dos h limbs mais significativos, com limbs de guarda
+  size_t h = m / 2 + 3;
+  uint32_t *ih = malloc((h + 2) * sizeof(uint32_t));
+  uint32_t *x = calloc(m + 2, sizeof(uint32_t));
+  uint32_t *t = malloc((2 * m + 2) * sizeof(uint32_t));
+  uint32_t *e = malloc((2 * m + 2) * sizeof(uint32_t));
+  uint32_t *xe = malloc((3 * m + 4) * sizeof(uint32_t));
+  int ok = ih != NULL && x != NULL && t != NULL && e != NULL && xe != NULL &&
+           limbs_reciprocal(ih, d + (m - h), h);
+
+  if (ok) {
+    // X0 = Ih * B^(m - h)
+    memcpy(x + (m - h), ih, (h + 2) * sizeof(uint32_t));
+
+    // Passo de Newton
+    limbs_mul(t, d, m, x, m + 2);
+    size_t tn = 2 * m + 2;
+    if (limbs_cmp(t, tn, power, pn) <= 0) {
+      limbs_sub(e, power, pn, t, pn);
+      limbs_mul(xe, x, m + 2, e, pn);
+      add_at(x, m + 2, xe + 2 * m, m + 2, 0);
+    } else {
+      limbs_sub(e, t, tn, power, pn);
+      limbs_mul(xe, x, m + 2, e, tn);
+      sub_in_place(x, m + 2, xe + 2 * m, m + 2);
+    }
+
+    // Correção final: garante d * X <= B^2m < d * (X + 1)
+    limbs_mul(t, d, m, x, m + 2);
+    while (limbs_cmp(t, tn, power, pn) > 0) {
+      decrement(x, m + 2);
+      sub_in_place(t, tn, d, m);
+    }
+    limbs_sub(e, power, pn, t, pn);
+    while (limbs_cmp(e, pn, d, m) >= 0) {
+      increment(x, m + 2);
+      sub_in_place(e, pn, d, m);
+    }
+    memcpy(inv, x, (m + 2) * sizeof(uint32_t));
+  }
+
+  free(power);
+  free(ih);
+  free(x);
+  free(t);
+  free(e);
+  free(xe);
+  return ok;
+}
+
+// Divide x (xn <= 2m limbs) por d (m limbs) usando inv = floor(B^2m / d)
+// (redução de Barrett). q recebe xn - m + 1 limbs e r recebe m limbs
+// Retorna 0 se faltou memória
+int limbs_divmod_preinv(uint32_t *q, uint32_t *r, const uint32_t *x,
+                        size_t xn, const uint32_t *d, size_t m,
+                        const uint32_t *inv) {
+  if (xn < m) {
+    memcpy(r, x, xn * sizeof(uint32_t));
+    memset(r + xn, 0, (m - xn) * sizeof(uint32_t));
+    return 1;
+  }
+
+  size_t qn = xn - m + 1;
+  size_t x1n = xn - (m - 1);
+  uint32_t *prod = malloc((x1n + m + 2) * sizeof(uint32_t));
+  uint32_t *qd = malloc((qn + 1 + m) * sizeof(uint32_t));
+  uint32_t *rem = malloc((xn + 1) * sizeof(uint32_t));
+  if (prod == NULL || qd == NULL || rem == NULL) {
+    free(prod);
+    free(qd);
+    free(rem);
+    return 0;
+  }
+
+  // q_est = floor(floor(x / B^(m-1)) * inv / B^(m+1)), q - 2 <= q_est <= q
+  limbs_mul(prod, x + (m - 1), x1n, inv, m + 2);
+  uint32_t *q_est = prod + (m + 1);
+  size_t q_est_n = x1n + 1; // x1n + m + 2 - (m + 1)
+
+  limbs_mul(qd, q_est, q_est_n, d, m);
+  memcpy(rem, x, xn * sizeof(uint32_t));
+  rem[xn] = 0;
+  size_t qdn = q_est_n + m < xn + 1 ? q_est_n + m : xn + 1;
+  sub_in_place(rem, xn + 1, qd, qdn);
+
+  while (limbs_cmp(rem, xn + 1, d, m) >= 0) {
+    sub_in_place(rem, xn + 1, d, m);
+    increment(q_est, q_est_n);
+  }
+
+  memcpy(q, q_est, qn * sizeof(uint32_t));
+  memcpy(r, rem, m * sizeof(uint32_t));
+
+  free(prod);
+  free(qd);
+  free(rem);
+  return 1;
+}
+
+// Divisão com recíproco de Newton: processa a em blocos de m limbs a partir
+// do mais significativo, cada um com uma redução de Barrett
+static int divmod_newton(uint32_t *q, uint32_t *r, const uint32_t *a,
+                         size_t an, const uint32_t *b, size_t bn) {
+  uint32_t *inv = malloc((bn + 2) * sizeof(uint32_t));
+  uint32_t *x = malloc(2 * bn * sizeof(uint32_t));
+  uint32_t *qblock = malloc((bn + 1) * sizeof(uint32_t));
+  if (inv == NULL || x == NULL || qblock == NULL ||
+      !limbs_reciprocal(inv, b, bn)) {
+    free(inv);
+    free(x);
+    free(qblock);
+    return 0;
+  }
+
+  memset(q, 0, (an - bn + 1) * sizeof(uint32_t));
+  memset(r, 0, bn * sizeof(uint32_t));
+
+  // Invariante: r < b. A cada passo x = r * B^k + próximos k limbs de a
+  size_t pos = an;
+  int ok = 1;
+  while (ok && pos > 0) {
+    if (exec_checkpoint("divisao", an - pos, an)) {
+      ok = 0;
+      break;
+    }
+    size_t k = pos < bn ? pos : bn;
+    pos -= k;
+    memcpy(x, a + pos, k * sizeof(uint32_t));
+    memcpy(x + k, r, bn * sizeof(uint32_t));
+    size_t xn = limbs_normalized_length(x, k + bn);
+    if (xn < bn) {
+      memcpy(r, x, xn * sizeof(uint32_t));
+      memset(r + xn, 0, (bn - xn) * sizeof(uint32_t));
+      continue;
+    }
+    ok = limbs_divmod_preinv(qblock, r, x, xn, b, bn, inv);
+    // O quociente do bloco é menor que B^k
+    size_t qn = xn - bn + 1;
+    for (size_t i = 0; ok && i < qn && i < k && pos + i < an - bn + 1; i++) {
+      q[pos + i] = qblock[i];
+    }
+  }
+
+  free(inv);
+  free(x);
+  free(qblock);
+  return ok;
+}
+
+// Divide a por b: q recebe an - bn + 1 limbs e r recebe bn limbs
+int limbs_divmod(uint32_t *q, uint32_t *r, const uint32_t *a, size_t an,
+                 const uint32_t *b, size_t bn) {
+  if (bn == 1) {
+    r[0] = limbs_divmod_1(q, a, an, b[0]);
+    return 1;
+  }
+
+  if (bn >= LIMBS_DIV_NEWTON_THRESHOLD &&
+      an - bn >= LIMBS_DIV_NEWTON_THRESHOLD) {
+    if (divmod_newton(q, r, a, an, b, bn)) {
+      return 1;
+    }
+    if (exec_stopped()) {
+      return 0; // Interrompida: não refaz pelo algoritmo de Knuth
+    }
+  }
+  return divmod_knuth(q, r, a, an, b, bn);
+}
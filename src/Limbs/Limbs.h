@@ -0,0 +1,53 @@
+#ifndef LIMBS_H
+#define LIMBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Kernels aritméticos sobre arrays contíguos de limbs (base 2^32, LSB
+// primeiro). O BigInt exporta a lista para um array uma única vez, roda o
+// kernel com acesso sequencial e importa o resultado, evitando o custo O(n)
+// de linkedlist_get a cada limb
+
+// Multiplicação escolar: out deve ter an + bn limbs e não pode ser a nem b
+void limbs_mul_schoolbook(uint32_t *out, const uint32_t *a, size_t an,
+                          const uint32_t *b, size_t bn);
+
+// Multiplica a (an limbs) por b (bn limbs); out deve ter an + bn limbs
+// Quando chamada de um worker do Scheduler e os operandos são grandes, o
+// produto é dividido em blocos de linhas que outros workers podem roubar
+void limbs_mul(uint32_t *out, const uint32_t *a, size_t an, const uint32_t *b,
+               size_t bn);
+
+// out = a - b (an limbs), com a >= b e an >= bn; out pode ser igual a a
+void limbs_sub(uint32_t *out, const uint32_t *a, size_t an, const uint32_t *b,
+               size_t bn);
+
+// Retorna o comprimento sem os limbs zerados mais significativos
+size_t limbs_normalized_length(const uint32_t *a, size_t n);
+
+// Compara magnitudes. Retorna 1 se a > b, 0 se iguais, -1 se a < b
+int limbs_cmp(const uint32_t *a, size_t an, const uint32_t *b, size_t bn);
+
+// Divide a por um único limb d != 0; q recebe an limbs. Retorna o resto
+uint32_t limbs_divmod_1(uint32_t *q, const uint32_t *a, size_t an,
+                        uint32_t d);
+
+// Divide a por b: q recebe an - bn + 1 limbs e r recebe bn limbs
+// Requer an >= bn >= 1 e b[bn - 1] != 0. Divisores pequenos usam o
+// algoritmo D de Knuth; grandes usam recíproco de Newton e redução de Barrett
+// Retorna 0 se faltou memória ou se o ExecContext da thread pediu para parar
+int limbs_divmod(uint32_t *q, uint32_t *r, const uint32_t *a, size_t an,
+                 const uint32_t *b, size_t bn);
+
+// Calcula inv = floor(B^2m / d) (m + 2 limbs), com d de m limbs e
+// d[m - 1] != 0. Permite reaproveitar o recíproco em várias divisões por d
+int limbs_reciprocal(uint32_t *inv, const uint32_t *d, size_t m);
+
+// Divide x (m <= xn <= 2m limbs) por d usando inv de limbs_reciprocal
+// q recebe xn - m + 1 limbs e r recebe m limbs. Retorna 0 se faltou memória
+int limbs_divmod_preinv(uint32_t *q, uint32_t *r, const uint32_t *x,
+                        size_t xn, const uint32_t *d, size_t m,
+                        const uint32_t *inv);
+
+#endif // LIMBS_H
@@ -1,4 +1,5 @@
 #include "LinkedList.h"
+#include "../Instrument/Instrument.h"
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -8,33 +9,106 @@ LinkedList *linkedlist_create(void) {
   if(list == NULL) {
     return NULL;
   }
+  INSTR_ALLOC(1, sizeof(LinkedList));
 
   list->head   = NULL;
   list->tail   = NULL;
   list->length = 0;
+  list->refs   = NULL;
 
   return list;
 }
 
-// Destrói uma lista encadeada e libera sua memória
-void linkedlist_destroy(LinkedList *list) {
-  if(list == NULL) {
-    return;
+// Libera uma referência aos nós. Retorna 1 se era a última (os nós devem
+// ser liberados por quem chamou)
+static int release_nodes(LinkedList *list) {
+  if(list->refs == NULL) {
+    return 1;
+  }
+  if(__atomic_sub_fetch(list->refs, 1, __ATOMIC_ACQ_REL) > 0) {
+    return 0;
   }
+  free(list->refs);
+  INSTR_FREE(1, sizeof(size_t));
+  list->refs = NULL;
+  return 1;
+}
 
-  ListNode *current = list->head;
+static void free_nodes(ListNode *current) {
+  size_t count = 0;
   while(current != NULL) {
     ListNode *next = current->next;
     free(current);
     current = next;
+    count++;
+  }
+  INSTR_FREE(count, count * sizeof(ListNode));
+  (void)count;
+}
+
+// Garante que os nós pertencem só a esta lista antes de modificá-la
+// Retorna 0 se faltou memória (a lista continua compartilhada)
+static int detach(LinkedList *list) {
+  if(list->refs == NULL) {
+    return 1;
+  }
+  if(__atomic_load_n(list->refs, __ATOMIC_ACQUIRE) == 1) {
+    // As outras cópias já foram destruídas
+    free(list->refs);
+    INSTR_FREE(1, sizeof(size_t));
+    list->refs = NULL;
+    return 1;
   }
 
+  ListNode *head = NULL;
+  ListNode *tail = NULL;
+  for(ListNode *current = list->head; current != NULL; current = current->next) {
+    ListNode *node = malloc(sizeof(ListNode));
+    if(node == NULL) {
+      free_nodes(head);
+      return 0;
+    }
+    INSTR_ALLOC(1, sizeof(ListNode));
+    node->value = current->value;
+    node->next  = NULL;
+    if(tail == NULL) {
+      head = node;
+    } else {
+      tail->next = node;
+    }
+    tail = node;
+  }
+
+  INSTR_COUNT(INSTR_DETACHES, 1);
+  INSTR_COUNT(INSTR_NODES_COPIED, list->length);
+
+  // As outras cópias podem ter sido destruídas enquanto copiávamos
+  if(release_nodes(list)) {
+    free_nodes(list->head);
+  }
+  list->refs = NULL;
+  list->head = head;
+  list->tail = tail;
+  return 1;
+}
+
+// Destrói uma lista encadeada e libera sua memória
+// Os nós só são liberados quando a última cópia é destruída
+void linkedlist_destroy(LinkedList *list) {
+  if(list == NULL) {
+    return;
+  }
+
+  if(release_nodes(list)) {
+    free_nodes(list->head);
+  }
   free(list);
+  INSTR_FREE(1, sizeof(LinkedList));
 }
 
 // Adiciona um valor no final da lista
 void linkedlist_append(LinkedList *list, uint32_t value) {
-  if(list == NULL) {
+  if(list == NULL || !detach(list)) {
     return;
   }
 
@@ -42,6 +116,8 @@ void linkedlist_append(LinkedList *list, uint32_t value) {
   if(new_node == NULL) {
     return;
   }
+  INSTR_ALLOC(1, sizeof(ListNode));
+  INSTR_COUNT(INSTR_APPENDS, 1);
 
   new_node->value = value;
   new_node->next  = NULL;
@@ -61,7 +137,7 @@ void linkedlist_append(LinkedList *list, uint32_t value) {
 
 // Adiciona um valor no início da lista
 void linkedlist_prepend(LinkedList *list, uint32_t value) {
-  if(list == NULL) {
+  if(list == NULL || !detach(list)) {
     return;
   }
 
@@ -69,6 +145,8 @@ void linkedlist_prepend(LinkedList *list, uint32_t value) {
   if(new_node == NULL) {
     return;
   }
+  INSTR_ALLOC(1, sizeof(ListNode));
+  INSTR_COUNT(INSTR_PREPENDS, 1);
 
   new_node->value = value;
   new_node->next  = list->head;
@@ -88,6 +166,7 @@ uint32_t linkedlist_get(LinkedList *list, size_t index) {
     return 0;
   }
 
+  INSTR_COUNT(INSTR_NODE_VISITS, index + 1);
   ListNode *current = list->head;
   for(size_t i = 0; i < index; i++) {
     current = current->next;
@@ -98,10 +177,11 @@ uint32_t linkedlist_get(LinkedList *list, size_t index) {
 
 // Define o valor no índice especificado
 void linkedlist_set(LinkedList *list, size_t index, uint32_t value) {
-  if(list == NULL || index >= list->length) {
+  if(list == NULL || index >= list->length || !detach(list)) {
     return;
   }
 
+  INSTR_COUNT(INSTR_NODE_VISITS, index + 1);
   ListNode *current = list->head;
   for(size_t i = 0; i < index; i++) {
     current = current->next;
@@ -118,39 +198,62 @@ size_t linkedlist_length(LinkedList *list) {
   return list->length;
 }
 
-// Cria uma cópia da lista
+// Cria uma cópia da lista em O(1), compartilhando os nós
 LinkedList *linkedlist_copy(LinkedList *list) {
   if(list == NULL) {
     return NULL;
   }
 
+  // O contador é criado na primeira cópia. Várias threads podem copiar a
+  // mesma lista ao mesmo tempo, então só uma delas instala o contador
+  if(__atomic_load_n(&list->refs, __ATOMIC_ACQUIRE) == NULL) {
+    size_t *refs = malloc(sizeof(size_t));
+    if(refs == NULL) {
+      return NULL;
+    }
+    INSTR_ALLOC(1, sizeof(size_t));
+    *refs = 1;
+    size_t *expected = NULL;
+    if(!__atomic_compare_exchange_n(&list->refs, &expected, refs, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      free(refs);
+      INSTR_FREE(1, sizeof(size_t));
+    }
+  }
+
   LinkedList *copy = linkedlist_create();
   if(copy == NULL) {
     return NULL;
   }
 
-  ListNode *current = list->head;
-  while(current != NULL) {
-    linkedlist_append(copy, current->value);
-    current = current->next;
-  }
+  INSTR_COUNT(INSTR_COPIES, 1);
+  __atomic_add_fetch(list->refs, 1, __ATOMIC_RELAXED);
+  copy->head   = list->head;
+  copy->tail   = list->tail;
+  copy->length = list->length;
+  copy->refs   = list->refs;
 
   return copy;
 }
 
+// Retorna 1 se os nós da lista são compartilhados com outra cópia
+int linkedlist_is_shared(const LinkedList *list) {
+  return list != NULL && list->refs != NULL &&
+         __atomic_load_n(list->refs, __ATOMIC_ACQUIRE) > 1;
+}
+
 // Remove todos os elementos da lista
 void linkedlist_clear(LinkedList *list) {
   if(list == NULL) {
     return;
   }
 
-  ListNode *current = list->head;
-  while(current != NULL) {
-    ListNode *next = current->next;
-    free(current);
-    current = next;
+  // Uma lista compartilhada só solta a referência, sem copiar os nós
+  if(release_nodes(list)) {
+    free_nodes(list->head);
   }
 
+  list->refs   = NULL;
   list->head   = NULL;
   list->tail   = NULL;
   list->length = 0;
@@ -158,7 +261,8 @@ void linkedlist_clear(LinkedList *list) {
 
 // Remove zeros à esquerda (do final da lista, já que LSB está primeiro)
 void linkedlist_remove_leading_zeros(LinkedList *list) {
-  if(list == NULL || list->length == 0) {
+  if(list == NULL || list->length <= 1 || list->tail->value != 0 ||
+     !detach(list)) {
     return;
   }
 
@@ -178,6 +282,7 @@ void linkedlist_remove_leading_zeros(LinkedList *list) {
 
     // Remove o último nó
     free(list->tail);
+    INSTR_FREE(1, sizeof(ListNode));
     list->tail       = current;
     list->tail->next = NULL;
     list->length--;
@@ -4,6 +4,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// As funções não usam estado global: listas distintas podem ser usadas em
+// threads diferentes sem sincronização
+
+// Cópias compartilham os nós (copy-on-write): linkedlist_copy é O(1) e só
+// incrementa um contador de referências (atômico, então cópias de uma mesma
+// lista podem ser usadas e destruídas em threads diferentes). As funções
+// que modificam a lista fazem a cópia real dos nós antes, se eles ainda
+// forem compartilhados. Quem percorre os nós diretamente só pode lê-los
+
 // Estrutura do nó da lista encadeada
 typedef struct ListNode {
   uint32_t value;          // Valor armazenado (base 2^32)
@@ -15,6 +24,7 @@ typedef struct {
   ListNode* head;          // Ponteiro para o primeiro nó
   ListNode* tail;          // Ponteiro para o último nó
   size_t length;           // Quantidade de elementos na lista
+  size_t* refs;            // Listas que compartilham os nós (NULL se única)
 } LinkedList;
 
 // Cria uma nova lista encadeada vazia
@@ -38,9 +48,12 @@ void linkedlist_set(LinkedList* list, size_t index, uint32_t value);
 // Retorna o comprimento da lista
 size_t linkedlist_length(LinkedList* list);
 
-// Cria uma cópia da lista
+// Cria uma cópia da lista em O(1), compartilhando os nós
 LinkedList* linkedlist_copy(LinkedList* list);
 
+// Retorna 1 se os nós da lista são compartilhados com outra cópia
+int linkedlist_is_shared(const LinkedList* list);
+
 // Remove todos os elementos da lista
 void linkedlist_clear(LinkedList* list);
 
@@ -0,0 +1,326 @@
+#include "Montgomery.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Limbs/Limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Bits do expoente por janela em montgomery_pow (tabela com 2^4 potências)
+#define MONTGOMERY_WINDOW 4
+
+// a^-1 mod 2^32 para a ímpar (Newton: cada passo dobra os bits corretos)
+static uint32_t inverse_word(uint32_t a) {
+  uint32_t x = a; // a·a = 1 mod 8
+  for (int i = 0; i < 4; i++) {
+    x *= 2 - a * x;
+  }
+  return x;
+}
+
+// out = a·b com a e b de n limbs (não normalizados); out recebe 2n limbs
+static void mul_padded(uint32_t *out, const uint32_t *a, const uint32_t *b,
+                       size_t n) {
+  size_t an = limbs_normalized_length(a, n);
+  size_t bn = limbs_normalized_length(b, n);
+  memset(out, 0, 2 * n * sizeof(uint32_t));
+  if (an > 0 && bn > 0) {
+    limbs_mul(out, a, an, b, bn);
+  }
+}
+
+// out = t - m nos n limbs mais baixos (o empréstimo final é descartado)
+static void subtract_modulus(const MontgomeryContext *ctx, uint32_t *out,
+                             const uint32_t *t) {
+  uint32_t borrow = 0;
+  for (size_t i = 0; i < ctx->n; i++) {
+    uint64_t d = (uint64_t)t[i] - ctx->m[i] - borrow;
+    out[i] = (uint32_t)d;
+    borrow = (uint32_t)(d >> 63);
+  }
+}
+
+// out = t - m se t (n + 1 limbs, t < 2m) for >= m; senão out = t
+static void final_subtract(const MontgomeryContext *ctx, uint32_t *out,
+                           const uint32_t *t) {
+  size_t n = ctx->n;
+  if (t[n] == 0 && limbs_cmp(t, n, ctx->m, n) < 0) {
+    memmove(out, t, n * sizeof(uint32_t));
+  } else {
+    subtract_modulus(ctx, out, t);
+  }
+}
+
+// Produto intercalado com a redução (CIOS): a cada limb de a, soma a[i]·b
+// e um múltiplo de m que zera o limb mais baixo, que então é descartado
+static void mul_cios(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                     const uint32_t *b) {
+  size_t n = ctx->n;
+  const uint32_t *m = ctx->m;
+  uint32_t *t = ctx->tmp;
+  memset(t, 0, (n + 2) * sizeof(uint32_t));
+  for (size_t i = 0; i < n; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < n; j++) {
+      uint64_t s = (uint64_t)a[i] * b[j] + t[j] + carry;
+      t[j] = (uint32_t)s;
+      carry = s >> 32;
+    }
+    uint64_t s = (uint64_t)t[n] + carry;
+    t[n] = (uint32_t)s;
+    t[n + 1] = (uint32_t)(s >> 32);
+
+    uint32_t u = t[0] * ctx->minv;
+    carry = ((uint64_t)u * m[0] + t[0]) >> 32;
+    for (size_t j = 1; j < n; j++) {
+      s = (uint64_t)u * m[j] + t[j] + carry;
+      t[j - 1] = (uint32_t)s;
+      carry = s >> 32;
+    }
+    s = (uint64_t)t[n] + carry;
+    t[n - 1] = (uint32_t)s;
+    t[n] = t[n + 1] + (uint32_t)(s >> 32);
+  }
+  final_subtract(ctx, out, t);
+}
+
+// Redução em bloco: q = (a·b mod R)·(-m^-1) mod R e (a·b + q·m) / R, com
+// três multiplicações rápidas de n limbs
+static void mul_bulk(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                     const uint32_t *b) {
+  size_t n = ctx->n;
+  uint32_t *prod = ctx->tmp;
+  uint32_t *q = prod + 2 * n;
+  uint32_t *qm = q + 2 * n;
+  mul_padded(prod, a, b, n);
+  mul_padded(q, prod, ctx->minv_all, n);
+  mul_padded(qm, q, ctx->m, n);
+
+  // Os n limbs mais baixos da soma são zero; só o "vai um" deles importa
+  uint64_t carry = 0;
+  for (size_t i = 0; i < 2 * n; i++) {
+    uint64_t s = (uint64_t)prod[i] + qm[i] + carry;
+    prod[i] = (uint32_t)s;
+    carry = s >> 32;
+  }
+  prod[2 * n] = (uint32_t)carry;
+  final_subtract(ctx, out, prod + n);
+}
+
+void montgomery_mul(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                    const uint32_t *b) {
+  if (ctx->minv_all != NULL) {
+    mul_bulk(ctx, out, a, b);
+  } else {
+    mul_cios(ctx, out, a, b);
+  }
+}
+
+// -m^-1 mod R por Hensel: se x = m^-1 mod B^p, x·(2 - m·x) = m^-1 mod B^2p
+// Como m·x = 1 + B^p·h, basta calcular os limbs novos -x·h mod B^p
+static int inverse_all(MontgomeryContext *ctx) {
+  size_t n = ctx->n;
+  uint32_t *x = ctx->minv_all;
+  uint32_t *e = malloc(2 * n * sizeof(uint32_t));
+  uint32_t *h = malloc(2 * n * sizeof(uint32_t));
+  if (e == NULL || h == NULL) {
+    free(e);
+    free(h);
+    return 0;
+  }
+  memset(x, 0, n * sizeof(uint32_t));
+  x[0] = inverse_word(ctx->m[0]);
+  for (size_t p = 1; p < n;) {
+    size_t p2 = 2 * p < n ? 2 * p : n;
+    // e = m·x (só os p2 limbs mais baixos importam)
+    mul_padded(e, ctx->m, x, p2);
+    // h = x·(e / B^p) mod B^(p2 - p)
+    mul_padded(h, x, e + p, p2 - p);
+    uint64_t carry = 1;
+    for (size_t i = 0; i < p2 - p; i++) {
+      uint64_t s = (uint64_t)(uint32_t)~h[i] + carry;
+      x[p + i] = (uint32_t)s;
+      carry = s >> 32;
+    }
+    p = p2;
+  }
+  free(e);
+  free(h);
+
+  // -x mod R
+  uint64_t carry = 1;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t s = (uint64_t)(uint32_t)~x[i] + carry;
+    x[i] = (uint32_t)s;
+    carry = s >> 32;
+  }
+  return 1;
+}
+
+// out = B^k mod m (out com n limbs). Retorna 0 se faltou memória
+static int power_of_base(const MontgomeryContext *ctx, uint32_t *out,
+                         size_t k) {
+  size_t n = ctx->n;
+  uint32_t *x = calloc(k + 1, sizeof(uint32_t));
+  uint32_t *q = malloc((k - n + 2) * sizeof(uint32_t));
+  int ok = x != NULL && q != NULL;
+  if (ok) {
+    x[k] = 1;
+    ok = limbs_divmod(q, out, x, k + 1, ctx->m, n);
+  }
+  free(x);
+  free(q);
+  return ok;
+}
+
+MontgomeryContext *montgomery_create(const uint32_t *m, size_t n) {
+  if (n == 0 || m[n - 1] == 0 || (m[0] & 1) == 0 || (n == 1 && m[0] < 3)) {
+    return NULL;
+  }
+  MontgomeryContext *ctx = calloc(1, sizeof(MontgomeryContext));
+  if (ctx == NULL) {
+    return NULL;
+  }
+  ctx->n = n;
+  ctx->m = malloc(n * sizeof(uint32_t));
+  ctx->one = malloc(n * sizeof(uint32_t));
+  ctx->r2 = malloc(n * sizeof(uint32_t));
+  ctx->tmp = malloc((6 * n + 2) * sizeof(uint32_t));
+  if (n >= MONTGOMERY_BULK_MIN) {
+    ctx->minv_all = malloc(n * sizeof(uint32_t));
+  }
+  if (ctx->m == NULL || ctx->one == NULL || ctx->r2 == NULL ||
+      ctx->tmp == NULL || (n >= MONTGOMERY_BULK_MIN && ctx->minv_all == NULL)) {
+    montgomery_destroy(ctx);
+    return NULL;
+  }
+  memcpy(ctx->m, m, n * sizeof(uint32_t));
+  ctx->minv = -inverse_word(m[0]);
+  if (!power_of_base(ctx, ctx->one, n) || !power_of_base(ctx, ctx->r2, 2 * n) ||
+      (ctx->minv_all != NULL && !inverse_all(ctx))) {
+    montgomery_destroy(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void montgomery_destroy(MontgomeryContext *ctx) {
+  if (ctx == NULL) {
+    return;
+  }
+  free(ctx->m);
+  free(ctx->minv_all);
+  free(ctx->one);
+  free(ctx->r2);
+  free(ctx->tmp);
+  free(ctx);
+}
+
+int montgomery_to(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                  size_t an) {
+  size_t n = ctx->n;
+  an = limbs_normalized_length(a, an);
+  uint32_t *r = calloc(n, sizeof(uint32_t));
+  if (r == NULL) {
+    return 0;
+  }
+  if (an < n) {
+    memcpy(r, a, an * sizeof(uint32_t));
+  } else {
+    uint32_t *q = malloc((an - n + 1) * sizeof(uint32_t));
+    int ok = q != NULL && limbs_divmod(q, r, a, an, ctx->m, n);
+    free(q);
+    if (!ok) {
+      free(r);
+      return 0;
+    }
+  }
+  montgomery_mul(ctx, out, r, ctx->r2);
+  free(r);
+  return 1;
+}
+
+void montgomery_from(MontgomeryContext *ctx, uint32_t *out,
+                     const uint32_t *a) {
+  // Multiplicar por 1 (fora da forma de Montgomery) divide por R. É uma
+  // chamada só, então CIOS basta em qualquer tamanho; o 1 fica na parte da
+  // área de trabalho que o CIOS não usa
+  uint32_t *unit = ctx->tmp + ctx->n + 2;
+  memset(unit, 0, ctx->n * sizeof(uint32_t));
+  unit[0] = 1;
+  mul_cios(ctx, out, a, unit);
+}
+
+void montgomery_add(const MontgomeryContext *ctx, uint32_t *out,
+                    const uint32_t *a, const uint32_t *b) {
+  size_t n = ctx->n;
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t s = (uint64_t)a[i] + b[i] + carry;
+    out[i] = (uint32_t)s;
+    carry = s >> 32;
+  }
+  if (carry != 0 || limbs_cmp(out, n, ctx->m, n) >= 0) {
+    subtract_modulus(ctx, out, out);
+  }
+}
+
+void montgomery_sub(const MontgomeryContext *ctx, uint32_t *out,
+                    const uint32_t *a, const uint32_t *b) {
+  size_t n = ctx->n;
+  uint32_t borrow = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+    out[i] = (uint32_t)d;
+    borrow = (uint32_t)(d >> 63);
+  }
+  if (borrow != 0) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+      uint64_t s = (uint64_t)out[i] + ctx->m[i] + carry;
+      out[i] = (uint32_t)s;
+      carry = s >> 32;
+    }
+  }
+}
+
+int montgomery_pow(MontgomeryContext *ctx, uint32_t *out, const uint32_t *base,
+                   const uint32_t *e, size_t en) {
+  size_t n = ctx->n;
+  size_t entries = (size_t)1 << MONTGOMERY_WINDOW;
+  uint32_t *table = malloc((entries + 1) * n * sizeof(uint32_t));
+  if (table == NULL) {
+    return 0;
+  }
+  // table[i] = base^i; acc fica depois da tabela
+  uint32_t *acc = table + entries * n;
+  memcpy(table, ctx->one, n * sizeof(uint32_t));
+  memcpy(table + n, base, n * sizeof(uint32_t));
+  for (size_t i = 2; i < entries; i++) {
+    montgomery_mul(ctx, table + i * n, table + (i - 1) * n, base);
+  }
+
+  memcpy(acc, ctx->one, n * sizeof(uint32_t));
+  en = limbs_normalized_length(e, en);
+  int started = 0;
+  for (size_t i = en; i-- > 0;) {
+    if (exec_checkpoint(NULL, 0, 0)) {
+      free(table);
+      return 0;
+    }
+    for (int shift = 32 - MONTGOMERY_WINDOW; shift >= 0;
+         shift -= MONTGOMERY_WINDOW) {
+      uint32_t window = (e[i] >> shift) & (uint32_t)(entries - 1);
+      if (started) {
+        for (int k = 0; k < MONTGOMERY_WINDOW; k++) {
+          montgomery_mul(ctx, acc, acc, acc);
+        }
+      }
+      if (window != 0) {
+        montgomery_mul(ctx, acc, acc, table + window * n);
+        started = 1;
+      }
+    }
+  }
+  memcpy(out, acc, n * sizeof(uint32_t));
+  free(table);
+  return 1;
+}
@@ -0,0 +1,59 @@
+#ifndef MONTGOMERY_H
+#define MONTGOMERY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Aritmética modular na forma de Montgomery para módulos ímpares de vários
+// limbs. Um resíduo x é guardado como x·R mod m (R = 2^(32n)) e o produto
+// a·b·R^-1 mod m troca a divisão por m por multiplicações e deslocamentos
+// de limbs inteiros: módulos pequenos usam o produto intercalado com a
+// redução (CIOS, limb a limb); a partir de MONTGOMERY_BULK_MIN limbs o
+// produto e a redução usam limbs_mul (Karatsuba/NTT) com -m^-1 mod R inteiro
+// Todos os resíduos têm exatamente n limbs e ficam em [0, m)
+
+// A partir deste tamanho do módulo a redução é feita em bloco (as três
+// multiplicações completas só ganham do CIOS perto de 6000 bits)
+#define MONTGOMERY_BULK_MIN 176
+
+typedef struct {
+  uint32_t *m;        // Módulo ímpar (n limbs, m[n - 1] != 0)
+  size_t n;           // Limbs do módulo
+  uint32_t minv;      // -m^-1 mod 2^32
+  uint32_t *minv_all; // -m^-1 mod R (só na redução em bloco)
+  uint32_t *one;      // R mod m (1 na forma de Montgomery)
+  uint32_t *r2;       // R^2 mod m
+  uint32_t *tmp;      // Área de trabalho: o contexto é de uma thread por vez
+} MontgomeryContext;
+
+// Cria o contexto do módulo m (n limbs, normalizado). Retorna NULL se m for
+// par ou menor que 3, ou se faltou memória
+MontgomeryContext *montgomery_create(const uint32_t *m, size_t n);
+
+void montgomery_destroy(MontgomeryContext *ctx);
+
+// out = a·R mod m, com a de an limbs (qualquer tamanho)
+// Retorna 0 se faltou memória
+int montgomery_to(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                  size_t an);
+
+// out = a·R^-1 mod m (volta da forma de Montgomery)
+void montgomery_from(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a);
+
+// out = a·b·R^-1 mod m; out pode ser igual a a ou b
+void montgomery_mul(MontgomeryContext *ctx, uint32_t *out, const uint32_t *a,
+                    const uint32_t *b);
+
+// out = a + b mod m e out = a - b mod m; out pode ser igual a a ou b
+void montgomery_add(const MontgomeryContext *ctx, uint32_t *out,
+                    const uint32_t *a, const uint32_t *b);
+void montgomery_sub(const MontgomeryContext *ctx, uint32_t *out,
+                    const uint32_t *a, const uint32_t *b);
+
+// out = base^e (base e out na forma de Montgomery, e com en limbs), por
+// janelas fixas de 4 bits. out pode ser igual a base
+// Retorna 0 se faltou memória ou se o ExecContext pediu para parar
+int montgomery_pow(MontgomeryContext *ctx, uint32_t *out, const uint32_t *base,
+                   const uint32_t *e, size_t en);
+
+#endif // MONTGOMERY_H
@@ -0,0 +1,327 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "OutOfCore.h"
+#include "../ExecContext/ExecContext.h"
+#include "../InputFile/InputFile.h"
+#include "../Limbs/Limbs.h"
+#include "../Radix/Radix.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Limbs percorridos entre dois pontos de verificação (64 MB)
+#define OOC_WINDOW_LIMBS ((size_t)1 << 24)
+
+// Menor bloco da multiplicação, mesmo com orçamento muito pequeno
+#define OOC_MIN_BLOCK_LIMBS 1024
+
+// Bytes por limb de bloco na multiplicação: com B potência de 2, a NTT de
+// dois blocos tem exatamente 4B pontos de 8 bytes em cada operando, mais 2B
+// raízes (80B bytes), e o produto ocupa 8B bytes
+#define OOC_BYTES_PER_BLOCK_LIMB 88
+
+// Pede ao kernel para começar a gravar os limbs [begin, end) da saída
+// (msync exige endereço alinhado à página)
+static void flush_window(const BigIntWriter *w, size_t begin, size_t end) {
+  long page = sysconf(_SC_PAGESIZE);
+  uintptr_t first = (uintptr_t)(w->limbs + begin);
+  uintptr_t aligned = first - first % (uintptr_t)(page > 0 ? page : 4096);
+  msync((void *)aligned, (uintptr_t)(w->limbs + end) - aligned, MS_ASYNC);
+}
+
+// Fim da janela que começa em begin, limitado a n
+static size_t window_end(size_t begin, size_t n) {
+  return n - begin > OOC_WINDOW_LIMBS ? begin + OOC_WINDOW_LIMBS : n;
+}
+
+// Limbs do arquivo sem os zerados do topo
+static size_t view_length(const BigIntView *v) {
+  return limbs_normalized_length(v->limbs, v->count);
+}
+
+int bigint_file_compare(const BigIntView *a, const BigIntView *b) {
+  if (a == NULL || b == NULL) {
+    return 0;
+  }
+
+  size_t an = view_length(a);
+  size_t bn = view_length(b);
+  int a_sign = an == 0 ? 0 : a->sign;
+  int b_sign = bn == 0 ? 0 : b->sign;
+  if (a_sign != b_sign) {
+    return a_sign > b_sign ? 1 : -1;
+  }
+  // Do limb mais significativo para o menos: para na primeira diferença
+  return a_sign * limbs_cmp(a->limbs, an, b->limbs, bn);
+}
+
+// Saída = a + b (an >= bn); a saída tem an + 1 limbs
+static int add_stream(BigIntWriter *w, const uint32_t *a, size_t an,
+                      const uint32_t *b, size_t bn) {
+  uint64_t carry = 0;
+  for (size_t begin = 0; begin < an; begin += OOC_WINDOW_LIMBS) {
+    if (exec_checkpoint("soma", begin, an)) {
+      return 0;
+    }
+    size_t end = window_end(begin, an);
+    for (size_t i = begin; i < end; i++) {
+      carry += (uint64_t)a[i] + (i < bn ? b[i] : 0);
+      w->limbs[i] = (uint32_t)carry;
+      carry >>= 32;
+    }
+    flush_window(w, begin, end);
+  }
+  w->limbs[an] = (uint32_t)carry;
+  return 1;
+}
+
+// Saída = a - b (|a| >= |b|, an >= bn); a saída tem an limbs
+static int sub_stream(BigIntWriter *w, const uint32_t *a, size_t an,
+                      const uint32_t *b, size_t bn) {
+  uint64_t borrow = 0;
+  for (size_t begin = 0; begin < an; begin += OOC_WINDOW_LIMBS) {
+    if (exec_checkpoint("subtracao", begin, an)) {
+      return 0;
+    }
+    size_t end = window_end(begin, an);
+    for (size_t i = begin; i < end; i++) {
+      uint64_t sub = (uint64_t)(i < bn ? b[i] : 0) + borrow;
+      w->limbs[i] = (uint32_t)((uint64_t)a[i] - sub);
+      borrow = a[i] < sub;
+    }
+    flush_window(w, begin, end);
+  }
+  return 1;
+}
+
+// Grava a + b_sign * |b| em path
+static int add_signed(const BigIntView *a, const BigIntView *b, int b_sign,
+                      const char *path) {
+  if (a == NULL || b == NULL || path == NULL) {
+    return 0;
+  }
+
+  const uint32_t *x = a->limbs;
+  const uint32_t *y = b->limbs;
+  size_t xn = view_length(a);
+  size_t yn = view_length(b);
+  int sign = xn == 0 ? b_sign : a->sign;
+  int same = xn == 0 || yn == 0 || a->sign == b_sign;
+
+  // Mantém x como o operando de maior magnitude
+  int swap = same ? xn < yn : limbs_cmp(x, xn, y, yn) < 0;
+  if (swap) {
+    const uint32_t *tp = x;
+    x = y;
+    y = tp;
+    size_t tn = xn;
+    xn = yn;
+    yn = tn;
+    if (!same) {
+      sign = b_sign;
+    }
+  }
+
+  BigIntWriter w;
+  if (!bigint_writer_open(path, same ? xn + 1 : xn, &w)) {
+    return 0;
+  }
+  posix_madvise(w.map, w.map_size, POSIX_MADV_SEQUENTIAL);
+  w.sign = sign;
+
+  int ok = same ? add_stream(&w, x, xn, y, yn) : sub_stream(&w, x, xn, y, yn);
+  if (!ok) {
+    bigint_writer_abort(&w);
+    return 0;
+  }
+  return bigint_writer_close(&w);
+}
+
+int bigint_file_sum(const BigIntView *a, const BigIntView *b,
+                    const char *path) {
+  return b != NULL ? add_signed(a, b, b->sign, path) : 0;
+}
+
+int bigint_file_subtract(const BigIntView *a, const BigIntView *b,
+                         const char *path) {
+  return b != NULL ? add_signed(a, b, -b->sign, path) : 0;
+}
+
+// Soma src (len limbs) em out a partir de offset, propagando o carry
+static void add_at(uint32_t *out, size_t out_len, const uint32_t *src,
+                   size_t len, size_t offset) {
+  uint64_t carry = 0;
+  size_t i = 0;
+
+  for (; i < len; i++) {
+    uint64_t cur = (uint64_t)out[offset + i] + src[i] + carry;
+    out[offset + i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  for (size_t k = offset + i; carry > 0 && k < out_len; k++) {
+    uint64_t cur = (uint64_t)out[k] + carry;
+    out[k] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+}
+
+// Maior bloco (potência de 2) cujo produto cabe no orçamento
+static size_t block_limbs(size_t memory_mb) {
+  size_t budget = (memory_mb > 0 ? memory_mb : OOC_DEFAULT_MEMORY_MB) << 20;
+  size_t block = OOC_MIN_BLOCK_LIMBS;
+  while (2 * block * OOC_BYTES_PER_BLOCK_LIMB <= budget) {
+    block *= 2;
+  }
+  return block;
+}
+
+// Multiplicação em blocos: a linha i soma a_i * b_j na posição (i + j) * B
+// para cada bloco b_j. Depois da linha i, os limbs abaixo de (i + 1) * B
+// não mudam mais e podem ir para o disco
+int bigint_file_multiply(const BigIntView *a, const BigIntView *b,
+                         const char *path, size_t memory_mb) {
+  if (a == NULL || b == NULL || path == NULL) {
+    return 0;
+  }
+
+  size_t an = view_length(a);
+  size_t bn = view_length(b);
+  size_t n = an > 0 && bn > 0 ? an + bn : 0;
+  size_t block = block_limbs(memory_mb);
+  uint32_t *prod = malloc(2 * block * sizeof(uint32_t));
+  BigIntWriter w;
+  if (prod == NULL || !bigint_writer_open(path, n, &w)) {
+    free(prod);
+    return 0;
+  }
+  w.sign = a->sign * b->sign;
+
+  size_t rows = n > 0 ? (an + block - 1) / block : 0;
+  size_t cols = (bn + block - 1) / block;
+  int ok = 1;
+  for (size_t i = 0; ok && i < rows; i++) {
+    size_t ai = i * block;
+    size_t ain = an - ai < block ? an - ai : block;
+    for (size_t j = 0; ok && j < cols; j++) {
+      if (exec_checkpoint("multiplicacao", i * cols + j, rows * cols)) {
+        ok = 0;
+        break;
+      }
+      size_t bj = j * block;
+      size_t bjn = bn - bj < block ? bn - bj : block;
+      limbs_mul(prod, a->limbs + ai, ain, b->limbs + bj, bjn);
+      add_at(w.limbs, n, prod, ain + bjn, ai + bj);
+    }
+    size_t done = ai + block < n ? ai + block : n;
+    flush_window(&w, ai, done);
+  }
+  free(prod);
+
+  if (!ok) {
+    bigint_writer_abort(&w);
+    return 0;
+  }
+  return bigint_writer_close(&w);
+}
+
+int bigint_file_to_decimal(const BigIntView *a, const char *path) {
+  if (a == NULL || path == NULL) {
+    return 0;
+  }
+
+  // Como no BigIntWriter, o texto é escrito em um temporário que só
+  // substitui path no fim: path pode ser o próprio arquivo mapeado de a
+  char *temp_path;
+  int fd = bigint_temp_open(path, &temp_path);
+  if (fd < 0) {
+    return 0;
+  }
+
+  // Espaço para o sinal, os dígitos e o '\n'; o excesso é cortado no fim
+  size_t n = view_length(a);
+  size_t size = radix_decimal_capacity(n) + 2;
+  char *text = MAP_FAILED;
+  if (ftruncate(fd, (off_t)size) == 0) {
+    text = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  if (text == MAP_FAILED) {
+    close(fd);
+    unlink(temp_path);
+    free(temp_path);
+    return 0;
+  }
+
+  // Os dígitos terminam no fim do mapeamento e depois são movidos para o
+  // início (uma passada sequencial)
+  char *end = text + size - 1;
+  char *first = radix_write_decimal(end, a->limbs, n);
+  size_t len = 0;
+  if (first != NULL) {
+    if (a->sign < 0 && n > 0) {
+      *--first = '-';
+    }
+    len = (size_t)(end - first);
+    memmove(text, first, len);
+    text[len++] = '\n';
+  }
+
+  int ok = first != NULL && msync(text, size, MS_SYNC) == 0;
+  munmap(text, size);
+  ok = ftruncate(fd, (off_t)len) == 0 && ok;
+  ok = close(fd) == 0 && ok;
+  ok = ok && rename(temp_path, path) == 0;
+  if (!ok) {
+    unlink(temp_path);
+  }
+  free(temp_path);
+  return ok;
+}
+
+int bigint_file_from_decimal(const char *text_path, const char *path) {
+  InputFile in;
+  if (text_path == NULL || path == NULL || !inputfile_open(text_path, &in)) {
+    return 0;
+  }
+
+  // Mesmo formato de bigint_create_from_chars: sinal opcional e dígitos até
+  // o primeiro caractere que não for dígito
+  size_t pos = 0;
+  const char *token = NULL;
+  size_t len = 0;
+  int sign = 1;
+  size_t digits = 0;
+  if (inputfile_next_token(in.data, in.size, &pos, &token, &len)) {
+    if (*token == '+' || *token == '-') {
+      sign = *token == '-' ? -1 : 1;
+      token++;
+      len--;
+    }
+    while (digits < len && token[digits] >= '0' && token[digits] <= '9') {
+      digits++;
+    }
+    while (digits > 1 && *token == '0') {
+      token++;
+      digits--;
+    }
+  }
+
+  size_t n = 0;
+  uint32_t *limbs = digits > 0 ? radix_read_decimal(token, digits, &n) : NULL;
+  inputfile_close(&in);
+  if (limbs == NULL) {
+    return 0;
+  }
+
+  BigIntWriter w;
+  int ok = bigint_writer_open(path, n, &w);
+  if (ok) {
+    memcpy(w.limbs, limbs, n * sizeof(uint32_t));
+    w.sign = sign;
+    ok = bigint_writer_close(&w);
+  }
+  free(limbs);
+  return ok;
+}
@@ -0,0 +1,50 @@
+#ifndef OUTOFCORE_H
+#define OUTOFCORE_H
+
+#include "../BigIntSerial/BigIntSerial.h"
+#include <stddef.h>
+
+// Aritmética out-of-core sobre arquivos binários (formato de src/BigIntSerial)
+// Os operandos são abertos com bigint_view_open (mmap somente leitura) e o
+// resultado é escrito direto no arquivo de saída mapeado (BigIntWriter), sem
+// passar por BigInt nem LinkedList: o tamanho dos números é limitado pelo
+// disco, e não pela RAM. As páginas mapeadas ficam no page cache, e o kernel
+// as lê e devolve ao disco conforme a memória disponível
+//
+// Soma, subtração e comparação percorrem os limbs uma única vez, em ordem
+// (o mapeamento é marcado como sequencial). A multiplicação é feita em
+// blocos: cada par de blocos cabe no orçamento de memória, é multiplicado
+// em RAM por limbs_mul (NTT para blocos grandes) e o produto é somado na
+// sua posição do arquivo de saída
+// A saída só substitui o destino quando fica pronta (arquivo temporário e
+// rename), então o destino pode ser um dos operandos (ex.: acc = acc + b)
+// Os laços chamam exec_checkpoint: um ExecContext com prazo ou cancelamento
+// interrompe a operação, e o destino não é alterado
+
+// Orçamento de memória padrão da multiplicação em blocos
+#define OOC_DEFAULT_MEMORY_MB 256
+
+// Compara os valores. Retorna: 1 se a > b, 0 se a == b, -1 se a < b
+int bigint_file_compare(const BigIntView *a, const BigIntView *b);
+
+// Grava a + b, a - b ou a * b em path. Retorna 1 em sucesso, 0 em erro
+int bigint_file_sum(const BigIntView *a, const BigIntView *b,
+                    const char *path);
+int bigint_file_subtract(const BigIntView *a, const BigIntView *b,
+                         const char *path);
+
+// memory_mb limita a memória de cada produto de blocos (0: padrão). A NTT
+// de um par de blocos de B limbs usa cerca de 88 * B bytes
+int bigint_file_multiply(const BigIntView *a, const BigIntView *b,
+                         const char *path, size_t memory_mb);
+
+// Grava o valor em decimal (com '\n' no fim) direto no arquivo de texto
+// mapeado. A conversão em si (src/Radix) precisa de memória da ordem do
+// tamanho do número
+int bigint_file_to_decimal(const BigIntView *a, const char *path);
+
+// Converte o primeiro número de um arquivo de texto para o formato binário
+// Os limbs convertidos ficam em RAM antes de ir para o arquivo
+int bigint_file_from_decimal(const char *text_path, const char *path);
+
+#endif // OUTOFCORE_H
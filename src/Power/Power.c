@@ -0,0 +1,286 @@
+#include "Power.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Limbs/Limbs.h"
+#include "../Scheduler/Scheduler.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A partir deste tamanho (limbs de F(k)) os dois quadrados de cada passo de
+// Fibonacci viram tarefas
+#define FIB_PARALLEL_MIN 2048
+
+// Lê um BigInt não negativo que cabe em um limb
+static int bigint_to_word(const BigInt *bi, uint32_t *value) {
+  if (bi == NULL || bi->digits == NULL ||
+      linkedlist_length(bi->digits) != 1) {
+    return 0;
+  }
+  *value = bi->digits->head->value;
+  return bi->sign == 1 || *value == 0;
+}
+
+static size_t bit_length(const uint32_t *a, size_t an) {
+  if (an == 0) {
+    return 0;
+  }
+  size_t bits = 32 * (an - 1);
+  for (uint32_t top = a[an - 1]; top != 0; top >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// a^e com e >= 0 de até 32 bits. a^e tem no máximo e·bits(a) bits; com a
+// folga de 3 limbs cabem também os produtos intermediários, que os kernels
+// escrevem com o comprimento cheio (2·cn e cn + an limbs). Dois buffers
+// desse tamanho são alternados entre os passos
+BigInt *bigint_pow(const BigInt *a, const BigInt *e) {
+  uint32_t exp;
+  if (a == NULL || !bigint_to_word(e, &exp)) {
+    return NULL;
+  }
+
+  size_t an = 0;
+  uint32_t *al = bigint_export_limbs(a, &an);
+  if (al == NULL) {
+    return NULL;
+  }
+  an = limbs_normalized_length(al, an);
+  int sign = a->sign < 0 && (exp & 1) ? -1 : 1;
+  if (exp == 0 || an == 0) {
+    free(al);
+    return bigint_create_from_int(exp == 0 ? 1 : 0);
+  }
+  size_t bits = bit_length(al, an);
+  if (bits / 32 + 1 > (SIZE_MAX / sizeof(uint32_t) - 3) / exp) {
+    free(al);
+    return NULL;
+  }
+
+  size_t cap = bits / 32 * exp + bits % 32 * exp / 32 + 3;
+  uint32_t *cur = malloc(cap * sizeof(uint32_t));
+  uint32_t *tmp = malloc(cap * sizeof(uint32_t));
+  BigInt *result = NULL;
+  if (cur != NULL && tmp != NULL) {
+    memcpy(cur, al, an * sizeof(uint32_t));
+    size_t cn = an;
+    int top = 31;
+    while (!((exp >> top) & 1)) {
+      top--;
+    }
+    int stopped = 0;
+    for (int bit = top - 1; bit >= 0; bit--) {
+      if (exec_checkpoint("potencia", (size_t)(top - 1 - bit), (size_t)top)) {
+        stopped = 1;
+        break;
+      }
+      limbs_mul(tmp, cur, cn, cur, cn);
+      cn = limbs_normalized_length(tmp, 2 * cn);
+      uint32_t *t = cur;
+      cur = tmp;
+      tmp = t;
+      if ((exp >> bit) & 1) {
+        limbs_mul(tmp, cur, cn, al, an);
+        cn = limbs_normalized_length(tmp, cn + an);
+        t = cur;
+        cur = tmp;
+        tmp = t;
+      }
+    }
+    result = stopped ? NULL : bigint_import_limbs(cur, cn, sign);
+  }
+  free(al);
+  free(cur);
+  free(tmp);
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// Fibonacci e Lucas
+// ---------------------------------------------------------------------------
+
+// out = a + b (out com max(an, bn) + 1 limbs; pode ser igual a a ou b)
+// Retorna o comprimento normalizado
+static size_t add_limbs(uint32_t *out, const uint32_t *a, size_t an,
+                        const uint32_t *b, size_t bn) {
+  if (an < bn) {
+    const uint32_t *t = a;
+    a = b;
+    b = t;
+    size_t tn = an;
+    an = bn;
+    bn = tn;
+  }
+  uint64_t carry = 0;
+  for (size_t i = 0; i < an; i++) {
+    uint64_t cur = (uint64_t)a[i] + (i < bn ? b[i] : 0) + carry;
+    out[i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  out[an] = (uint32_t)carry;
+  return limbs_normalized_length(out, an + 1);
+}
+
+// a = a·4 + d (d = +2 ou -2, com o resultado positivo), no próprio array
+// (a com an + 1 limbs). Retorna o comprimento normalizado
+static size_t times4_add(uint32_t *a, size_t an, int d) {
+  uint32_t carry = 0;
+  for (size_t i = 0; i < an; i++) {
+    uint32_t next = a[i] >> 30;
+    a[i] = (a[i] << 2) | carry;
+    carry = next;
+  }
+  a[an] = carry;
+  an++;
+  if (d > 0) {
+    for (size_t i = 0; i < an; i++) {
+      uint32_t add = i == 0 ? (uint32_t)d : 1;
+      a[i] += add;
+      if (a[i] >= add) {
+        break;
+      }
+    }
+  } else {
+    for (size_t i = 0; i < an; i++) {
+      uint32_t sub = i == 0 ? (uint32_t)-d : 1;
+      uint32_t old = a[i];
+      a[i] -= sub;
+      if (old >= sub) {
+        break;
+      }
+    }
+  }
+  return limbs_normalized_length(a, an);
+}
+
+typedef struct {
+  uint32_t *out;
+  const uint32_t *a;
+  size_t an;
+  size_t n; // Comprimento normalizado do quadrado
+} SquareJob;
+
+static void square_task(void *arg) {
+  SquareJob *job = arg;
+  job->n = 0;
+  if (job->an > 0) {
+    limbs_mul(job->out, job->a, job->an, job->a, job->an);
+    job->n = limbs_normalized_length(job->out, 2 * job->an);
+  }
+}
+
+// Calcula F(n) e F(n-1) (n >= 1) em f e g, que devem ter cap limbs
+// Retorna 0 se faltou memória ou se o ExecContext pediu para parar
+static int fib_pair(uint32_t n, size_t cap, uint32_t **f, size_t *fn,
+                    uint32_t **g, size_t *gn) {
+  // Quatro buffers: F(k), F(k-1) e os dois quadrados. A cada passo os dois
+  // que sobram viram os quadrados do passo seguinte
+  uint32_t *buf[4];
+  for (int i = 0; i < 4; i++) {
+    buf[i] = malloc(cap * sizeof(uint32_t));
+  }
+  if (buf[0] == NULL || buf[1] == NULL || buf[2] == NULL || buf[3] == NULL) {
+    for (int i = 0; i < 4; i++) {
+      free(buf[i]);
+    }
+    return 0;
+  }
+
+  uint32_t *fk = buf[0], *fk1 = buf[1], *sa = buf[2], *sb = buf[3];
+  size_t fkn = 1, fk1n = 0;
+  fk[0] = 1; // k = 1: F(1) = 1, F(0) = 0
+  int odd = 1;
+  int top = 31;
+  while (!((n >> top) & 1)) {
+    top--;
+  }
+  for (int bit = top - 1; bit >= 0; bit--) {
+    if (exec_checkpoint("fibonacci", (size_t)(top - 1 - bit), (size_t)top)) {
+      for (int i = 0; i < 4; i++) {
+        free(buf[i]);
+      }
+      return 0;
+    }
+    SquareJob ja = {sa, fk, fkn, 0};
+    SquareJob jb = {sb, fk1, fk1n, 0};
+    scheduler_fork_join(square_task, &ja, square_task, &jb,
+                        fkn >= FIB_PARALLEL_MIN);
+
+    // F(2k-1) = F(k)^2 + F(k-1)^2 no buffer de F(k-1)
+    size_t m1n = add_limbs(fk1, sa, ja.n, sb, jb.n);
+    // F(2k+1) = 4·F(k)^2 - F(k-1)^2 + 2·(-1)^k no buffer de F(k)^2
+    size_t p1n = times4_add(sa, ja.n, odd ? -2 : 2);
+    limbs_sub(sa, sa, p1n, sb, jb.n);
+    p1n = limbs_normalized_length(sa, p1n);
+    // F(2k) = F(2k+1) - F(2k-1) no buffer de F(k)
+    memcpy(fk, sa, p1n * sizeof(uint32_t));
+    limbs_sub(fk, fk, p1n, fk1, m1n);
+    size_t evenn = limbs_normalized_length(fk, p1n);
+
+    uint32_t *spare = sb;
+    if ((n >> bit) & 1) {
+      // k' = 2k + 1: (F(2k+1), F(2k))
+      sb = fk1;
+      fk1 = fk;
+      fk1n = evenn;
+      fk = sa;
+      fkn = p1n;
+      sa = spare;
+      odd = 1;
+    } else {
+      // k' = 2k: (F(2k), F(2k-1))
+      fkn = evenn;
+      fk1n = m1n;
+      odd = 0;
+    }
+  }
+
+  // Libera os dois buffers que não são resultado
+  for (int i = 0; i < 4; i++) {
+    if (buf[i] != fk && buf[i] != fk1) {
+      free(buf[i]);
+    }
+  }
+  *f = fk;
+  *fn = fkn;
+  *g = fk1;
+  *gn = fk1n;
+  return 1;
+}
+
+// F(n) (lucas == 0) ou L(n) (lucas != 0)
+static BigInt *fib_or_lucas(const BigInt *nb, int lucas) {
+  uint32_t n;
+  if (!bigint_to_word(nb, &n)) {
+    return NULL;
+  }
+  if (n == 0) {
+    return bigint_create_from_int(lucas ? 2 : 0);
+  }
+
+  // F(n) < φ^n e L(n) < φ^(n+1): log2(φ) = 0.694 < 0.7 bits por passo.
+  // Os quadrados têm 2·(limbs de F(k)) com 2k <= n, e F(2k+1) tem mais um
+  // limb antes da subtração
+  size_t cap = (size_t)n * 7 / 320 + 8;
+  uint32_t *f, *g;
+  size_t fn, gn;
+  if (!fib_pair(n, cap, &f, &fn, &g, &gn)) {
+    return NULL;
+  }
+
+  BigInt *result;
+  if (lucas) {
+    // L(n) = F(n) + 2·F(n-1), com 2·F(n-1) no buffer de F(n-1)
+    gn = add_limbs(g, g, gn, g, gn);
+    fn = add_limbs(f, f, fn, g, gn);
+  }
+  result = bigint_import_limbs(f, fn, 1);
+  free(f);
+  free(g);
+  return result;
+}
+
+BigInt *bigint_fib(const BigInt *n) { return fib_or_lucas(n, 0); }
+
+BigInt *bigint_lucas(const BigInt *n) { return fib_or_lucas(n, 1); }
@@ -0,0 +1,31 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include "../BigInt/BigInt.h"
+
+// Potências e sequências de Fibonacci e Lucas
+// Os buffers são alocados uma única vez com o tamanho final estimado (bits
+// da base vezes o expoente, ou n·log2(φ) para Fibonacci) e reaproveitados
+// em todos os passos; cada passo é um ou dois quadrados com os kernels de
+// Limbs (Karatsuba/NTT), então o custo total fica perto do de algumas
+// multiplicações do tamanho do resultado
+
+// a^e por exponenciação binária da esquerda para a direita: um quadrado por
+// bit de e e uma multiplicação por a nos bits 1 (0^0 = 1)
+// Retorna NULL se e for negativo ou não couber em 32 bits
+BigInt *bigint_pow(const BigInt *a, const BigInt *e);
+
+// n-ésimo número de Fibonacci (F(0) = 0, F(1) = 1) por duplicação rápida,
+// com dois quadrados por bit de n:
+//   F(2k-1) = F(k)^2 + F(k-1)^2
+//   F(2k+1) = 4·F(k)^2 - F(k-1)^2 + 2·(-1)^k
+//   F(2k)   = F(2k+1) - F(2k-1)
+// Dentro de um worker do Scheduler os dois quadrados de números grandes
+// rodam em paralelo. Retorna NULL se n for negativo ou não couber em 32 bits
+BigInt *bigint_fib(const BigInt *n);
+
+// n-ésimo número de Lucas (L(0) = 2, L(1) = 1), L(n) = F(n) + 2·F(n-1),
+// pelo mesmo cálculo de bigint_fib
+BigInt *bigint_lucas(const BigInt *n);
+
+#endif // POWER_H
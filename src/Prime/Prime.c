@@ -0,0 +1,692 @@
+#include "Prime.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Limbs/Limbs.h"
+#include "../Montgomery/Montgomery.h"
+#include "../Roots/Roots.h"
+#include "../Scheduler/Scheduler.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A tabela tem os primos ímpares abaixo deste limite (a raiz de 2^32)
+#define PRIME_TABLE_LIMIT 65536
+
+// A divisão por tentativa vai até os primos menores que 16 vezes os bits
+// de n (entre 1024 e o limite da tabela): números maiores compensam mais
+// divisões antes das exponenciações
+#define PRIME_TRIAL_PER_BIT 16
+#define PRIME_TRIAL_MIN 1024
+
+// Candidatos ímpares por janela da peneira de bigint_next_prime
+#define PRIME_SIEVE_WINDOW 4096
+
+// Valores de D tentados antes de verificar se n é quadrado perfeito (para um
+// quadrado, (D/n) nunca é -1 e a busca de Selfridge não terminaria)
+#define PRIME_SQUARE_CHECK 8
+
+// Maior primo abaixo de 2^32
+#define PRIME_LARGEST_WORD 4294967291u
+
+static uint32_t *small_primes; // Primos ímpares < PRIME_TABLE_LIMIT
+static size_t small_count;
+// Primos consecutivos agrupados enquanto o produto cabe em um limb: a
+// divisão por tentativa faz uma passada sobre n por grupo
+static uint32_t *group_product;
+static size_t *group_end; // Índice depois do último primo de cada grupo
+static size_t group_count;
+static pthread_once_t table_once = PTHREAD_ONCE_INIT;
+
+static void table_init(void) {
+  unsigned char *composite = calloc(PRIME_TABLE_LIMIT, 1);
+  if (composite == NULL) {
+    return;
+  }
+  size_t count = 0;
+  for (uint32_t i = 3; i < PRIME_TABLE_LIMIT; i += 2) {
+    if (!composite[i]) {
+      count++;
+      for (uint32_t j = i * i; j < PRIME_TABLE_LIMIT; j += 2 * i) {
+        composite[j] = 1;
+      }
+    }
+  }
+  uint32_t *primes = malloc(count * sizeof(uint32_t));
+  uint32_t *products = malloc(count * sizeof(uint32_t));
+  size_t *ends = malloc(count * sizeof(size_t));
+  if (primes == NULL || products == NULL || ends == NULL) {
+    free(primes);
+    free(products);
+    free(ends);
+    free(composite);
+    return;
+  }
+  size_t k = 0;
+  for (uint32_t i = 3; i < PRIME_TABLE_LIMIT; i += 2) {
+    if (!composite[i]) {
+      primes[k++] = i;
+    }
+  }
+  free(composite);
+
+  size_t groups = 0;
+  uint64_t product = 1;
+  for (size_t i = 0; i < count; i++) {
+    if (product * primes[i] > UINT32_MAX) {
+      products[groups] = (uint32_t)product;
+      ends[groups++] = i;
+      product = 1;
+    }
+    product *= primes[i];
+  }
+  products[groups] = (uint32_t)product;
+  ends[groups++] = count;
+
+  small_primes = primes;
+  small_count = count;
+  group_product = products;
+  group_end = ends;
+  group_count = groups;
+}
+
+static int table_ready(void) {
+  pthread_once(&table_once, table_init);
+  return small_primes != NULL;
+}
+
+const uint32_t *prime_table(size_t *count) {
+  *count = table_ready() ? small_count : 0;
+  return small_primes;
+}
+
+static size_t bit_length(const uint32_t *a, size_t an) {
+  if (an == 0) {
+    return 0;
+  }
+  size_t bits = 32 * (an - 1);
+  for (uint32_t top = a[an - 1]; top != 0; top >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// Resto de a por d (sem quociente)
+static uint32_t mod_word(const uint32_t *a, size_t an, uint32_t d) {
+  uint64_t r = 0;
+  for (size_t i = an; i-- > 0;) {
+    r = ((r << 32) | a[i]) % d;
+  }
+  return (uint32_t)r;
+}
+
+// Quantidade de grupos da tabela usados para um número de bits bits
+static size_t trial_groups(size_t bits) {
+  size_t limit = bits * PRIME_TRIAL_PER_BIT;
+  if (limit < PRIME_TRIAL_MIN) {
+    limit = PRIME_TRIAL_MIN;
+  }
+  size_t g = 0;
+  while (g < group_count && small_primes[group_end[g] - 1] < limit) {
+    g++;
+  }
+  return g < group_count ? g + 1 : group_count;
+}
+
+// Teste exato para n < 2^32: divisão pela tabela até a raiz
+static int is_prime_word(uint32_t n) {
+  if (n < 4) {
+    return n >= 2;
+  }
+  if ((n & 1) == 0) {
+    return 0;
+  }
+  for (size_t i = 0; i < small_count; i++) {
+    uint32_t p = small_primes[i];
+    if ((uint64_t)p * p > n) {
+      return 1;
+    }
+    if (n % p == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Símbolo de Jacobi (a/m) para m ímpar
+static int jacobi_word(uint32_t a, uint32_t m) {
+  int result = 1;
+  a %= m;
+  while (a != 0) {
+    while ((a & 1) == 0) {
+      a >>= 1;
+      if ((m & 7) == 3 || (m & 7) == 5) {
+        result = -result;
+      }
+    }
+    uint32_t t = a;
+    a = m;
+    m = t;
+    if ((a & 3) == 3 && (m & 3) == 3) {
+      result = -result;
+    }
+    a %= m;
+  }
+  return m == 1 ? result : 0;
+}
+
+// (D/n) para D ímpar pequeno e n ímpar de vários limbs, por reciprocidade:
+// (-1/n) depende de n mod 4 e (|D|/n) = (n mod |D| / |D|) com o sinal da
+// lei de reciprocidade quadrática
+static int jacobi(int64_t d, const uint32_t *n, size_t nn) {
+  uint32_t ad = (uint32_t)(d < 0 ? -d : d);
+  int result = jacobi_word(mod_word(n, nn, ad), ad);
+  if ((ad & 3) == 3 && (n[0] & 3) == 3) {
+    result = -result;
+  }
+  if (d < 0 && (n[0] & 3) == 3) {
+    result = -result;
+  }
+  return result;
+}
+
+// Desloca a para a direita em s bits (no próprio array)
+static void shift_right(uint32_t *a, size_t an, size_t s) {
+  size_t words = s / 32;
+  unsigned bits = (unsigned)(s % 32);
+  for (size_t i = 0; i < an; i++) {
+    uint64_t lo = i + words < an ? a[i + words] : 0;
+    uint64_t hi = i + words + 1 < an ? a[i + words + 1] : 0;
+    a[i] = (uint32_t)((lo | (hi << 32)) >> bits);
+  }
+}
+
+static size_t trailing_zeros(const uint32_t *a, size_t an) {
+  size_t bits = 0, i = 0;
+  while (i < an && a[i] == 0) {
+    bits += 32;
+    i++;
+  }
+  for (uint32_t low = i < an ? a[i] : 1; (low & 1) == 0; low >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// Estado de um teste BPSW: o contexto de Montgomery de n e os buffers de
+// n limbs reaproveitados pelas etapas
+typedef struct {
+  MontgomeryContext *ctx;
+  const uint32_t *n;
+  size_t nn;
+  uint32_t *minus_one; // n - 1 na forma de Montgomery
+  uint32_t *zero;
+  uint32_t *buf[5];
+} PrimeTest;
+
+static int equal(const PrimeTest *t, const uint32_t *a, const uint32_t *b) {
+  return memcmp(a, b, t->nn * sizeof(uint32_t)) == 0;
+}
+
+// Miller-Rabin forte na base b (forma de Montgomery), com n - 1 = d·2^s
+// Retorna 1 (passou), 0 (composto) ou -1 (faltou memória ou parada pedida
+// pelo ExecContext)
+static int miller_rabin(PrimeTest *t, const uint32_t *b, const uint32_t *d,
+                        size_t dn, size_t s) {
+  uint32_t *x = t->buf[0];
+  if (!montgomery_pow(t->ctx, x, b, d, dn)) {
+    return -1;
+  }
+  if (equal(t, x, t->ctx->one) || equal(t, x, t->minus_one)) {
+    return 1;
+  }
+  for (size_t r = 1; r < s; r++) {
+    montgomery_mul(t->ctx, x, x, x);
+    if (equal(t, x, t->minus_one)) {
+      return 1;
+    }
+    if (equal(t, x, t->ctx->one)) {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+// out = v mod n na forma de Montgomery, para v pequeno com sinal
+static int small_residue(PrimeTest *t, uint32_t *out, int64_t v) {
+  uint32_t word = (uint32_t)(v < 0 ? -v : v);
+  if (!montgomery_to(t->ctx, out, &word, 1)) {
+    return 0;
+  }
+  if (v < 0) {
+    montgomery_sub(t->ctx, out, t->zero, out);
+  }
+  return 1;
+}
+
+// x = x / 2 mod n (n ímpar: se x for ímpar, (x + n) / 2)
+static void halve(const PrimeTest *t, uint32_t *x) {
+  uint32_t carry = 0;
+  if (x[0] & 1) {
+    uint64_t c = 0;
+    for (size_t i = 0; i < t->nn; i++) {
+      uint64_t s = (uint64_t)x[i] + t->n[i] + c;
+      x[i] = (uint32_t)s;
+      c = s >> 32;
+    }
+    carry = (uint32_t)c;
+  }
+  for (size_t i = 0; i < t->nn; i++) {
+    uint32_t next = i + 1 < t->nn ? x[i + 1] : carry;
+    x[i] = (x[i] >> 1) | (next << 31);
+  }
+}
+
+static int is_square(const uint32_t *n, size_t nn) {
+  BigInt *x = bigint_import_limbs(n, nn, 1);
+  BigInt *rem = NULL;
+  BigInt *root = x != NULL ? bigint_sqrtrem(x, &rem) : NULL;
+  int square = root != NULL && rem != NULL && bigint_is_zero(rem);
+  bigint_destroy(x);
+  bigint_destroy(root);
+  bigint_destroy(rem);
+  return square;
+}
+
+// Lucas forte com P = 1 e Q = (1 - D) / 4, D o primeiro de 5, -7, 9, -11,
+// ... com (D/n) = -1 (Selfridge). Com n + 1 = d·2^s, n passa se U(d) = 0
+// ou V(d·2^r) = 0 para algum 0 <= r < s. Os índices dobram com
+// U(2k) = U(k)·V(k), V(2k) = V(k)^2 - 2·Q^k e avançam um com
+// U(k+1) = (U(k) + V(k)) / 2, V(k+1) = (D·U(k) + V(k)) / 2
+// Retorna 1 (passou), 0 (composto) ou -1 (faltou memória ou parada pedida
+// pelo ExecContext)
+static int lucas(PrimeTest *t) {
+  int64_t d = 5;
+  for (int tries = 1;; tries++) {
+    int j = jacobi(d, t->n, t->nn);
+    if (j == -1) {
+      break;
+    }
+    if (j == 0) {
+      return 0; // |D| < n divide n
+    }
+    if (tries == PRIME_SQUARE_CHECK && is_square(t->n, t->nn)) {
+      return 0;
+    }
+    d = d > 0 ? -(d + 2) : -d + 2;
+  }
+
+  size_t nn = t->nn;
+  uint32_t *k = calloc(nn + 1, sizeof(uint32_t));
+  if (k == NULL) {
+    return -1;
+  }
+  // k = n + 1
+  uint64_t carry = 1;
+  for (size_t i = 0; i < nn; i++) {
+    uint64_t s = (uint64_t)t->n[i] + carry;
+    k[i] = (uint32_t)s;
+    carry = s >> 32;
+  }
+  k[nn] = (uint32_t)carry;
+  size_t kn = limbs_normalized_length(k, nn + 1);
+  size_t s = trailing_zeros(k, kn);
+  shift_right(k, kn, s);
+  kn = limbs_normalized_length(k, kn);
+
+  uint32_t *u = t->buf[0], *v = t->buf[1], *qk = t->buf[2];
+  uint32_t *dm = t->buf[3], *qm = t->buf[4];
+  if (!small_residue(t, dm, d) || !small_residue(t, qm, (1 - d) / 4)) {
+    free(k);
+    return -1;
+  }
+  memcpy(u, t->ctx->one, nn * sizeof(uint32_t));
+  memcpy(v, t->ctx->one, nn * sizeof(uint32_t));
+  memcpy(qk, qm, nn * sizeof(uint32_t));
+  // Temporários para 2·Q^k e D·U(k)
+  uint32_t *tmp = malloc(2 * nn * sizeof(uint32_t));
+  if (tmp == NULL) {
+    free(k);
+    return -1;
+  }
+  uint32_t *tmp2 = tmp + nn;
+
+  size_t bits = bit_length(k, kn);
+  for (size_t bit = bits - 1; bit-- > 0;) {
+    if (bit % 32 == 0 && exec_checkpoint(NULL, 0, 0)) {
+      free(k);
+      free(tmp);
+      return -1;
+    }
+    montgomery_mul(t->ctx, u, u, v);
+    montgomery_add(t->ctx, tmp, qk, qk);
+    montgomery_mul(t->ctx, v, v, v);
+    montgomery_sub(t->ctx, v, v, tmp);
+    montgomery_mul(t->ctx, qk, qk, qk);
+    if ((k[bit / 32] >> (bit % 32)) & 1) {
+      montgomery_mul(t->ctx, tmp2, dm, u);
+      montgomery_add(t->ctx, u, u, v);
+      halve(t, u);
+      montgomery_add(t->ctx, v, v, tmp2);
+      halve(t, v);
+      montgomery_mul(t->ctx, qk, qk, qm);
+    }
+  }
+  free(k);
+
+  int result = equal(t, u, t->zero) || equal(t, v, t->zero);
+  for (size_t r = 1; !result && r < s; r++) {
+    montgomery_add(t->ctx, tmp, qk, qk);
+    montgomery_mul(t->ctx, v, v, v);
+    montgomery_sub(t->ctx, v, v, tmp);
+    montgomery_mul(t->ctx, qk, qk, qk);
+    result = equal(t, v, t->zero);
+  }
+  free(tmp);
+  return result;
+}
+
+// Gerador pseudoaleatório das bases extras (xorshift64)
+static uint64_t next_random(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+// BPSW e rodadas extras para n ímpar de pelo menos dois limbs, sem fatores
+// na tabela. Retorna 1 (primo provável), 0 (composto) ou -1 (sem memória)
+static int bpsw(const uint32_t *n, size_t nn, int rounds) {
+  PrimeTest t = {0};
+  t.n = n;
+  t.nn = nn;
+  t.ctx = montgomery_create(n, nn);
+  uint32_t *area = calloc(8 * nn, sizeof(uint32_t));
+  if (t.ctx == NULL || area == NULL) {
+    montgomery_destroy(t.ctx);
+    free(area);
+    return -1;
+  }
+  t.minus_one = area;
+  t.zero = area + nn;
+  for (int i = 0; i < 5; i++) {
+    t.buf[i] = area + (2 + i) * nn;
+  }
+  uint32_t *d = area + 7 * nn;
+
+  limbs_sub(t.minus_one, n, nn, t.ctx->one, nn);
+  // n - 1 = d·2^s
+  memcpy(d, n, nn * sizeof(uint32_t));
+  d[0] &= ~(uint32_t)1;
+  size_t s = trailing_zeros(d, nn);
+  shift_right(d, nn, s);
+  size_t dn = limbs_normalized_length(d, nn);
+
+  uint32_t *base = t.buf[1];
+  montgomery_add(t.ctx, base, t.ctx->one, t.ctx->one);
+  int result = miller_rabin(&t, base, d, dn, s);
+  if (result == 1) {
+    result = lucas(&t);
+  }
+
+  uint64_t state = ((uint64_t)n[nn - 1] << 32 | n[0]) ^ 0x9e3779b97f4a7c15ULL;
+  for (int r = 0; result == 1 && r < rounds; r++) {
+    // Base em [2, n): o limb mais alto fica abaixo do de n
+    uint32_t *word = t.buf[1];
+    for (size_t i = 0; i < nn; i++) {
+      word[i] = (uint32_t)(next_random(&state) >> 32);
+    }
+    word[nn - 1] %= n[nn - 1];
+    if (limbs_normalized_length(word, nn) <= 1 && word[0] < 2) {
+      word[0] = 2;
+    }
+    // A base convertida vai para buf[2], que o Miller-Rabin não usa
+    if (!montgomery_to(t.ctx, t.buf[2], word, nn)) {
+      result = -1;
+      break;
+    }
+    result = miller_rabin(&t, t.buf[2], d, dn, s);
+  }
+
+  montgomery_destroy(t.ctx);
+  free(area);
+  return result;
+}
+
+// Retorna 1 se algum primo dos primeiros groups grupos da tabela dividir n
+// (n maior que todos eles)
+static int has_small_factor(const uint32_t *n, size_t nn, size_t groups) {
+  size_t start = 0;
+  for (size_t g = 0; g < groups; g++) {
+    uint32_t r = mod_word(n, nn, group_product[g]);
+    for (size_t i = start; i < group_end[g]; i++) {
+      if (r % small_primes[i] == 0) {
+        return 1;
+      }
+    }
+    start = group_end[g];
+  }
+  return 0;
+}
+
+// Teste completo sobre limbs normalizados. Retorna 1, 0 ou -1 (sem memória)
+static int probable_prime_limbs(const uint32_t *n, size_t nn, int rounds) {
+  if (nn == 0) {
+    return 0;
+  }
+  if (nn == 1) {
+    return is_prime_word(n[0]);
+  }
+  if ((n[0] & 1) == 0 ||
+      has_small_factor(n, nn, trial_groups(bit_length(n, nn)))) {
+    return 0;
+  }
+  return bpsw(n, nn, rounds);
+}
+
+int bigint_is_probable_prime(const BigInt *n, int rounds) {
+  if (n == NULL || n->sign < 0 || !table_ready()) {
+    return 0;
+  }
+  size_t nn = 0;
+  uint32_t *limbs = bigint_export_limbs(n, &nn);
+  if (limbs == NULL) {
+    return 0;
+  }
+  nn = limbs_normalized_length(limbs, nn);
+  int result = probable_prime_limbs(limbs, nn, rounds);
+  free(limbs);
+  return result == 1;
+}
+
+// Candidatos sobreviventes da peneira de uma janela: base + 2·offset
+typedef struct {
+  const uint32_t *base;
+  size_t bn;
+  const uint32_t *offsets;
+  int rounds;
+  size_t found;  // Menor índice primo encontrado (acesso atômico)
+  int failed;    // Faltou memória em algum teste (acesso atômico)
+} PrimeScreen;
+
+// Testa os candidatos [begin, end) em ordem, parando no primeiro primo ou
+// quando outro pedaço já achou um primo com índice menor
+static void screen_range(void *ctx, size_t begin, size_t end) {
+  PrimeScreen *job = ctx;
+  uint32_t *c = malloc((job->bn + 1) * sizeof(uint32_t));
+  if (c == NULL) {
+    __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  for (size_t i = begin; i < end; i++) {
+    if (i >= __atomic_load_n(&job->found, __ATOMIC_RELAXED)) {
+      break;
+    }
+    uint64_t carry = 2 * (uint64_t)job->offsets[i];
+    for (size_t j = 0; j < job->bn; j++) {
+      uint64_t s = (uint64_t)job->base[j] + carry;
+      c[j] = (uint32_t)s;
+      carry = s >> 32;
+    }
+    c[job->bn] = (uint32_t)carry;
+    int r = bpsw(c, limbs_normalized_length(c, job->bn + 1), job->rounds);
+    if (r == -1) {
+      __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+      break;
+    }
+    if (r == 1) {
+      size_t current = __atomic_load_n(&job->found, __ATOMIC_RELAXED);
+      while (i < current &&
+             !__atomic_compare_exchange_n(&job->found, &current, i, 1,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED)) {
+      }
+      break;
+    }
+  }
+  free(c);
+}
+
+// Próximo primo a partir de c (ímpar, c > 2^32), sem limite de tamanho
+// c tem cn limbs e espaço para cn + 1
+static BigInt *next_prime_sieve(uint32_t *c, size_t cn, int rounds) {
+  size_t groups = trial_groups(bit_length(c, cn) + 1);
+  size_t primes = group_end[groups - 1];
+  uint32_t *residues = malloc(primes * sizeof(uint32_t));
+  uint32_t *offsets = malloc(PRIME_SIEVE_WINDOW * sizeof(uint32_t));
+  unsigned char *composite = malloc(PRIME_SIEVE_WINDOW);
+  BigInt *result = NULL;
+  if (residues == NULL || offsets == NULL || composite == NULL) {
+    free(residues);
+    free(offsets);
+    free(composite);
+    return NULL;
+  }
+  size_t start = 0;
+  for (size_t g = 0; g < groups; g++) {
+    uint32_t r = mod_word(c, cn, group_product[g]);
+    for (size_t i = start; i < group_end[g]; i++) {
+      residues[i] = r % small_primes[i];
+    }
+    start = group_end[g];
+  }
+
+  Scheduler *s = scheduler_current();
+  while (!exec_checkpoint(NULL, 0, 0)) {
+    // c + 2j é múltiplo de p quando j = -c·2^-1 (mod p)
+    memset(composite, 0, PRIME_SIEVE_WINDOW);
+    for (size_t i = 0; i < primes; i++) {
+      uint32_t p = small_primes[i];
+      uint64_t neg = residues[i] == 0 ? 0 : p - residues[i];
+      for (size_t j = neg * ((p + 1) / 2) % p; j < PRIME_SIEVE_WINDOW;
+           j += p) {
+        composite[j] = 1;
+      }
+    }
+    size_t count = 0;
+    for (uint32_t j = 0; j < PRIME_SIEVE_WINDOW; j++) {
+      if (!composite[j]) {
+        offsets[count++] = j;
+      }
+    }
+
+    // Os sobreviventes vão em lotes de dois por worker: o primeiro primo
+    // de cada lote encerra a busca e limita o trabalho desperdiçado
+    PrimeScreen job = {c, cn, offsets, rounds, count, 0};
+    size_t batch = s != NULL ? 2 * scheduler_workers(s) : count;
+    for (size_t begin = 0; begin < count && job.found == count;
+         begin += batch) {
+      size_t end = begin + batch < count ? begin + batch : count;
+      PrimeScreen part = job;
+      part.offsets = offsets + begin;
+      part.found = end - begin;
+      scheduler_parallel_for(end - begin, 1, screen_range, &part);
+      if (part.failed) {
+        job.failed = 1;
+        break;
+      }
+      if (part.found < end - begin) {
+        job.found = begin + part.found;
+      }
+    }
+    if (job.failed) {
+      break;
+    }
+    if (job.found < count) {
+      // c += 2·offset
+      uint64_t carry = 2 * (uint64_t)offsets[job.found];
+      for (size_t j = 0; j < cn; j++) {
+        uint64_t sum = (uint64_t)c[j] + carry;
+        c[j] = (uint32_t)sum;
+        carry = sum >> 32;
+      }
+      c[cn] = (uint32_t)carry;
+      result = bigint_import_limbs(c, cn + 1, 1);
+      break;
+    }
+
+    // Próxima janela: c += 2·PRIME_SIEVE_WINDOW
+    uint64_t carry = 2 * PRIME_SIEVE_WINDOW;
+    for (size_t j = 0; j < cn; j++) {
+      uint64_t sum = (uint64_t)c[j] + carry;
+      c[j] = (uint32_t)sum;
+      carry = sum >> 32;
+    }
+    if (carry != 0) {
+      // c cresceu um limb: recomeça com o novo tamanho
+      c[cn] = (uint32_t)carry;
+      free(residues);
+      free(offsets);
+      free(composite);
+      return next_prime_sieve(c, cn + 1, rounds);
+    }
+    for (size_t i = 0; i < primes; i++) {
+      residues[i] = (uint32_t)((residues[i] + 2 * PRIME_SIEVE_WINDOW) %
+                               small_primes[i]);
+    }
+  }
+  free(residues);
+  free(offsets);
+  free(composite);
+  return result;
+}
+
+BigInt *bigint_next_prime(const BigInt *n, int rounds) {
+  if (n == NULL || !table_ready()) {
+    return NULL;
+  }
+  size_t nn = 0;
+  uint32_t *limbs = bigint_export_limbs(n, &nn);
+  if (limbs == NULL) {
+    return NULL;
+  }
+  nn = limbs_normalized_length(limbs, nn);
+  if (n->sign < 0 || nn == 0 || (nn == 1 && limbs[0] < PRIME_LARGEST_WORD)) {
+    uint32_t c = n->sign < 0 || nn == 0 ? 2 : limbs[0] + 1;
+    free(limbs);
+    while (!is_prime_word(c)) {
+      c++;
+    }
+    return bigint_import_limbs(&c, 1, 1);
+  }
+
+  // c = n + 1 arredondado para ímpar. A peneira precisa de um limb além do
+  // tamanho de c, que pode crescer uma vez na soma e outra entre janelas
+  uint32_t *c = calloc(nn + 3, sizeof(uint32_t));
+  if (c == NULL) {
+    free(limbs);
+    return NULL;
+  }
+  uint64_t carry = (limbs[0] & 1) ? 2 : 1;
+  for (size_t i = 0; i < nn; i++) {
+    uint64_t s = (uint64_t)limbs[i] + carry;
+    c[i] = (uint32_t)s;
+    carry = s >> 32;
+  }
+  c[nn] = (uint32_t)carry;
+  free(limbs);
+  BigInt *result = next_prime_sieve(c, limbs_normalized_length(c, nn + 1),
+                                    rounds);
+  free(c);
+  return result;
+}
@@ -0,0 +1,31 @@
+#ifndef PRIME_H
+#define PRIME_H
+
+#include "../BigInt/BigInt.h"
+
+// Testes de primalidade e busca do próximo primo
+// Cada teste passa primeiro por divisão por uma tabela de primos pequenos
+// (restos de um limb, vários primos por passada sobre o número) e depois por
+// BPSW: Miller-Rabin na base 2 e Lucas forte com os parâmetros de Selfridge,
+// ambos na forma de Montgomery. Não se conhece composto que passe no BPSW;
+// até 2^32 a resposta é exata (divisão pela tabela até a raiz)
+
+// Rodadas extras de Miller-Rabin usadas pelo modo batch e pelo menu
+#define PRIME_DEFAULT_ROUNDS 2
+
+// Retorna 1 se n for primo provável e 0 se for composto, menor que 2 ou
+// se faltar memória. rounds é a quantidade de rodadas extras de Miller-Rabin
+// com bases pseudoaleatórias (determinísticas para cada n) após o BPSW
+int bigint_is_probable_prime(const BigInt *n, int rounds);
+
+// Menor primo provável maior que n (2 se n < 2), com o mesmo teste
+// Os candidatos são peneirados em janelas pelos primos da tabela e, dentro
+// de um worker do Scheduler, os que sobram são testados em paralelo
+// Retorna NULL se faltou memória
+BigInt *bigint_next_prime(const BigInt *n, int rounds);
+
+// Primos ímpares abaixo de 65536, em ordem crescente (a tabela da divisão
+// por tentativa, calculada no primeiro uso). Retorna NULL se faltou memória
+const uint32_t *prime_table(size_t *count);
+
+#endif // PRIME_H
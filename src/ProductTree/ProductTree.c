@@ -0,0 +1,760 @@
+#include "ProductTree.h"
+#include "../ExecContext/ExecContext.h"
+#include "../Limbs/Limbs.h"
+#include "../Scheduler/Scheduler.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Folhas com até esta quantidade de fatores de um limb são multiplicadas em
+// sequência (o acumulador cresce no máximo um limb por fator)
+#define PRODUCT_LEAF_WORDS 16
+
+// Peso mínimo (limbs dos fatores) para multiplicar as subárvores em paralelo
+#define PRODUCT_PARALLEL_MIN 1024
+
+// Abaixo disto o fatorial não divide (n/2)! e swing(n) em tarefas
+#define FACTORIAL_PARALLEL_MIN 20000
+
+// Fatores de um produto: operandos grandes (limbs/lens, com somas de
+// prefixo para balancear a árvore pelo tamanho) ou de um limb (words)
+typedef struct {
+  const uint32_t *const *limbs;
+  const size_t *lens;
+  const size_t *prefix; // prefix[i] = lens[0] + ... + lens[i - 1]
+  const uint32_t *words;
+} Factors;
+
+typedef struct {
+  const Factors *f;
+  size_t lo, hi;
+  uint32_t *out; // Resultado (alocado pela tarefa), NULL se faltou memória
+  size_t n;
+} ProductJob;
+
+// Multiplica dois arrays em um novo array normalizado
+static uint32_t *mul_alloc(const uint32_t *a, size_t an, const uint32_t *b,
+                           size_t bn, size_t *n) {
+  uint32_t *out = malloc((an + bn > 0 ? an + bn : 1) * sizeof(uint32_t));
+  if (out == NULL) {
+    return NULL;
+  }
+  limbs_mul(out, a, an, b, bn);
+  *n = limbs_normalized_length(out, an + bn);
+  return out;
+}
+
+// Produto sequencial de fatores de um limb
+static uint32_t *product_words(const uint32_t *words, size_t count,
+                               size_t *n) {
+  uint32_t *out = malloc((count + 1) * sizeof(uint32_t));
+  if (out == NULL) {
+    return NULL;
+  }
+
+  size_t len = 1;
+  out[0] = 1;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < len; j++) {
+      uint64_t cur = (uint64_t)out[j] * words[i] + carry;
+      out[j] = (uint32_t)(cur & UINT32_MAX);
+      carry = cur >> 32;
+    }
+    if (carry > 0) {
+      out[len++] = (uint32_t)carry;
+    }
+  }
+  *n = limbs_normalized_length(out, len);
+  return out;
+}
+
+static size_t weight(const Factors *f, size_t lo, size_t hi) {
+  return f->prefix != NULL ? f->prefix[hi] - f->prefix[lo] : hi - lo;
+}
+
+// Escolhe o ponto de divisão que deixa as duas metades com tamanhos
+// parecidos (em limbs), e não apenas com a mesma quantidade de fatores
+static size_t split_point(const Factors *f, size_t lo, size_t hi) {
+  if (f->prefix == NULL) {
+    return lo + (hi - lo) / 2;
+  }
+
+  size_t target = f->prefix[lo] + weight(f, lo, hi) / 2;
+  size_t a = lo + 1, b = hi - 1;
+  while (a < b) {
+    size_t mid = a + (b - a) / 2;
+    if (f->prefix[mid] < target) {
+      a = mid + 1;
+    } else {
+      b = mid;
+    }
+  }
+  return a;
+}
+
+static void product_task(void *arg) {
+  ProductJob *job = arg;
+  const Factors *f = job->f;
+  size_t count = job->hi - job->lo;
+
+  if (f->words != NULL && count <= PRODUCT_LEAF_WORDS) {
+    job->out = product_words(f->words + job->lo, count, &job->n);
+    return;
+  }
+  if (f->words == NULL && count <= 1) {
+    const uint32_t one = 1;
+    const uint32_t *src = count == 1 ? f->limbs[job->lo] : &one;
+    size_t len = count == 1 ? f->lens[job->lo] : 1;
+    job->out = malloc((len > 0 ? len : 1) * sizeof(uint32_t));
+    if (job->out != NULL) {
+      memcpy(job->out, src, len * sizeof(uint32_t));
+      job->n = len;
+    }
+    return;
+  }
+
+  size_t mid = split_point(f, job->lo, job->hi);
+  ProductJob left = {f, job->lo, mid, NULL, 0};
+  ProductJob right = {f, mid, job->hi, NULL, 0};
+  scheduler_fork_join(product_task, &left, product_task, &right,
+                      weight(f, job->lo, job->hi) >= PRODUCT_PARALLEL_MIN);
+
+  // Um ponto de verificação do ExecContext por nó interno
+  if (left.out != NULL && right.out != NULL && !exec_checkpoint(NULL, 0, 0)) {
+    job->out = mul_alloc(left.out, left.n, right.out, right.n, &job->n);
+  }
+  free(left.out);
+  free(right.out);
+}
+
+// Produto de todos os fatores pela árvore. Retorna NULL se faltou memória
+static uint32_t *product_tree(const Factors *f, size_t count, size_t *n) {
+  ProductJob job = {f, 0, count, NULL, 0};
+  product_task(&job);
+  *n = job.n;
+  return job.out;
+}
+
+BigInt *bigint_product(const BigInt **xs, size_t n) {
+  if (xs == NULL && n > 0) {
+    return NULL;
+  }
+
+  const uint32_t **limbs = calloc(n > 0 ? n : 1, sizeof(uint32_t *));
+  size_t *lens = malloc((n > 0 ? n : 1) * sizeof(size_t));
+  size_t *prefix = malloc((n + 1) * sizeof(size_t));
+  int ok = limbs != NULL && lens != NULL && prefix != NULL;
+  int sign = 1;
+
+  // Exporta cada operando para um array contíguo
+  if (ok) {
+    prefix[0] = 0;
+  }
+  for (size_t i = 0; ok && i < n; i++) {
+    if (xs[i] == NULL) {
+      ok = 0;
+      break;
+    }
+    limbs[i] = bigint_export_limbs(xs[i], &lens[i]);
+    ok = limbs[i] != NULL;
+    if (ok) {
+      lens[i] = limbs_normalized_length(limbs[i], lens[i]);
+      prefix[i + 1] = prefix[i] + lens[i];
+      sign *= xs[i]->sign;
+    }
+  }
+
+  BigInt *result = NULL;
+  if (ok) {
+    Factors f = {limbs, lens, prefix, NULL};
+    size_t len;
+    uint32_t *out = product_tree(&f, n, &len);
+    if (out != NULL) {
+      result = bigint_import_limbs(out, len, sign);
+      free(out);
+    }
+  }
+
+  for (size_t i = 0; limbs != NULL && i < n; i++) {
+    free((uint32_t *)limbs[i]);
+  }
+  free(limbs);
+  free(lens);
+  free(prefix);
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// Fatorial e binomial
+// ---------------------------------------------------------------------------
+
+// Lê um BigInt não negativo que cabe em um limb
+static int bigint_to_word(const BigInt *bi, uint32_t *value) {
+  if (bi == NULL || bi->digits == NULL ||
+      linkedlist_length(bi->digits) != 1) {
+    return 0;
+  }
+  *value = bi->digits->head->value;
+  return bi->sign == 1 || *value == 0;
+}
+
+// Lista os primos <= n com o crivo de Eratóstenes
+static uint32_t *prime_list(uint32_t n, size_t *count) {
+  unsigned char *composite = calloc((size_t)n + 1, 1);
+  if (composite == NULL) {
+    return NULL;
+  }
+
+  size_t total = 0;
+  for (uint64_t i = 2; i <= n; i++) {
+    if (composite[i]) {
+      continue;
+    }
+    total++;
+    for (uint64_t j = i * i; j <= n; j += i) {
+      composite[j] = 1;
+    }
+  }
+
+  uint32_t *primes = malloc((total > 0 ? total : 1) * sizeof(uint32_t));
+  if (primes != NULL) {
+    size_t k = 0;
+    for (uint64_t i = 2; i <= n; i++) {
+      if (!composite[i]) {
+        primes[k++] = (uint32_t)i;
+      }
+    }
+    *count = total;
+  }
+  free(composite);
+  return primes;
+}
+
+typedef struct {
+  const uint32_t *primes;
+  size_t nprimes;
+  uint32_t n;
+  uint32_t *out;
+  size_t len;
+} FactorialJob;
+
+// swing(n) = n! / ((n/2)!)^2 = produto de p^e, com e = soma dos bits
+// floor(n / p^i) mod 2. Cada p^e é no máximo n, então cabe em um limb
+static void swing_task(void *arg) {
+  FactorialJob *job = arg;
+  uint32_t *factors = malloc((job->nprimes + 1) * sizeof(uint32_t));
+  if (factors == NULL) {
+    return;
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < job->nprimes && job->primes[i] <= job->n; i++) {
+    uint64_t p = job->primes[i];
+    uint64_t factor = 1;
+    for (uint64_t q = job->n / p; q > 0; q /= p) {
+      if (q & 1) {
+        factor *= p;
+      }
+    }
+    if (factor > 1) {
+      factors[count++] = (uint32_t)factor;
+    }
+  }
+
+  Factors f = {NULL, NULL, NULL, factors};
+  job->out = product_tree(&f, count, &job->len);
+  free(factors);
+}
+
+// n! = ((n/2)!)^2 * swing(n); as duas partes são independentes
+static void factorial_task(void *arg) {
+  FactorialJob *job = arg;
+  if (job->n < 2) {
+    job->out = malloc(sizeof(uint32_t));
+    if (job->out != NULL) {
+      job->out[0] = 1;
+      job->len = 1;
+    }
+    return;
+  }
+
+  FactorialJob half = {job->primes, job->nprimes, job->n / 2, NULL, 0};
+  FactorialJob swing = {job->primes, job->nprimes, job->n, NULL, 0};
+  scheduler_fork_join(factorial_task, &half, swing_task, &swing,
+                      job->n >= FACTORIAL_PARALLEL_MIN);
+
+  if (half.out != NULL && swing.out != NULL &&
+      !exec_checkpoint(NULL, 0, 0)) {
+    size_t sq_len;
+    uint32_t *square = mul_alloc(half.out, half.len, half.out, half.len,
+                                 &sq_len);
+    if (square != NULL) {
+      job->out = mul_alloc(square, sq_len, swing.out, swing.len, &job->len);
+      free(square);
+    }
+  }
+  free(half.out);
+  free(swing.out);
+}
+
+BigInt *bigint_factorial(const BigInt *n) {
+  uint32_t value;
+  if (!bigint_to_word(n, &value)) {
+    return NULL;
+  }
+
+  size_t nprimes = 0;
+  uint32_t *primes = prime_list(value, &nprimes);
+  if (primes == NULL) {
+    return NULL;
+  }
+
+  FactorialJob job = {primes, nprimes, value, NULL, 0};
+  factorial_task(&job);
+  free(primes);
+  if (job.out == NULL) {
+    return NULL;
+  }
+
+  BigInt *result = bigint_import_limbs(job.out, job.len, 1);
+  free(job.out);
+  return result;
+}
+
+BigInt *bigint_binomial(const BigInt *n, const BigInt *k) {
+  uint32_t nv;
+  if (!bigint_to_word(n, &nv) || k == NULL || k->digits == NULL) {
+    return NULL;
+  }
+
+  // k < 0 ou k > n: não há como escolher k elementos
+  uint32_t kv;
+  if (k->sign == -1 && !bigint_is_zero(k)) {
+    return bigint_create_from_int(0);
+  }
+  if (!bigint_to_word(k, &kv) || kv > nv) {
+    return bigint_create_from_int(0);
+  }
+  if (kv > nv - kv) {
+    kv = nv - kv;
+  }
+
+  size_t nprimes = 0;
+  uint32_t *primes = prime_list(nv, &nprimes);
+  uint32_t *factors = malloc((nprimes + 1) * sizeof(uint32_t));
+  if (primes == NULL || factors == NULL) {
+    free(primes);
+    free(factors);
+    return NULL;
+  }
+
+  // Expoente de p = quantidade de i com floor(n/p^i) - floor(k/p^i) -
+  // floor((n-k)/p^i) = 1; p^e <= n, então cada fator cabe em um limb
+  size_t count = 0;
+  uint32_t rest = nv - kv;
+  for (size_t i = 0; i < nprimes; i++) {
+    uint64_t p = primes[i];
+    uint64_t factor = 1;
+    for (uint64_t pp = p; pp <= nv; pp *= p) {
+      if (nv / pp - kv / pp - rest / pp) {
+        factor *= p;
+      }
+    }
+    if (factor > 1) {
+      factors[count++] = (uint32_t)factor;
+    }
+  }
+  free(primes);
+
+  Factors f = {NULL, NULL, NULL, factors};
+  size_t len;
+  uint32_t *out = product_tree(&f, count, &len);
+  free(factors);
+  if (out == NULL) {
+    return NULL;
+  }
+
+  BigInt *result = bigint_import_limbs(out, len, 1);
+  free(out);
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// Árvore de restos e batch GCD
+// ---------------------------------------------------------------------------
+
+// Maior altura possível de uma árvore binária indexada por size_t
+#define TREE_MAX_LEVELS 64
+
+typedef struct {
+  uint32_t *limbs;
+  size_t n;
+} LimbArray;
+
+// Árvore de produto completa: level[0] são as folhas (de quem chamou) e cada
+// nível acima multiplica pares do anterior; um nó ímpar no fim sobe copiado
+typedef struct {
+  LimbArray *level[TREE_MAX_LEVELS];
+  size_t count[TREE_MAX_LEVELS];
+  size_t levels;
+} Tree;
+
+typedef struct {
+  Tree *t;
+  size_t l;                 // Nível sendo calculado
+  const LimbArray *parent;  // Restos do nível de cima (árvore de restos)
+  LimbArray *out;
+  int square;               // Reduz módulo o quadrado do nó (batch GCD)
+  int failed;               // Acesso atômico
+} LevelJob;
+
+static void free_arrays(LimbArray *xs, size_t n) {
+  for (size_t i = 0; xs != NULL && i < n; i++) {
+    free(xs[i].limbs);
+  }
+  free(xs);
+}
+
+static void tree_free(Tree *t) {
+  for (size_t l = 1; l < t->levels; l++) {
+    free_arrays(t->level[l], t->count[l]);
+  }
+  t->levels = 0;
+}
+
+static uint32_t *copy_alloc(const uint32_t *a, size_t an) {
+  uint32_t *out = malloc((an > 0 ? an : 1) * sizeof(uint32_t));
+  if (out != NULL) {
+    memcpy(out, a, an * sizeof(uint32_t));
+  }
+  return out;
+}
+
+// Resto de a por b (b normalizado e não nulo) em um novo array
+static uint32_t *mod_alloc(const uint32_t *a, size_t an, const uint32_t *b,
+                           size_t bn, size_t *n) {
+  an = limbs_normalized_length(a, an);
+  if (an < bn) {
+    *n = an;
+    return copy_alloc(a, an);
+  }
+
+  uint32_t *q = malloc((an - bn + 1) * sizeof(uint32_t));
+  uint32_t *r = malloc(bn * sizeof(uint32_t));
+  if (q == NULL || r == NULL || !limbs_divmod(q, r, a, an, b, bn)) {
+    free(q);
+    free(r);
+    return NULL;
+  }
+  free(q);
+  *n = limbs_normalized_length(r, bn);
+  return r;
+}
+
+// mdc(a, b) pelo algoritmo de Euclides sobre arrays de limbs
+static uint32_t *gcd_alloc(const uint32_t *a, size_t an, const uint32_t *b,
+                           size_t bn, size_t *n) {
+  size_t cap = (an > bn ? an : bn) + 1;
+  uint32_t *u = malloc(cap * sizeof(uint32_t));
+  uint32_t *v = malloc(cap * sizeof(uint32_t));
+  uint32_t *q = malloc(cap * sizeof(uint32_t));
+  uint32_t *r = malloc(cap * sizeof(uint32_t));
+  if (u == NULL || v == NULL || q == NULL || r == NULL) {
+    free(u);
+    free(v);
+    free(q);
+    free(r);
+    return NULL;
+  }
+
+  memcpy(u, a, an * sizeof(uint32_t));
+  memcpy(v, b, bn * sizeof(uint32_t));
+  size_t un = limbs_normalized_length(u, an);
+  size_t vn = limbs_normalized_length(v, bn);
+  int ok = 1;
+  while (ok && vn > 0) {
+    size_t rn = un;
+    if (un >= vn) {
+      ok = limbs_divmod(q, r, u, un, v, vn);
+      rn = limbs_normalized_length(r, vn);
+    } else {
+      memcpy(r, u, un * sizeof(uint32_t));
+    }
+    uint32_t *tmp = u;
+    u = v;
+    un = vn;
+    v = r;
+    vn = rn;
+    r = tmp;
+  }
+
+  free(v);
+  free(q);
+  free(r);
+  if (!ok) {
+    free(u);
+    return NULL;
+  }
+  *n = un;
+  return u;
+}
+
+static void level_fail(LevelJob *job) {
+  __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+}
+
+static void product_level_range(void *ctx, size_t begin, size_t end) {
+  LevelJob *job = ctx;
+  const LimbArray *below = job->t->level[job->l - 1];
+  size_t below_count = job->t->count[job->l - 1];
+
+  for (size_t i = begin; i < end; i++) {
+    const LimbArray *a = &below[2 * i];
+    LimbArray *node = &job->out[i];
+    if (2 * i + 1 < below_count) {
+      const LimbArray *b = &below[2 * i + 1];
+      node->limbs = mul_alloc(a->limbs, a->n, b->limbs, b->n, &node->n);
+    } else {
+      node->limbs = copy_alloc(a->limbs, a->n);
+      node->n = a->n;
+    }
+    if (node->limbs == NULL) {
+      level_fail(job);
+    }
+  }
+}
+
+// Monta a árvore de produto sobre as folhas. Os nós de cada nível são
+// independentes e são calculados em paralelo
+static int tree_build(Tree *t, LimbArray *leaves, size_t n) {
+  t->level[0] = leaves;
+  t->count[0] = n;
+  t->levels = 1;
+
+  while (t->count[t->levels - 1] > 1) {
+    size_t l = t->levels;
+    size_t count = (t->count[l - 1] + 1) / 2;
+    LevelJob job = {t, l, NULL, calloc(count, sizeof(LimbArray)), 0, 0};
+    if (job.out == NULL) {
+      return 0;
+    }
+    t->level[l] = job.out;
+    t->count[l] = count;
+    t->levels++;
+
+    scheduler_parallel_for(count, 1, product_level_range, &job);
+    if (job.failed || exec_checkpoint(NULL, 0, 0)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void remainder_level_range(void *ctx, size_t begin, size_t end) {
+  LevelJob *job = ctx;
+  const LimbArray *nodes = job->t->level[job->l];
+
+  for (size_t i = begin; i < end; i++) {
+    const LimbArray *parent = &job->parent[i / 2];
+    const LimbArray *m = &nodes[i];
+    LimbArray *rem = &job->out[i];
+
+    if (job->square) {
+      size_t sq_n;
+      uint32_t *sq = mul_alloc(m->limbs, m->n, m->limbs, m->n, &sq_n);
+      rem->limbs =
+          sq != NULL ? mod_alloc(parent->limbs, parent->n, sq, sq_n, &rem->n)
+                     : NULL;
+      free(sq);
+    } else {
+      rem->limbs = mod_alloc(parent->limbs, parent->n, m->limbs, m->n, &rem->n);
+    }
+    if (rem->limbs == NULL) {
+      level_fail(job);
+    }
+  }
+}
+
+// Árvore de restos: desce da raiz até as folhas reduzindo o resto do pai
+// módulo cada nó (ou o quadrado do nó). Retorna os restos das folhas
+static LimbArray *tree_remainders(Tree *t, const uint32_t *x, size_t xn,
+                                  int square) {
+  // A raiz é tratada como filha única de um nó cujo resto é x
+  LimbArray top = {(uint32_t *)x, xn};
+  const LimbArray *parent = &top;
+  LimbArray *rems = NULL;
+
+  for (size_t l = t->levels; l-- > 0;) {
+    LevelJob job = {t, l, parent, calloc(t->count[l], sizeof(LimbArray)),
+                    square, 0};
+    if (job.out != NULL) {
+      if (l == t->levels - 1) {
+        remainder_level_range(&job, 0, 1);
+      } else {
+        scheduler_parallel_for(t->count[l], 1, remainder_level_range, &job);
+      }
+    }
+
+    if (rems != NULL) {
+      free_arrays(rems, t->count[l + 1]);
+    }
+    rems = job.out;
+    if (rems == NULL || job.failed) {
+      free_arrays(rems, t->count[l]);
+      return NULL;
+    }
+    parent = rems;
+  }
+  return rems;
+}
+
+// Exporta BigInts para arrays normalizados. Retorna NULL em erro ou se
+// algum for zero (a árvore não faz sentido com um fator nulo)
+static LimbArray *export_all(const BigInt **xs, size_t n) {
+  LimbArray *out = calloc(n > 0 ? n : 1, sizeof(LimbArray));
+  for (size_t i = 0; out != NULL && i < n; i++) {
+    size_t len = 0;
+    out[i].limbs = xs[i] != NULL ? bigint_export_limbs(xs[i], &len) : NULL;
+    out[i].n = out[i].limbs != NULL ? limbs_normalized_length(out[i].limbs, len)
+                                    : 0;
+    if (out[i].n == 0) {
+      free_arrays(out, i + 1);
+      return NULL;
+    }
+  }
+  return out;
+}
+
+// Converte os arrays de resultado em BigInts (positivos)
+static BigInt **import_all(const LimbArray *xs, size_t n) {
+  BigInt **out = calloc(n > 0 ? n : 1, sizeof(BigInt *));
+  for (size_t i = 0; out != NULL && i < n; i++) {
+    out[i] = bigint_import_limbs(xs[i].limbs, xs[i].n, 1);
+    if (out[i] == NULL) {
+      bigint_batch_free(out, i);
+      return NULL;
+    }
+  }
+  return out;
+}
+
+void bigint_batch_free(BigInt **xs, size_t n) {
+  for (size_t i = 0; xs != NULL && i < n; i++) {
+    bigint_destroy(xs[i]);
+  }
+  free(xs);
+}
+
+BigInt **bigint_batch_mod(const BigInt *x, const BigInt **moduli, size_t n) {
+  if (x == NULL || moduli == NULL || n == 0) {
+    return NULL;
+  }
+
+  LimbArray *ms = export_all(moduli, n);
+  size_t xn = 0;
+  uint32_t *xl = bigint_export_limbs(x, &xn);
+  Tree t = {{NULL}, {0}, 0};
+  LimbArray *rems = NULL;
+  if (ms != NULL && xl != NULL && tree_build(&t, ms, n)) {
+    rems = tree_remainders(&t, xl, limbs_normalized_length(xl, xn), 0);
+  }
+
+  // Para x < 0 o resto de |x| é negativo: r = |m| - r (como bigint_mod)
+  BigInt **out = NULL;
+  if (rems != NULL) {
+    for (size_t i = 0; x->sign == -1 && i < n; i++) {
+      if (rems[i].n > 0) {
+        uint32_t *r = malloc(ms[i].n * sizeof(uint32_t));
+        if (r != NULL) {
+          memcpy(r, rems[i].limbs, rems[i].n * sizeof(uint32_t));
+          memset(r + rems[i].n, 0, (ms[i].n - rems[i].n) * sizeof(uint32_t));
+          limbs_sub(r, ms[i].limbs, ms[i].n, r, ms[i].n);
+        }
+        free(rems[i].limbs);
+        rems[i].limbs = r;
+        rems[i].n = ms[i].n;
+      }
+    }
+    out = import_all(rems, n);
+  }
+
+  tree_free(&t);
+  free_arrays(rems, rems != NULL ? n : 0);
+  free_arrays(ms, ms != NULL ? n : 0);
+  free(xl);
+  return out;
+}
+
+typedef struct {
+  const LimbArray *xs;
+  LimbArray *rems; // Entrada: P mod x_i^2. Saída: mdc(x_i, P / x_i)
+  int failed;
+} GcdJob;
+
+// g_i = mdc(x_i, (P mod x_i^2) / x_i): como x_i^2 divide P * x_i, o
+// quociente é (P / x_i) mod x_i, o produto dos demais reduzido módulo x_i
+static void leaf_gcd_range(void *ctx, size_t begin, size_t end) {
+  GcdJob *job = ctx;
+  for (size_t i = begin; i < end; i++) {
+    const LimbArray *x = &job->xs[i];
+    LimbArray *rem = &job->rems[i];
+
+    size_t qn = 0;
+    uint32_t *q = NULL;
+    if (rem->n >= x->n) {
+      qn = rem->n - x->n + 1;
+      q = malloc(qn * sizeof(uint32_t));
+      uint32_t *r = malloc(x->n * sizeof(uint32_t));
+      if (q == NULL || r == NULL ||
+          !limbs_divmod(q, r, rem->limbs, rem->n, x->limbs, x->n)) {
+        free(q);
+        q = NULL;
+      }
+      free(r);
+      if (q == NULL) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        continue;
+      }
+    }
+
+    size_t gn = 0;
+    uint32_t *g = gcd_alloc(x->limbs, x->n, q, qn, &gn);
+    free(q);
+    free(rem->limbs);
+    rem->limbs = g;
+    rem->n = gn;
+    if (g == NULL) {
+      __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+BigInt **bigint_batch_gcd(const BigInt **xs, size_t n) {
+  if (xs == NULL || n == 0) {
+    return NULL;
+  }
+
+  LimbArray *leaves = export_all(xs, n);
+  Tree t = {{NULL}, {0}, 0};
+  LimbArray *rems = NULL;
+  if (leaves != NULL && tree_build(&t, leaves, n)) {
+    // P é a raiz; descendo, cada nó reduz o resto do pai módulo o seu quadrado
+    const LimbArray *root = &t.level[t.levels - 1][0];
+    rems = tree_remainders(&t, root->limbs, root->n, 1);
+  }
+
+  BigInt **out = NULL;
+  if (rems != NULL) {
+    GcdJob job = {leaves, rems, 0};
+    scheduler_parallel_for(n, 1, leaf_gcd_range, &job);
+    if (!job.failed) {
+      out = import_all(rems, n);
+    }
+  }
+
+  tree_free(&t);
+  free_arrays(rems, rems != NULL ? n : 0);
+  free_arrays(leaves, leaves != NULL ? n : 0);
+  return out;
+}
@@ -0,0 +1,49 @@
+#ifndef PRODUCTTREE_H
+#define PRODUCTTREE_H
+
+#include "../BigInt/BigInt.h"
+#include <stddef.h>
+
+// Produtos de muitos fatores com árvores de produto balanceadas
+// Multiplicar uma lista da esquerda para a direita deixa os operandos cada
+// vez mais desbalanceados (um enorme vezes um pequeno) e custa O(n^2). A
+// árvore multiplica pares de tamanhos parecidos, o que aproveita Karatsuba e
+// NTT; quando chamada de um worker do Scheduler, as subárvores grandes viram
+// tarefas
+
+// Produto de n BigInts (1 se n == 0). Retorna NULL se algum for NULL
+BigInt *bigint_product(const BigInt **xs, size_t n);
+
+// Calcula n! pelo método do prime swing: n! = ((n/2)!)^2 * swing(n), onde
+// swing(n) é um produto de potências de primos calculado com a árvore
+// Retorna NULL se n for negativo ou não couber em 32 bits
+BigInt *bigint_factorial(const BigInt *n);
+
+// Calcula o coeficiente binomial C(n, k) pela fatoração de Legendre/Kummer
+// (o expoente de cada primo p <= n é a quantidade de "vai um" ao somar k e
+// n - k na base p). Retorna 0 se k < 0 ou k > n, e NULL se n for negativo
+// ou não couber em 32 bits
+BigInt *bigint_binomial(const BigInt *n, const BigInt *k);
+
+// Árvore de restos: out[i] = x mod |moduli[i]| (0 <= out[i] < |moduli[i]|)
+// O produto dos módulos é montado em árvore e x desce por ela, sendo
+// reduzido a cada nó; o custo é o de algumas multiplicações do tamanho do
+// produto, e não n divisões de x inteiro. Os nós de cada nível são
+// calculados em paralelo dentro de um worker do Scheduler
+// Retorna um array de n BigInts (libere com bigint_batch_free) ou NULL em
+// erro, inclusive se algum módulo for zero
+BigInt **bigint_batch_mod(const BigInt *x, const BigInt **moduli, size_t n);
+
+// Batch GCD de Bernstein: out[i] = mdc(|xs[i]|, produto dos demais)
+// Calcula P = produto de todos com a árvore, desce P pela árvore de restos
+// reduzindo módulo o quadrado de cada nó e termina com
+// out[i] = mdc(x_i, (P mod x_i^2) / x_i). Substitui as n^2 chamadas de
+// bigint_gcd par a par. out[i] > 1 indica fator comum com outro elemento
+// Retorna um array de n BigInts (libere com bigint_batch_free) ou NULL em
+// erro, inclusive se algum elemento for zero
+BigInt **bigint_batch_gcd(const BigInt **xs, size_t n);
+
+// Libera um array retornado por bigint_batch_mod ou bigint_batch_gcd
+void bigint_batch_free(BigInt **xs, size_t n);
+
+#endif // PRODUCTTREE_H
@@ -0,0 +1,468 @@
+#include "Radix.h"
+#include "../Limbs/Limbs.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Tuning/Tuning.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Potências de 10 usadas para agrupar 9 dígitos decimais por limb
+static const uint32_t pow10_u32[10] = {
+    1,      10,      100,      1000,      10000,
+    100000, 1000000, 10000000, 100000000, 1000000000};
+
+// Dígitos decimais agrupados por passo de conversão (10^9 < 2^32)
+#define DECIMAL_CHUNK_DIGITS 9
+#define DECIMAL_CHUNK_BASE   1000000000U
+
+// Níveis da tabela cuja potência tem menos limbs que isto são convertidos
+// grupo a grupo (O(n^2), mas com constante pequena). Ajustável por máquina:
+// make tune ou PE_RADIX_DC_THRESHOLD
+#define RADIX_DC_THRESHOLD tuning_get(TUNE_RADIX_DC)
+
+// Níveis a partir deste tamanho dividem com recíproco pré-calculado
+// (Barrett); abaixo dele o algoritmo D de Knuth é mais rápido
+#define RADIX_PREINV_THRESHOLD 1000
+
+// Abaixo desta quantidade de dígitos a leitura é feita grupo a grupo
+#define RADIX_PARSE_BASECASE (DECIMAL_CHUNK_DIGITS * RADIX_DC_THRESHOLD * 2)
+
+// Tamanho mínimo (em limbs) para converter as duas metades em paralelo
+#define RADIX_PARALLEL_MIN 2048
+
+// 9 * 2^64 dígitos nunca cabem na memória
+#define RADIX_MAX_LEVELS 64
+
+// Tabela de potências pow[k] = 10^(9 * 2^k), compartilhada (somente
+// leitura) pelas tarefas de uma conversão
+typedef struct {
+  uint32_t *pow[RADIX_MAX_LEVELS];
+  size_t len[RADIX_MAX_LEVELS];
+  uint32_t *inv[RADIX_MAX_LEVELS]; // Recíproco de pow[k] (níveis grandes)
+  size_t levels;
+} PowerTable;
+
+static void table_free(PowerTable *t) {
+  for (size_t k = 0; k < t->levels; k++) {
+    free(t->pow[k]);
+    free(t->inv[k]);
+  }
+  t->levels = 0;
+}
+
+// Acrescenta o próximo nível (quadrado do anterior). Retorna 0 em erro
+static int table_extend(PowerTable *t) {
+  size_t k = t->levels;
+  if (k == RADIX_MAX_LEVELS) {
+    return 0;
+  }
+
+  uint32_t *p;
+  size_t len;
+  if (k == 0) {
+    p = malloc(sizeof(uint32_t));
+    len = 1;
+    if (p != NULL) {
+      p[0] = DECIMAL_CHUNK_BASE;
+    }
+  } else {
+    size_t prev = t->len[k - 1];
+    p = malloc(2 * prev * sizeof(uint32_t));
+    len = 2 * prev;
+    if (p != NULL) {
+      limbs_mul(p, t->pow[k - 1], prev, t->pow[k - 1], prev);
+      len = limbs_normalized_length(p, len);
+    }
+  }
+  if (p == NULL) {
+    return 0;
+  }
+
+  t->pow[k] = p;
+  t->len[k] = len;
+  t->inv[k] = NULL;
+  t->levels++;
+  return 1;
+}
+
+typedef struct {
+  PowerTable *t;
+  size_t k;
+  int ok;
+} ReciprocalJob;
+
+static void reciprocal_task(void *arg) {
+  ReciprocalJob *job = arg;
+  size_t m = job->t->len[job->k];
+  uint32_t *inv = malloc((m + 2) * sizeof(uint32_t));
+  job->ok = inv != NULL && limbs_reciprocal(inv, job->t->pow[job->k], m);
+  if (!job->ok) {
+    free(inv);
+    inv = NULL;
+  }
+  job->t->inv[job->k] = inv;
+}
+
+// Calcula os recíprocos dos níveis usados na divisão e conquista
+// Os níveis são independentes, então viram tarefas quando há workers
+static int table_reciprocals(PowerTable *t) {
+  ReciprocalJob jobs[RADIX_MAX_LEVELS];
+  Scheduler *s = scheduler_current();
+  TaskGroup group = {0};
+
+  for (size_t k = 0; k < t->levels; k++) {
+    jobs[k].t = t;
+    jobs[k].k = k;
+    jobs[k].ok = 1;
+    if (t->len[k] < RADIX_PREINV_THRESHOLD) {
+      continue;
+    }
+    if (s != NULL) {
+      scheduler_spawn(s, &group, reciprocal_task, &jobs[k]);
+    } else {
+      reciprocal_task(&jobs[k]);
+    }
+  }
+  if (s != NULL) {
+    scheduler_wait(s, &group);
+  }
+
+  for (size_t k = 0; k < t->levels; k++) {
+    if (!jobs[k].ok) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Limbs -> decimal
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  const PowerTable *t;
+  int failed; // Acesso atômico: alguma tarefa ficou sem memória
+} ConvContext;
+
+typedef struct {
+  ConvContext *ctx;
+  const uint32_t *x;
+  size_t xn;
+  size_t k;
+  char *out;   // Início (com zeros à esquerda) ou fim (sem), conforme a tarefa
+  char *start; // Primeiro dígito escrito (conversão sem zeros à esquerda)
+} ConvJob;
+
+static void conv_fail(ConvContext *ctx) {
+  __atomic_store_n(&ctx->failed, 1, __ATOMIC_RELAXED);
+}
+
+// Escreve 9 dígitos de um grupo terminando antes de p
+static char *write_chunk(char *p, uint32_t chunk) {
+  for (int d = 0; d < DECIMAL_CHUNK_DIGITS; d++) {
+    *--p = (char)('0' + chunk % 10);
+    chunk /= 10;
+  }
+  return p;
+}
+
+// Caso base: divide sucessivamente por 10^9 (grupos de 9 dígitos, LSB
+// primeiro), escrevendo da direita para a esquerda a partir de end
+// Se begin não for NULL, completa com zeros até begin; senão para no
+// dígito mais significativo. Retorna o primeiro dígito ou NULL em erro
+static char *write_basecase(const uint32_t *x, size_t xn, char *begin,
+                            char *end) {
+  uint32_t *tmp = malloc((xn > 0 ? xn : 1) * sizeof(uint32_t));
+  if (tmp == NULL) {
+    return NULL;
+  }
+  memcpy(tmp, x, xn * sizeof(uint32_t));
+
+  char *p = end;
+  size_t used = limbs_normalized_length(tmp, xn);
+  while (used > 0) {
+    uint32_t chunk = limbs_divmod_1(tmp, tmp, used, DECIMAL_CHUNK_BASE);
+    used = limbs_normalized_length(tmp, used);
+    if (used > 0 || begin != NULL) {
+      p = write_chunk(p, chunk);
+    } else {
+      do {
+        *--p = (char)('0' + chunk % 10);
+        chunk /= 10;
+      } while (chunk > 0);
+    }
+  }
+  free(tmp);
+
+  if (begin != NULL) {
+    memset(begin, '0', (size_t)(p - begin));
+    p = begin;
+  } else if (p == end) {
+    *--p = '0';
+  }
+  return p;
+}
+
+// Divide x por pow[k]; *q e *r são alocados (quem chamar deve liberar)
+static int split(const PowerTable *t, size_t k, const uint32_t *x, size_t xn,
+                 uint32_t **q, size_t *qn, uint32_t **r) {
+  size_t m = t->len[k];
+  *qn = xn >= m ? xn - m + 1 : 1;
+  *q = calloc(*qn, sizeof(uint32_t));
+  *r = calloc(m, sizeof(uint32_t));
+  int ok = *q != NULL && *r != NULL;
+  if (ok && xn < m) {
+    memcpy(*r, x, xn * sizeof(uint32_t));
+  } else if (ok && t->inv[k] != NULL) {
+    ok = limbs_divmod_preinv(*q, *r, x, xn, t->pow[k], m, t->inv[k]);
+  } else if (ok) {
+    ok = limbs_divmod(*q, *r, x, xn, t->pow[k], m);
+  }
+  if (!ok) {
+    free(*q);
+    free(*r);
+    return 0;
+  }
+  return 1;
+}
+
+// Escreve x (< pow[k]^2) com exatamente 9 * 2^(k+1) dígitos a partir de out
+static void conv_padded_task(void *arg) {
+  ConvJob *job = arg;
+  const PowerTable *t = job->ctx->t;
+  size_t k = job->k;
+  size_t half = (size_t)DECIMAL_CHUNK_DIGITS << k;
+  size_t xn = limbs_normalized_length(job->x, job->xn);
+
+  if (t->len[k] < RADIX_DC_THRESHOLD) {
+    if (write_basecase(job->x, xn, job->out, job->out + 2 * half) == NULL) {
+      conv_fail(job->ctx);
+    }
+    return;
+  }
+
+  uint32_t *q, *r;
+  size_t qn;
+  if (!split(t, k, job->x, xn, &q, &qn, &r)) {
+    conv_fail(job->ctx);
+    return;
+  }
+
+  ConvJob hi = {job->ctx, q, qn, k - 1, job->out, NULL};
+  ConvJob lo = {job->ctx, r, t->len[k], k - 1, job->out + half, NULL};
+  scheduler_fork_join(conv_padded_task, &hi, conv_padded_task, &lo,
+                      xn >= RADIX_PARALLEL_MIN);
+  free(q);
+  free(r);
+}
+
+// Escreve x (< pow[k]^2) sem zeros à esquerda terminando antes de out
+static void conv_top_task(void *arg) {
+  ConvJob *job = arg;
+  const PowerTable *t = job->ctx->t;
+  size_t k = job->k;
+  size_t xn = limbs_normalized_length(job->x, job->xn);
+
+  // Desce até o nível em que x tem a metade alta não nula
+  while (t->len[k] >= RADIX_DC_THRESHOLD &&
+         limbs_cmp(job->x, xn, t->pow[k], t->len[k]) < 0) {
+    k--;
+  }
+
+  if (t->len[k] < RADIX_DC_THRESHOLD) {
+    job->start = write_basecase(job->x, xn, NULL, job->out);
+    if (job->start == NULL) {
+      conv_fail(job->ctx);
+    }
+    return;
+  }
+
+  uint32_t *q, *r;
+  size_t qn;
+  if (!split(t, k, job->x, xn, &q, &qn, &r)) {
+    conv_fail(job->ctx);
+    return;
+  }
+
+  // O resto ocupa exatamente os últimos 9 * 2^k dígitos; o quociente
+  // termina logo antes dele
+  size_t half = (size_t)DECIMAL_CHUNK_DIGITS << k;
+  ConvJob hi = {job->ctx, q, qn, k - 1, job->out - half, NULL};
+  ConvJob lo = {job->ctx, r, t->len[k], k - 1, job->out - half, NULL};
+  scheduler_fork_join(conv_top_task, &hi, conv_padded_task, &lo,
+                      xn >= RADIX_PARALLEL_MIN);
+  job->start = hi.start;
+  free(q);
+  free(r);
+}
+
+size_t radix_decimal_capacity(size_t n) {
+  // Cada limb tem no máximo 32 * log10(2) < 9.64 dígitos
+  return n * 10 + 1;
+}
+
+char *radix_write_decimal(char *end, const uint32_t *limbs, size_t n) {
+  n = limbs_normalized_length(limbs, n);
+  if (n < 2 * RADIX_DC_THRESHOLD) {
+    return write_basecase(limbs, n, NULL, end);
+  }
+
+  // Níveis até pow[K]^2 > x: basta 2 * (len[K] - 1) >= n
+  PowerTable t;
+  t.levels = 0;
+  int ok = 1;
+  while (ok && (t.levels == 0 || 2 * (t.len[t.levels - 1] - 1) < n)) {
+    ok = table_extend(&t);
+  }
+  ok = ok && table_reciprocals(&t);
+
+  ConvContext ctx = {&t, 0};
+  ConvJob job = {&ctx, limbs, n, t.levels - 1, end, NULL};
+  if (ok) {
+    conv_top_task(&job);
+  }
+
+  table_free(&t);
+  return ok && !ctx.failed ? job.start : NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Decimal -> limbs
+// ---------------------------------------------------------------------------
+
+typedef struct {
+  ConvContext *ctx;
+  const char *digits;
+  size_t len;
+  size_t k;
+  uint32_t *limbs; // Resultado (alocado pela tarefa)
+  size_t n;
+} ParseJob;
+
+// Multiplica um array de limbs por um multiplicador e adiciona um valor
+// Retorna o novo comprimento do array (pode crescer um limb)
+static size_t multiply_limbs_by_uint32_and_add(uint32_t *limbs, size_t len,
+                                               uint32_t multiplier,
+                                               uint32_t add_value) {
+  uint64_t carry = add_value;
+
+  for (size_t i = 0; i < len; i++) {
+    uint64_t cur = (uint64_t)limbs[i] * multiplier + carry;
+    limbs[i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+
+  if (carry > 0) {
+    limbs[len++] = (uint32_t)carry;
+  }
+
+  return len;
+}
+
+// Caso base: limbs = limbs * 10^k + grupo, do grupo mais significativo ao
+// menos, com 9 dígitos por passo
+static uint32_t *read_basecase(const char *digits, size_t len, size_t *n) {
+  // Cada grupo de 9 dígitos ocupa no máximo um limb (10^9 < 2^32)
+  uint32_t *limbs = malloc((len / DECIMAL_CHUNK_DIGITS + 2) * sizeof(uint32_t));
+  if (limbs == NULL) {
+    return NULL;
+  }
+
+  size_t used = 0;
+  size_t pos = 0;
+  size_t group = len % DECIMAL_CHUNK_DIGITS;
+  if (group == 0) {
+    group = DECIMAL_CHUNK_DIGITS;
+  }
+
+  while (pos < len) {
+    uint32_t value = 0;
+    for (size_t k = 0; k < group; k++) {
+      value = value * 10 + (uint32_t)(digits[pos + k] - '0');
+    }
+    used = multiply_limbs_by_uint32_and_add(limbs, used, pow10_u32[group],
+                                            value);
+    pos += group;
+    group = DECIMAL_CHUNK_DIGITS;
+  }
+
+  *n = used;
+  return limbs;
+}
+
+static void parse_task(void *arg) {
+  ParseJob *job = arg;
+  const PowerTable *t = job->ctx->t;
+
+  if (job->len <= RADIX_PARSE_BASECASE) {
+    job->limbs = read_basecase(job->digits, job->len, &job->n);
+    if (job->limbs == NULL) {
+      conv_fail(job->ctx);
+    }
+    return;
+  }
+
+  // Maior nível com 9 * 2^k < len: a parte baixa tem 9 * 2^k dígitos e a
+  // alta tem no máximo isso
+  size_t k = job->k;
+  while (k > 0 && ((size_t)DECIMAL_CHUNK_DIGITS << k) >= job->len) {
+    k--;
+  }
+  size_t half = (size_t)DECIMAL_CHUNK_DIGITS << k;
+
+  ParseJob hi = {job->ctx, job->digits, job->len - half, k, NULL, 0};
+  ParseJob lo = {job->ctx, job->digits + job->len - half, half, k, NULL, 0};
+  scheduler_fork_join(parse_task, &hi, parse_task, &lo,
+                      job->len / DECIMAL_CHUNK_DIGITS >= RADIX_PARALLEL_MIN);
+
+  // x = alto * 10^(9 * 2^k) + baixo, com baixo < 10^(9 * 2^k)
+  size_t m = t->len[k];
+  size_t n = hi.n + m + 1;
+  uint32_t *x = hi.limbs != NULL && lo.limbs != NULL
+                    ? calloc(n, sizeof(uint32_t))
+                    : NULL;
+  if (x != NULL) {
+    if (hi.n > 0) {
+      limbs_mul(x, hi.limbs, hi.n, t->pow[k], m);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n && (i < lo.n || carry > 0); i++) {
+      uint64_t cur = (uint64_t)x[i] + (i < lo.n ? lo.limbs[i] : 0) + carry;
+      x[i] = (uint32_t)(cur & UINT32_MAX);
+      carry = cur >> 32;
+    }
+    job->limbs = x;
+    job->n = limbs_normalized_length(x, n);
+  } else {
+    conv_fail(job->ctx);
+  }
+
+  free(hi.limbs);
+  free(lo.limbs);
+}
+
+uint32_t *radix_read_decimal(const char *digits, size_t len, size_t *n) {
+  if (len <= RADIX_PARSE_BASECASE) {
+    return read_basecase(digits, len, n);
+  }
+
+  PowerTable t;
+  t.levels = 0;
+  int ok = 1;
+  while (ok && ((size_t)DECIMAL_CHUNK_DIGITS << t.levels) < len) {
+    ok = table_extend(&t);
+  }
+
+  ConvContext ctx = {&t, 0};
+  ParseJob job = {&ctx, digits, len, t.levels - 1, NULL, 0};
+  if (ok) {
+    parse_task(&job);
+  }
+  table_free(&t);
+
+  if (!ok || ctx.failed) {
+    free(job.limbs);
+    return NULL;
+  }
+  *n = job.n;
+  return job.limbs;
+}
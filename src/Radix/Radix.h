@@ -0,0 +1,30 @@
+#ifndef RADIX_H
+#define RADIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Conversão entre base 2^32 (limbs, LSB primeiro) e decimal
+// Números pequenos são convertidos em grupos de 9 dígitos (10^9 < 2^32).
+// Números grandes usam divisão e conquista sobre uma tabela de potências
+// 10^(9 * 2^k), montada uma vez por conversão e compartilhada por todas as
+// metades: para escrever, x = q * 10^(9 * 2^k) + r e cada metade é gravada
+// direto na sua posição do buffer final (r sempre ocupa exatamente
+// 9 * 2^k dígitos); para ler, x = alto * 10^(9 * 2^k) + baixo. Quando
+// chamadas de um worker do Scheduler, as metades grandes viram tarefas
+
+// Quantidade máxima de dígitos decimais de um número com n limbs
+size_t radix_decimal_capacity(size_t n);
+
+// Escreve os dígitos decimais de limbs (sem sinal e sem zeros à esquerda)
+// terminando imediatamente antes de end. Precisa de
+// radix_decimal_capacity(n) bytes antes de end
+// Retorna o ponteiro para o primeiro dígito, ou NULL se faltou memória
+char *radix_write_decimal(char *end, const uint32_t *limbs, size_t n);
+
+// Converte len dígitos decimais ('0' a '9') para limbs
+// Retorna um array alocado (quem chamar deve liberar) e preenche *n com a
+// quantidade de limbs usados, ou NULL se faltou memória
+uint32_t *radix_read_decimal(const char *digits, size_t len, size_t *n);
+
+#endif // RADIX_H
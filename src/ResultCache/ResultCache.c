@@ -0,0 +1,442 @@
+#include "ResultCache.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Quantidade inicial de buckets das tabelas (dobra quando enche)
+#define CACHE_INITIAL_BUCKETS 64
+
+struct BigIntHandle {
+  BigInt *value;
+  uint64_t hash;
+  size_t refs;
+  size_t bytes;
+  BigIntHandle *next; // Próximo no bucket
+};
+
+typedef struct CacheEntry {
+  uint64_t key; // Hash de (op, hashes dos operandos)
+  int op;
+  size_t n;
+  BigIntHandle **args;
+  BigIntHandle *result;
+  size_t bytes;
+  struct CacheEntry *next; // Próximo no bucket
+  struct CacheEntry *newer, *older; // Lista LRU
+} CacheEntry;
+
+struct ResultCache {
+  pthread_mutex_t lock;
+  BigIntHandle **values;
+  size_t value_buckets, value_count;
+  CacheEntry **entries;
+  size_t entry_buckets, entry_count;
+  CacheEntry *newest, *oldest;
+  size_t bytes, budget;
+  size_t hits, misses, evictions;
+};
+
+static uint64_t mix64(uint64_t h) {
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
+}
+
+static uint64_t entry_key(int op, const uint64_t *hashes, size_t n) {
+  uint64_t h = mix64(((uint64_t)(unsigned)op << 32) ^ n);
+  for (size_t i = 0; i < n; i++) {
+    h = mix64(h ^ hashes[i]) + i;
+  }
+  return h;
+}
+
+// Memória ocupada por um valor internado
+static size_t value_bytes(const BigInt *x) {
+  return sizeof(BigIntHandle) + sizeof(BigInt) + sizeof(LinkedList) +
+         x->digits->length * sizeof(ListNode);
+}
+
+ResultCache *cache_create(size_t budget) {
+  ResultCache *c = calloc(1, sizeof(ResultCache));
+  if (c == NULL) {
+    return NULL;
+  }
+  c->values = calloc(CACHE_INITIAL_BUCKETS, sizeof(BigIntHandle *));
+  c->entries = calloc(CACHE_INITIAL_BUCKETS, sizeof(CacheEntry *));
+  if (c->values == NULL || c->entries == NULL) {
+    free(c->values);
+    free(c->entries);
+    free(c);
+    return NULL;
+  }
+  c->value_buckets = CACHE_INITIAL_BUCKETS;
+  c->entry_buckets = CACHE_INITIAL_BUCKETS;
+  c->budget = budget;
+  pthread_mutex_init(&c->lock, NULL);
+  return c;
+}
+
+// Dobra a tabela de valores (mantém a antiga se faltar memória)
+static void grow_values(ResultCache *c) {
+  size_t buckets = c->value_buckets * 2;
+  BigIntHandle **values = calloc(buckets, sizeof(BigIntHandle *));
+  if (values == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < c->value_buckets; i++) {
+    BigIntHandle *h = c->values[i];
+    while (h != NULL) {
+      BigIntHandle *next = h->next;
+      size_t b = h->hash & (buckets - 1);
+      h->next = values[b];
+      values[b] = h;
+      h = next;
+    }
+  }
+  free(c->values);
+  c->values = values;
+  c->value_buckets = buckets;
+}
+
+static void grow_entries(ResultCache *c) {
+  size_t buckets = c->entry_buckets * 2;
+  CacheEntry **entries = calloc(buckets, sizeof(CacheEntry *));
+  if (entries == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < c->entry_buckets; i++) {
+    CacheEntry *e = c->entries[i];
+    while (e != NULL) {
+      CacheEntry *next = e->next;
+      size_t b = e->key & (buckets - 1);
+      e->next = entries[b];
+      entries[b] = e;
+      e = next;
+    }
+  }
+  free(c->entries);
+  c->entries = entries;
+  c->entry_buckets = buckets;
+}
+
+// Interna x (com o lock). hash deve ser bigint_hash(x)
+static BigIntHandle *intern_locked(ResultCache *c, const BigInt *x,
+                                   uint64_t hash) {
+  size_t b = hash & (c->value_buckets - 1);
+  for (BigIntHandle *h = c->values[b]; h != NULL; h = h->next) {
+    if (h->hash == hash && bigint_equal(h->value, x)) {
+      h->refs++;
+      return h;
+    }
+  }
+
+  BigIntHandle *h = malloc(sizeof(BigIntHandle));
+  if (h == NULL) {
+    return NULL;
+  }
+  h->value = bigint_copy(x);
+  if (h->value == NULL) {
+    free(h);
+    return NULL;
+  }
+  h->hash = hash;
+  h->refs = 1;
+  h->bytes = value_bytes(x);
+  h->next = c->values[b];
+  c->values[b] = h;
+  c->value_count++;
+  c->bytes += h->bytes;
+  if (c->value_count > c->value_buckets) {
+    grow_values(c);
+  }
+  return h;
+}
+
+static void release_locked(ResultCache *c, BigIntHandle *h) {
+  if (h == NULL || --h->refs > 0) {
+    return;
+  }
+
+  BigIntHandle **link = &c->values[h->hash & (c->value_buckets - 1)];
+  while (*link != h) {
+    link = &(*link)->next;
+  }
+  *link = h->next;
+  c->value_count--;
+  c->bytes -= h->bytes;
+  bigint_destroy(h->value);
+  free(h);
+}
+
+static void lru_unlink(ResultCache *c, CacheEntry *e) {
+  if (e->newer != NULL) {
+    e->newer->older = e->older;
+  } else {
+    c->newest = e->older;
+  }
+  if (e->older != NULL) {
+    e->older->newer = e->newer;
+  } else {
+    c->oldest = e->newer;
+  }
+}
+
+static void lru_push(ResultCache *c, CacheEntry *e) {
+  e->newer = NULL;
+  e->older = c->newest;
+  if (c->newest != NULL) {
+    c->newest->newer = e;
+  } else {
+    c->oldest = e;
+  }
+  c->newest = e;
+}
+
+static void entry_free(ResultCache *c, CacheEntry *e) {
+  for (size_t i = 0; i < e->n; i++) {
+    release_locked(c, e->args[i]);
+  }
+  release_locked(c, e->result);
+  c->bytes -= e->bytes;
+  free(e->args);
+  free(e);
+}
+
+static void evict_oldest(ResultCache *c) {
+  CacheEntry *e = c->oldest;
+  CacheEntry **link = &c->entries[e->key & (c->entry_buckets - 1)];
+  while (*link != e) {
+    link = &(*link)->next;
+  }
+  *link = e->next;
+  lru_unlink(c, e);
+  c->entry_count--;
+  c->evictions++;
+  entry_free(c, e);
+}
+
+// Procura a entrada (com o lock)
+static CacheEntry *find_locked(ResultCache *c, uint64_t key, int op,
+                               const BigInt **xs, const uint64_t *hashes,
+                               size_t n) {
+  for (CacheEntry *e = c->entries[key & (c->entry_buckets - 1)]; e != NULL;
+       e = e->next) {
+    if (e->key != key || e->op != op || e->n != n) {
+      continue;
+    }
+    size_t i = 0;
+    while (i < n && e->args[i]->hash == hashes[i] &&
+           bigint_equal(e->args[i]->value, xs[i])) {
+      i++;
+    }
+    if (i == n) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+// Hashes dos operandos (buf para poucos operandos, senão aloca)
+static uint64_t *hash_operands(const BigInt **xs, size_t n, uint64_t *buf,
+                               size_t buf_len) {
+  uint64_t *hashes = n <= buf_len ? buf : malloc(n * sizeof(uint64_t));
+  if (hashes == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    hashes[i] = bigint_hash(xs[i]);
+  }
+  return hashes;
+}
+
+BigInt *cache_lookup(ResultCache *c, int op, const BigInt **xs, size_t n) {
+  if (c == NULL || xs == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (xs[i] == NULL) {
+      return NULL;
+    }
+  }
+
+  // O hash é calculado fora do lock
+  uint64_t buf[4] = {0};
+  uint64_t *hashes = hash_operands(xs, n, buf, 4);
+  if (hashes == NULL) {
+    return NULL;
+  }
+  uint64_t key = entry_key(op, hashes, n);
+
+  BigInt *result = NULL;
+  pthread_mutex_lock(&c->lock);
+  CacheEntry *e = find_locked(c, key, op, xs, hashes, n);
+  if (e != NULL) {
+    lru_unlink(c, e);
+    lru_push(c, e);
+    result = bigint_copy(e->result->value);
+  }
+  if (result != NULL) {
+    c->hits++;
+  } else {
+    c->misses++;
+  }
+  pthread_mutex_unlock(&c->lock);
+
+  if (hashes != buf) {
+    free(hashes);
+  }
+  return result;
+}
+
+void cache_store(ResultCache *c, int op, const BigInt **xs, size_t n,
+                 const BigInt *result) {
+  if (c == NULL || xs == NULL || result == NULL) {
+    return;
+  }
+
+  // Entradas que sozinhas estouram o orçamento nem são internadas
+  size_t bytes = sizeof(CacheEntry) + n * sizeof(BigIntHandle *);
+  size_t estimate = bytes + value_bytes(result);
+  for (size_t i = 0; i < n; i++) {
+    if (xs[i] == NULL) {
+      return;
+    }
+    estimate += value_bytes(xs[i]);
+  }
+  if (estimate > c->budget) {
+    return;
+  }
+
+  uint64_t buf[4] = {0};
+  uint64_t *hashes = hash_operands(xs, n, buf, 4);
+  if (hashes == NULL) {
+    return;
+  }
+  uint64_t key = entry_key(op, hashes, n);
+  uint64_t result_hash = bigint_hash(result);
+
+  pthread_mutex_lock(&c->lock);
+  // Outra thread pode ter guardado o mesmo resultado enquanto calculávamos
+  CacheEntry *e = NULL;
+  if (find_locked(c, key, op, xs, hashes, n) == NULL) {
+    e = calloc(1, sizeof(CacheEntry));
+  }
+  if (e != NULL) {
+    e->args = calloc(n > 0 ? n : 1, sizeof(BigIntHandle *));
+    int ok = e->args != NULL;
+    for (size_t i = 0; i < n && ok; i++) {
+      e->args[i] = intern_locked(c, xs[i], hashes[i]);
+      ok = e->args[i] != NULL;
+      e->n = i + 1;
+    }
+    if (ok) {
+      e->result = intern_locked(c, result, result_hash);
+      ok = e->result != NULL;
+    }
+
+    if (!ok) {
+      entry_free(c, e);
+    } else {
+      e->key = key;
+      e->op = op;
+      e->bytes = bytes;
+      c->bytes += bytes;
+      size_t b = key & (c->entry_buckets - 1);
+      e->next = c->entries[b];
+      c->entries[b] = e;
+      lru_push(c, e);
+      c->entry_count++;
+      if (c->entry_count > c->entry_buckets) {
+        grow_entries(c);
+      }
+      while (c->bytes > c->budget && c->oldest != NULL) {
+        evict_oldest(c);
+      }
+    }
+  }
+  pthread_mutex_unlock(&c->lock);
+
+  if (hashes != buf) {
+    free(hashes);
+  }
+}
+
+BigIntHandle *cache_intern(ResultCache *c, const BigInt *x) {
+  if (c == NULL || x == NULL) {
+    return NULL;
+  }
+  uint64_t hash = bigint_hash(x);
+  pthread_mutex_lock(&c->lock);
+  BigIntHandle *h = intern_locked(c, x, hash);
+  pthread_mutex_unlock(&c->lock);
+  return h;
+}
+
+void cache_release(ResultCache *c, BigIntHandle *h) {
+  if (c == NULL || h == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&c->lock);
+  release_locked(c, h);
+  pthread_mutex_unlock(&c->lock);
+}
+
+const BigInt *bigint_handle_value(const BigIntHandle *h) {
+  return h != NULL ? h->value : NULL;
+}
+
+uint64_t bigint_handle_hash(const BigIntHandle *h) {
+  return h != NULL ? h->hash : 0;
+}
+
+void cache_destroy(ResultCache *c) {
+  if (c == NULL) {
+    return;
+  }
+  while (c->oldest != NULL) {
+    evict_oldest(c);
+  }
+  // Handles que ainda tenham referências externas (cache_intern)
+  for (size_t i = 0; i < c->value_buckets; i++) {
+    BigIntHandle *h = c->values[i];
+    while (h != NULL) {
+      BigIntHandle *next = h->next;
+      bigint_destroy(h->value);
+      free(h);
+      h = next;
+    }
+  }
+  pthread_mutex_destroy(&c->lock);
+  free(c->values);
+  free(c->entries);
+  free(c);
+}
+
+void cache_stats(ResultCache *c, ResultCacheStats *out) {
+  pthread_mutex_lock(&c->lock);
+  out->hits = c->hits;
+  out->misses = c->misses;
+  out->evictions = c->evictions;
+  out->entries = c->entry_count;
+  out->values = c->value_count;
+  out->bytes = c->bytes;
+  out->budget = c->budget;
+  pthread_mutex_unlock(&c->lock);
+}
+
+void cache_print_stats(ResultCache *c, FILE *out) {
+  ResultCacheStats st;
+  cache_stats(c, &st);
+  size_t lookups = st.hits + st.misses;
+  fprintf(out,
+          "Cache: %zu acertos, %zu falhas (%.1f%% de acerto), %zu "
+          "descartes\n",
+          st.hits, st.misses,
+          lookups > 0 ? 100.0 * (double)st.hits / (double)lookups : 0.0,
+          st.evictions);
+  fprintf(out, "Cache: %zu resultados, %zu valores, %.1f de %.1f MB\n",
+          st.entries, st.values, (double)st.bytes / (1024.0 * 1024.0),
+          (double)st.budget / (1024.0 * 1024.0));
+}
@@ -0,0 +1,66 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "../BigInt/BigInt.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Cache LRU de resultados de operações, com orçamento de memória
+// A chave é (operação, operandos): o hash de 64 bits dos limbs localiza a
+// entrada e a comparação completa dos valores confirma. Operandos e
+// resultados são guardados como handles internados e imutáveis: um mesmo
+// valor (ex.: um módulo que se repete em muitas linhas) é armazenado uma
+// única vez e compartilhado por todas as entradas que o usam. Pode ser
+// usado por várias threads ao mesmo tempo
+
+typedef struct ResultCache ResultCache;
+
+// Valor internado e imutável (compartilhado, com contagem de referências)
+typedef struct BigIntHandle BigIntHandle;
+
+// Estatísticas do cache
+typedef struct {
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t entries;     // Resultados guardados
+  size_t values;      // Valores internados (operandos e resultados)
+  size_t bytes;       // Memória usada (estimada)
+  size_t budget;      // Orçamento de memória
+} ResultCacheStats;
+
+// Cria um cache que usa no máximo budget bytes. Retorna NULL em erro
+ResultCache *cache_create(size_t budget);
+
+// Destrói o cache e todos os valores internados
+void cache_destroy(ResultCache *c);
+
+// Procura o resultado de (op, xs[0..n)). Retorna uma cópia (quem chamar
+// libera) ou NULL se não estiver no cache. Conta um acerto ou uma falha
+BigInt *cache_lookup(ResultCache *c, int op, const BigInt **xs, size_t n);
+
+// Guarda o resultado de (op, xs[0..n)). Entradas maiores que o orçamento
+// são ignoradas; as menos usadas recentemente saem para abrir espaço
+void cache_store(ResultCache *c, int op, const BigInt **xs, size_t n,
+                 const BigInt *result);
+
+// Interna um valor: retorna o handle existente para um valor igual ou cria
+// um novo com uma cópia de x. Cada chamada conta uma referência (libere com
+// cache_release). Retorna NULL se faltou memória
+BigIntHandle *cache_intern(ResultCache *c, const BigInt *x);
+
+// Libera uma referência de um handle
+void cache_release(ResultCache *c, BigIntHandle *h);
+
+// Valor e hash de um handle (o valor não pode ser modificado)
+const BigInt *bigint_handle_value(const BigIntHandle *h);
+uint64_t bigint_handle_hash(const BigIntHandle *h);
+
+// Copia as estatísticas para out
+void cache_stats(ResultCache *c, ResultCacheStats *out);
+
+// Imprime as estatísticas (acertos, falhas, memória)
+void cache_print_stats(ResultCache *c, FILE *out);
+
+#endif // RESULTCACHE_H
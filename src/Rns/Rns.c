@@ -0,0 +1,448 @@
+#include "Rns.h"
+#include "../Limbs/Limbs.h"
+#include "../Scheduler/Scheduler.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Os primos ficam entre 2^32 / 3 e 2^31: um limb qualquer é menor que 3p
+// (reduz com duas subtrações) e um resíduo de um primo é menor que o dobro
+// de qualquer outro (reduz com uma)
+#define RNS_MIN_PRIME 0x55555556u
+#define RNS_MAX_PRIME 0x7FFFFFFFu
+
+// Resíduos por tarefa nas operações elemento a elemento e na conversão de
+// BigInt (que custa um produto por limb em cada primo)
+#define RNS_PARALLEL_GRAIN 4096
+#define RNS_REDUCE_GRAIN 64
+
+// Dígitos da base mista calculados em sequência antes de propagar o bloco
+// para os demais primos (em paralelo)
+#define RNS_GARNER_BLOCK 64
+#define RNS_GARNER_GRAIN 256
+
+struct RnsContext {
+  size_t k;
+  uint32_t *p;    // Primos
+  uint32_t *pinv; // -p^-1 mod 2^32
+  uint32_t *one;  // R mod p (1 na forma de Montgomery, R = 2^32)
+  uint32_t *r2;   // R^2 mod p
+  uint32_t *m;    // M = p_0 * ... * p_(k-1)
+  size_t mn;
+  uint32_t *half; // floor(M / 2)
+  size_t halfn;
+};
+
+// Produto de Montgomery: a * b * R^-1 mod p (a, b < p < 2^31)
+static inline uint32_t mont_mul(uint32_t a, uint32_t b, uint32_t p,
+                                uint32_t pinv) {
+  uint64_t t = (uint64_t)a * b;
+  uint32_t q = (uint32_t)t * pinv;
+  uint32_t u = (uint32_t)((t + (uint64_t)q * p) >> 32);
+  return u >= p ? u - p : u;
+}
+
+static inline uint32_t add_mod(uint32_t a, uint32_t b, uint32_t p) {
+  uint32_t s = a + b;
+  return s >= p ? s - p : s;
+}
+
+static inline uint32_t sub_mod(uint32_t a, uint32_t b, uint32_t p) {
+  uint32_t d = a - b;
+  return a < b ? d + p : d;
+}
+
+// x^e com x na forma de Montgomery (resultado também)
+static uint32_t mont_pow(uint32_t x, uint32_t e, uint32_t one, uint32_t p,
+                         uint32_t pinv) {
+  uint32_t acc = one;
+  while (e > 0) {
+    if (e & 1) {
+      acc = mont_mul(acc, x, p, pinv);
+    }
+    x = mont_mul(x, x, p, pinv);
+    e >>= 1;
+  }
+  return acc;
+}
+
+static uint64_t pow_mod(uint64_t b, uint64_t e, uint64_t n) {
+  uint64_t acc = 1;
+  b %= n;
+  while (e > 0) {
+    if (e & 1) {
+      acc = acc * b % n;
+    }
+    b = b * b % n;
+    e >>= 1;
+  }
+  return acc;
+}
+
+// Miller-Rabin determinístico para n < 2^32 (bases 2, 7 e 61)
+static int is_prime(uint32_t n) {
+  static const uint32_t bases[] = {2, 7, 61};
+  if (n < 2 || n % 2 == 0) {
+    return n == 2;
+  }
+
+  uint32_t d = n - 1;
+  int s = 0;
+  while (d % 2 == 0) {
+    d /= 2;
+    s++;
+  }
+
+  for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+    if (bases[i] % n == 0) {
+      continue;
+    }
+    uint64_t x = pow_mod(bases[i], d, n);
+    if (x == 1 || x == n - 1) {
+      continue;
+    }
+    int composite = 1;
+    for (int r = 1; r < s && composite; r++) {
+      x = x * x % n;
+      composite = x != n - 1;
+    }
+    if (composite) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static size_t bit_length(const uint32_t *a, size_t n) {
+  if (n == 0) {
+    return 0;
+  }
+  size_t bits = (n - 1) * 32;
+  for (uint32_t top = a[n - 1]; top != 0; top >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// a = a * w + add (a tem espaço para n + 1 limbs). Retorna o novo tamanho
+static size_t mul_word_add(uint32_t *a, size_t n, uint32_t w, uint32_t add) {
+  uint64_t carry = add;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t cur = (uint64_t)a[i] * w + carry;
+    a[i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  if (carry != 0) {
+    a[n++] = (uint32_t)carry;
+  }
+  return n;
+}
+
+RnsContext *rns_context_create(size_t bits) {
+  RnsContext *ctx = calloc(1, sizeof(RnsContext));
+  if (ctx == NULL) {
+    return NULL;
+  }
+
+  // M > 2^(bits + 1) garante |x| < 2^bits < M / 2. Cada primo tem mais de
+  // 30 bits, o que limita a quantidade de primos
+  size_t target = bits + 2;
+  size_t cap = target / 30 + 2;
+  ctx->p = malloc(cap * sizeof(uint32_t));
+  ctx->pinv = malloc(cap * sizeof(uint32_t));
+  ctx->one = malloc(cap * sizeof(uint32_t));
+  ctx->r2 = malloc(cap * sizeof(uint32_t));
+  ctx->m = malloc((cap + 1) * sizeof(uint32_t));
+  ctx->half = malloc((cap + 1) * sizeof(uint32_t));
+  if (ctx->p == NULL || ctx->pinv == NULL || ctx->one == NULL ||
+      ctx->r2 == NULL || ctx->m == NULL || ctx->half == NULL) {
+    rns_context_destroy(ctx);
+    return NULL;
+  }
+
+  ctx->m[0] = 1;
+  ctx->mn = 1;
+  for (uint32_t c = RNS_MAX_PRIME; bit_length(ctx->m, ctx->mn) < target;
+       c -= 2) {
+    if (c < RNS_MIN_PRIME) {
+      rns_context_destroy(ctx);
+      return NULL;
+    }
+    if (!is_prime(c)) {
+      continue;
+    }
+
+    size_t i = ctx->k++;
+    ctx->p[i] = c;
+
+    // Inverso módulo 2^32 por Newton (cada passo dobra os bits corretos)
+    uint32_t inv = c;
+    for (int it = 0; it < 4; it++) {
+      inv *= 2 - c * inv;
+    }
+    ctx->pinv[i] = -inv;
+    ctx->one[i] = (uint32_t)((UINT64_C(1) << 32) % c);
+    ctx->r2[i] = (uint32_t)((uint64_t)ctx->one[i] * ctx->one[i] % c);
+    ctx->mn = mul_word_add(ctx->m, ctx->mn, c, 0);
+  }
+
+  // M é ímpar, então floor(M / 2) = M >> 1
+  for (size_t i = 0; i < ctx->mn; i++) {
+    uint32_t next = i + 1 < ctx->mn ? ctx->m[i + 1] : 0;
+    ctx->half[i] = (ctx->m[i] >> 1) | (next << 31);
+  }
+  ctx->halfn = limbs_normalized_length(ctx->half, ctx->mn);
+  return ctx;
+}
+
+void rns_context_destroy(RnsContext *ctx) {
+  if (ctx == NULL) {
+    return;
+  }
+  free(ctx->p);
+  free(ctx->pinv);
+  free(ctx->one);
+  free(ctx->r2);
+  free(ctx->m);
+  free(ctx->half);
+  free(ctx);
+}
+
+size_t rns_context_size(const RnsContext *ctx) { return ctx->k; }
+
+// Conversão de limbs para resíduos: Horner em cada primo
+typedef struct {
+  const RnsContext *ctx;
+  const uint32_t *limbs;
+  size_t n;
+  int negative;
+  uint32_t *out;
+} ReduceJob;
+
+static void reduce_range(void *arg, size_t begin, size_t end) {
+  ReduceJob *job = arg;
+  const RnsContext *ctx = job->ctx;
+
+  for (size_t i = begin; i < end; i++) {
+    uint32_t p = ctx->p[i];
+    uint32_t pinv = ctx->pinv[i];
+    uint32_t r2 = ctx->r2[i];
+    uint32_t r = 0;
+    for (size_t j = job->n; j-- > 0;) {
+      uint32_t limb = job->limbs[j];
+      limb = limb >= 2 * p ? limb - 2 * p : limb;
+      limb = limb >= p ? limb - p : limb;
+      // r * 2^32 + limb (mod p)
+      r = add_mod(mont_mul(r, r2, p, pinv), limb, p);
+    }
+    if (job->negative && r != 0) {
+      r = p - r;
+    }
+    job->out[i] = mont_mul(r, r2, p, pinv);
+  }
+}
+
+static RnsNumber *create_from_limbs(const RnsContext *ctx,
+                                    const uint32_t *limbs, size_t n,
+                                    int negative) {
+  RnsNumber *x = malloc(sizeof(RnsNumber));
+  if (x == NULL) {
+    return NULL;
+  }
+  x->ctx = ctx;
+  x->residues = malloc((ctx->k > 0 ? ctx->k : 1) * sizeof(uint32_t));
+  if (x->residues == NULL) {
+    free(x);
+    return NULL;
+  }
+
+  ReduceJob job = {ctx, limbs, n, negative, x->residues};
+  scheduler_parallel_for(ctx->k, RNS_REDUCE_GRAIN, reduce_range, &job);
+  return x;
+}
+
+RnsNumber *rns_create_from_bigint(const RnsContext *ctx, const BigInt *x) {
+  if (ctx == NULL || x == NULL) {
+    return NULL;
+  }
+
+  size_t n = 0;
+  uint32_t *limbs = bigint_export_limbs(x, &n);
+  if (limbs == NULL) {
+    return NULL;
+  }
+  RnsNumber *out = create_from_limbs(ctx, limbs, n, x->sign < 0);
+  free(limbs);
+  return out;
+}
+
+RnsNumber *rns_create_from_int(const RnsContext *ctx, int64_t v) {
+  if (ctx == NULL) {
+    return NULL;
+  }
+
+  uint64_t mag = v < 0 ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+  uint32_t limbs[2] = {(uint32_t)(mag & UINT32_MAX), (uint32_t)(mag >> 32)};
+  return create_from_limbs(ctx, limbs, 2, v < 0);
+}
+
+void rns_destroy(RnsNumber *x) {
+  if (x == NULL) {
+    return;
+  }
+  free(x->residues);
+  free(x);
+}
+
+// Operações elemento a elemento. Cada laço só depende do índice, então
+// vetoriza e divide em tarefas sem sincronização
+typedef struct {
+  const RnsContext *ctx;
+  uint32_t *out;
+  const uint32_t *a;
+  const uint32_t *b;
+} OpJob;
+
+static void add_range(void *arg, size_t begin, size_t end) {
+  OpJob *job = arg;
+  const uint32_t *p = job->ctx->p;
+  for (size_t i = begin; i < end; i++) {
+    job->out[i] = add_mod(job->a[i], job->b[i], p[i]);
+  }
+}
+
+static void sub_range(void *arg, size_t begin, size_t end) {
+  OpJob *job = arg;
+  const uint32_t *p = job->ctx->p;
+  for (size_t i = begin; i < end; i++) {
+    job->out[i] = sub_mod(job->a[i], job->b[i], p[i]);
+  }
+}
+
+static void mul_range(void *arg, size_t begin, size_t end) {
+  OpJob *job = arg;
+  const uint32_t *p = job->ctx->p;
+  const uint32_t *pinv = job->ctx->pinv;
+  for (size_t i = begin; i < end; i++) {
+    job->out[i] = mont_mul(job->a[i], job->b[i], p[i], pinv[i]);
+  }
+}
+
+static int run_op(RnsNumber *out, const RnsNumber *a, const RnsNumber *b,
+                  SchedulerRangeFn fn) {
+  if (out == NULL || a == NULL || b == NULL || a->ctx != b->ctx ||
+      out->ctx != a->ctx) {
+    return 0;
+  }
+  OpJob job = {a->ctx, out->residues, a->residues, b->residues};
+  scheduler_parallel_for(a->ctx->k, RNS_PARALLEL_GRAIN, fn, &job);
+  return 1;
+}
+
+int rns_add(RnsNumber *out, const RnsNumber *a, const RnsNumber *b) {
+  return run_op(out, a, b, add_range);
+}
+
+int rns_sub(RnsNumber *out, const RnsNumber *a, const RnsNumber *b) {
+  return run_op(out, a, b, sub_range);
+}
+
+int rns_mul(RnsNumber *out, const RnsNumber *a, const RnsNumber *b) {
+  return run_op(out, a, b, mul_range);
+}
+
+// Estado do algoritmo de Garner. Para cada primo p_i ainda sem dígito:
+// v[i] = a_0 + a_1 p_0 + ... + a_(j-1) p_0 ... p_(j-2) (mod p_i) e
+// q[i] = p_0 ... p_(j-1) * R (mod p_i), onde j é o próximo dígito
+typedef struct {
+  const RnsContext *ctx;
+  const uint32_t *digits; // Dígitos a_j da base mista
+  uint32_t *v;
+  uint32_t *q;
+  size_t first, last; // Bloco de dígitos [first, last) a propagar
+  size_t offset;      // Primeiro primo a atualizar
+} GarnerJob;
+
+// Acrescenta o dígito j à soma parcial do primo i
+static inline void garner_update(const RnsContext *ctx, uint32_t *v,
+                                 uint32_t *q, size_t i, size_t j,
+                                 uint32_t digit) {
+  uint32_t p = ctx->p[i];
+  uint32_t pinv = ctx->pinv[i];
+  uint32_t d = digit >= p ? digit - p : digit;
+  uint32_t pj = ctx->p[j] >= p ? ctx->p[j] - p : ctx->p[j];
+  v[i] = add_mod(v[i], mont_mul(d, q[i], p, pinv), p);
+  q[i] = mont_mul(q[i], mont_mul(pj, ctx->r2[i], p, pinv), p, pinv);
+}
+
+static void garner_range(void *arg, size_t begin, size_t end) {
+  GarnerJob *job = arg;
+  for (size_t i = job->offset + begin; i < job->offset + end; i++) {
+    for (size_t j = job->first; j < job->last; j++) {
+      garner_update(job->ctx, job->v, job->q, i, j, job->digits[j]);
+    }
+  }
+}
+
+BigInt *rns_to_bigint(const RnsNumber *x) {
+  if (x == NULL) {
+    return NULL;
+  }
+  const RnsContext *ctx = x->ctx;
+  size_t k = ctx->k;
+
+  uint32_t *digits = malloc((k + 1) * sizeof(uint32_t));
+  uint32_t *v = calloc(k + 1, sizeof(uint32_t));
+  uint32_t *q = malloc((k + 1) * sizeof(uint32_t));
+  uint32_t *out = malloc((k + 1) * sizeof(uint32_t));
+  if (digits == NULL || v == NULL || q == NULL || out == NULL) {
+    free(digits);
+    free(v);
+    free(q);
+    free(out);
+    return NULL;
+  }
+  memcpy(q, ctx->one, k * sizeof(uint32_t));
+
+  // Garner em blocos: os dígitos de um bloco dependem uns dos outros e são
+  // calculados em sequência; depois o bloco inteiro é propagado para os
+  // primos seguintes, que são independentes entre si
+  for (size_t first = 0; first < k; first += RNS_GARNER_BLOCK) {
+    size_t last = first + RNS_GARNER_BLOCK < k ? first + RNS_GARNER_BLOCK : k;
+    for (size_t j = first; j < last; j++) {
+      uint32_t p = ctx->p[j];
+      uint32_t pinv = ctx->pinv[j];
+      // a_j = (x_j - v_j) / (p_0 ... p_(j-1)) (mod p_j)
+      uint32_t r = mont_mul(x->residues[j], 1, p, pinv);
+      uint32_t inv = mont_pow(q[j], p - 2, ctx->one[j], p, pinv);
+      digits[j] = mont_mul(sub_mod(r, v[j], p), inv, p, pinv);
+      for (size_t i = j + 1; i < last; i++) {
+        garner_update(ctx, v, q, i, j, digits[j]);
+      }
+    }
+    if (last < k) {
+      GarnerJob job = {ctx, digits, v, q, first, last, last};
+      scheduler_parallel_for(k - last, RNS_GARNER_GRAIN, garner_range, &job);
+    }
+  }
+
+  // x = a_0 + p_0 (a_1 + p_1 (a_2 + ...)), avaliado de cima para baixo
+  size_t n = 0;
+  for (size_t j = k; j-- > 0;) {
+    n = mul_word_add(out, n, ctx->p[j], digits[j]);
+  }
+  n = limbs_normalized_length(out, n);
+
+  int sign = 1;
+  if (limbs_cmp(out, n, ctx->half, ctx->halfn) > 0) {
+    limbs_sub(out, ctx->m, ctx->mn, out, n);
+    n = limbs_normalized_length(out, ctx->mn);
+    sign = -1;
+  }
+
+  BigInt *result = bigint_import_limbs(out, n, sign);
+  free(digits);
+  free(v);
+  free(q);
+  free(out);
+  return result;
+}
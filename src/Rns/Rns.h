@@ -0,0 +1,53 @@
+#ifndef RNS_H
+#define RNS_H
+
+#include "../BigInt/BigInt.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Sistema de resíduos (RNS / multimodular)
+// Um número é guardado como seus restos módulo k primos de 31 bits. Soma,
+// subtração e multiplicação são feitas resíduo a resíduo, sem "vai um"
+// entre eles: cada resíduo é independente (laços simples sobre arrays, que o
+// compilador pode vetorizar, e paralelos dentro de um worker do Scheduler).
+// A volta para BigInt (Garner/CRT) é feita uma única vez, no final de uma
+// cadeia de operações. O contexto precisa ter capacidade para o maior valor
+// intermediário: resultados fora do intervalo dão o valor módulo M
+
+typedef struct RnsContext RnsContext;
+
+typedef struct {
+  const RnsContext *ctx;
+  uint32_t *residues; // Um resíduo por primo (forma de Montgomery)
+} RnsNumber;
+
+// Cria um contexto capaz de representar inteiros com |x| < 2^bits
+// Retorna NULL se faltou memória
+RnsContext *rns_context_create(size_t bits);
+
+// Destrói um contexto (os números criados com ele não podem mais ser usados)
+void rns_context_destroy(RnsContext *ctx);
+
+// Quantidade de primos (resíduos) do contexto
+size_t rns_context_size(const RnsContext *ctx);
+
+// Cria um número a partir de um BigInt. Retorna NULL se faltou memória
+RnsNumber *rns_create_from_bigint(const RnsContext *ctx, const BigInt *x);
+
+// Cria um número a partir de um inteiro. Retorna NULL se faltou memória
+RnsNumber *rns_create_from_int(const RnsContext *ctx, int64_t v);
+
+// Destrói um número
+void rns_destroy(RnsNumber *x);
+
+// out = a + b, out = a - b e out = a * b. out pode ser a ou b
+// Retorna 1 em sucesso ou 0 se os números forem de contextos diferentes
+int rns_add(RnsNumber *out, const RnsNumber *a, const RnsNumber *b);
+int rns_sub(RnsNumber *out, const RnsNumber *a, const RnsNumber *b);
+int rns_mul(RnsNumber *out, const RnsNumber *a, const RnsNumber *b);
+
+// Reconstrói o BigInt (no intervalo simétrico -M/2 < x <= M/2) pelo
+// algoritmo de Garner. Retorna NULL se faltou memória
+BigInt *rns_to_bigint(const RnsNumber *x);
+
+#endif // RNS_H
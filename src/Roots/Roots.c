@@ -0,0 +1,530 @@
+#include "Roots.h"
+#include "../Limbs/Limbs.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Raízes com até esta quantidade de bits saem de uma busca binária (cada
+// passo é uma potência de um limb; abaixo disto Newton não compensa)
+#define ROOT_SEARCH_BITS 32
+
+// Expoentes primos cuja raiz tem até esta quantidade de bits são testados
+// pela estimativa em ponto flutuante, sem percorrer x (o double tem 53 bits
+// de mantissa, então a estimativa erra no máximo uma unidade)
+#define POWER_ESTIMATE_BITS 40
+
+// Testes de resíduo por expoente primo antes de calcular a raiz exata (um
+// não-potência passa em cada teste com probabilidade ~1/p)
+#define POWER_RESIDUE_TESTS 3
+
+static size_t bit_length(const uint32_t *a, size_t an) {
+  if (an == 0) {
+    return 0;
+  }
+  size_t bits = 32 * (an - 1);
+  for (uint32_t top = a[an - 1]; top != 0; top >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+static size_t trailing_zeros(const uint32_t *a, size_t an) {
+  size_t bits = 0, i = 0;
+  while (i < an && a[i] == 0) {
+    bits += 32;
+    i++;
+  }
+  for (uint32_t low = i < an ? a[i] : 1; (low & 1) == 0; low >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+static uint32_t *copy_alloc(const uint32_t *a, size_t an) {
+  uint32_t *out = malloc((an > 0 ? an : 1) * sizeof(uint32_t));
+  if (out != NULL && an > 0) {
+    memcpy(out, a, an * sizeof(uint32_t));
+  }
+  return out;
+}
+
+// Multiplica dois arrays em um novo array normalizado
+static uint32_t *mul_alloc(const uint32_t *a, size_t an, const uint32_t *b,
+                           size_t bn, size_t *n) {
+  uint32_t *out = malloc((an + bn > 0 ? an + bn : 1) * sizeof(uint32_t));
+  if (out == NULL) {
+    return NULL;
+  }
+  limbs_mul(out, a, an, b, bn);
+  *n = limbs_normalized_length(out, an + bn);
+  return out;
+}
+
+// a^e (a != 0, e >= 1) por quadrados sucessivos, da esquerda para a direita
+static uint32_t *pow_alloc(const uint32_t *a, size_t an, uint32_t e,
+                           size_t *n) {
+  uint32_t *r = copy_alloc(a, an);
+  size_t rn = an;
+  int top = 31;
+  while (!((e >> top) & 1)) {
+    top--;
+  }
+  for (int bit = top - 1; bit >= 0 && r != NULL; bit--) {
+    uint32_t *next = mul_alloc(r, rn, r, rn, &rn);
+    free(r);
+    r = next;
+    if (r != NULL && ((e >> bit) & 1)) {
+      next = mul_alloc(r, rn, a, an, &rn);
+      free(r);
+      r = next;
+    }
+  }
+  *n = rn;
+  return r;
+}
+
+// Novo array normalizado com a >> bits
+static uint32_t *shr_alloc(const uint32_t *a, size_t an, size_t bits,
+                           size_t *n) {
+  size_t limbs = bits / 32, shift = bits % 32;
+  size_t rn = an > limbs ? an - limbs : 0;
+  uint32_t *out = malloc((rn > 0 ? rn : 1) * sizeof(uint32_t));
+  if (out == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < rn; i++) {
+    uint64_t cur = a[i + limbs];
+    if (i + limbs + 1 < an) {
+      cur |= (uint64_t)a[i + limbs + 1] << 32;
+    }
+    out[i] = (uint32_t)(cur >> shift);
+  }
+  *n = limbs_normalized_length(out, rn);
+  return out;
+}
+
+// Novo array normalizado com (a + 1) << bits
+static uint32_t *inc_shl_alloc(const uint32_t *a, size_t an, size_t bits,
+                               size_t *n) {
+  size_t limbs = bits / 32, shift = bits % 32;
+  size_t rn = an + limbs + 2;
+  uint32_t *out = calloc(rn, sizeof(uint32_t));
+  if (out == NULL) {
+    return NULL;
+  }
+  uint64_t carry = 1;
+  for (size_t i = 0; i <= an; i++) {
+    uint64_t cur = (i < an ? a[i] : 0) + carry;
+    carry = cur >> 32;
+    // Os bits que saem de um limb entram no seguinte
+    uint64_t shifted = (cur & UINT32_MAX) << shift;
+    out[i + limbs] |= (uint32_t)shifted;
+    out[i + limbs + 1] |= (uint32_t)(shifted >> 32);
+  }
+  *n = limbs_normalized_length(out, rn);
+  return out;
+}
+
+// out = a·w + b, com out de max(an + 1, bn) + 1 limbs. Retorna o
+// comprimento normalizado
+static size_t mul_word_add(uint32_t *out, const uint32_t *a, size_t an,
+                           uint32_t w, const uint32_t *b, size_t bn) {
+  size_t len = (an + 1 > bn ? an + 1 : bn) + 1;
+  uint64_t carry = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint64_t cur = carry;
+    if (i < an) {
+      cur += (uint64_t)a[i] * w;
+    }
+    if (i < bn) {
+      cur += b[i];
+    }
+    out[i] = (uint32_t)(cur & UINT32_MAX);
+    carry = cur >> 32;
+  }
+  return limbs_normalized_length(out, len);
+}
+
+// Um passo de Newton da raiz k-ésima de a: ((k - 1)·x + a / x^(k-1)) / k
+// Partindo de x >= floor(a^(1/k)), o resultado nunca fica abaixo da raiz e
+// é menor que x enquanto x não for a raiz
+static uint32_t *newton_step(const uint32_t *a, size_t an, const uint32_t *x,
+                             size_t xn, uint32_t k, size_t *n) {
+  size_t pn, qn = 0;
+  uint32_t *p = pow_alloc(x, xn, k - 1, &pn);
+  if (p == NULL) {
+    return NULL;
+  }
+
+  uint32_t *q = NULL;
+  int ok = 1;
+  if (limbs_cmp(a, an, p, pn) >= 0) {
+    qn = an - pn + 1;
+    q = malloc(qn * sizeof(uint32_t));
+    uint32_t *r = malloc(pn * sizeof(uint32_t));
+    ok = q != NULL && r != NULL && limbs_divmod(q, r, a, an, p, pn);
+    free(r);
+    qn = ok ? limbs_normalized_length(q, qn) : 0;
+  }
+  free(p);
+
+  size_t tn = (xn + 1 > qn ? xn + 1 : qn) + 1;
+  uint32_t *t = ok ? malloc(tn * sizeof(uint32_t)) : NULL;
+  uint32_t *y = t != NULL ? malloc(tn * sizeof(uint32_t)) : NULL;
+  if (y != NULL) {
+    tn = mul_word_add(t, x, xn, k - 1, q, qn);
+    limbs_divmod_1(y, t, tn, k);
+    *n = limbs_normalized_length(y, tn);
+  }
+  free(q);
+  free(t);
+  return y;
+}
+
+// Raiz de a com até ROOT_SEARCH_BITS bits por busca binária
+static uint32_t *root_search(const uint32_t *a, size_t an, uint32_t k,
+                             size_t rbits, size_t *n) {
+  uint64_t lo = 1, hi = (1ULL << rbits) - 1;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo + 1) / 2;
+    uint32_t w = (uint32_t)mid;
+    size_t pn;
+    uint32_t *p = pow_alloc(&w, 1, k, &pn);
+    if (p == NULL) {
+      return NULL;
+    }
+    if (limbs_cmp(p, pn, a, an) <= 0) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+    free(p);
+  }
+  uint32_t w = (uint32_t)lo;
+  *n = 1;
+  return copy_alloc(&w, 1);
+}
+
+// floor(a^(1/k)) com a normalizado e k >= 1, por precisão dobrada: a raiz
+// de a >> k·s (s = metade dos bits do resultado) mais um, deslocada de s
+// bits, é uma estimativa por cima com metade dos bits certos, e Newton
+// desce dela até a raiz
+static uint32_t *root_limbs(const uint32_t *a, size_t an, uint32_t k,
+                            size_t *n) {
+  size_t bits = bit_length(a, an);
+  if (bits == 0 || k == 1) {
+    *n = an;
+    return copy_alloc(a, an);
+  }
+  if (bits <= k) {
+    // 1 <= a < 2^k
+    uint32_t one = 1;
+    *n = 1;
+    return copy_alloc(&one, 1);
+  }
+
+  size_t rbits = (bits - 1) / k + 1;
+  if (rbits <= ROOT_SEARCH_BITS) {
+    return root_search(a, an, k, rbits, n);
+  }
+
+  size_t s = rbits / 2, hn, xn = 0;
+  uint32_t *high = shr_alloc(a, an, (size_t)k * s, &hn);
+  uint32_t *h = high != NULL ? root_limbs(high, hn, k, &hn) : NULL;
+  free(high);
+  uint32_t *x = h != NULL ? inc_shl_alloc(h, hn, s, &xn) : NULL;
+  free(h);
+
+  while (x != NULL) {
+    size_t yn;
+    uint32_t *y = newton_step(a, an, x, xn, k, &yn);
+    if (y == NULL || limbs_cmp(y, yn, x, xn) >= 0) {
+      if (y == NULL) {
+        free(x);
+        x = NULL;
+      }
+      free(y);
+      break;
+    }
+    free(x);
+    x = y;
+    xn = yn;
+  }
+  *n = xn;
+  return x;
+}
+
+// Exporta |x| normalizado
+static uint32_t *export_abs(const BigInt *x, size_t *n) {
+  uint32_t *a = bigint_export_limbs(x, n);
+  if (a != NULL) {
+    *n = limbs_normalized_length(a, *n);
+  }
+  return a;
+}
+
+// Raiz quadrada inteira com resto
+BigInt *bigint_sqrtrem(const BigInt *x, BigInt **rem) {
+  if (rem != NULL) {
+    *rem = NULL;
+  }
+  if (x == NULL) {
+    return NULL;
+  }
+
+  size_t an, sn, s2n = 0;
+  uint32_t *a = export_abs(x, &an);
+  if (a == NULL || (x->sign < 0 && an > 0)) {
+    free(a);
+    return NULL;
+  }
+
+  uint32_t *s = root_limbs(a, an, 2, &sn);
+  uint32_t *s2 = s != NULL && sn > 0 ? mul_alloc(s, sn, s, sn, &s2n) : NULL;
+  BigInt *root = NULL;
+  if (s != NULL && (sn == 0 || s2 != NULL)) {
+    root = bigint_import_limbs(s, sn, 1);
+    if (root != NULL && rem != NULL) {
+      // a - s^2 no próprio array de a
+      limbs_sub(a, a, an, s2, s2n);
+      *rem = bigint_import_limbs(a, an, 1);
+      if (*rem == NULL) {
+        bigint_destroy(root);
+        root = NULL;
+      }
+    }
+  }
+  free(a);
+  free(s);
+  free(s2);
+  return root;
+}
+
+// Raiz k-ésima inteira truncada para zero
+BigInt *bigint_root(const BigInt *x, uint32_t k) {
+  if (x == NULL || k == 0) {
+    return NULL;
+  }
+
+  size_t an, rn;
+  uint32_t *a = export_abs(x, &an);
+  int negative = x->sign < 0 && an > 0;
+  if (a == NULL || (negative && k % 2 == 0)) {
+    free(a);
+    return NULL;
+  }
+
+  uint32_t *r = root_limbs(a, an, k, &rn);
+  BigInt *root = r != NULL ? bigint_import_limbs(r, rn, negative ? -1 : 1)
+                           : NULL;
+  free(a);
+  free(r);
+  return root;
+}
+
+// ---------------------------------------------------------------------------
+// Potências perfeitas
+// ---------------------------------------------------------------------------
+
+static uint32_t mod_word(const uint32_t *a, size_t an, uint32_t q) {
+  uint64_t r = 0;
+  for (size_t i = an; i-- > 0;) {
+    r = ((r << 32) | a[i]) % q;
+  }
+  return (uint32_t)r;
+}
+
+static uint32_t pow_mod_word(uint32_t b, uint64_t e, uint32_t q) {
+  uint64_t r = 1, base = b % q;
+  while (e > 0) {
+    if (e & 1) {
+      r = r * base % q;
+    }
+    base = base * base % q;
+    e >>= 1;
+  }
+  return (uint32_t)r;
+}
+
+static int is_prime_word(uint32_t q) {
+  if (q < 2 || q % 2 == 0) {
+    return q == 2;
+  }
+  for (uint32_t d = 3; (uint64_t)d * d <= q; d += 2) {
+    if (q % d == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Retorna 0 se algum primo q = 2mp + 1 mostra que a não é potência p-ésima
+// (a mod q precisa ser zero ou ter a^((q-1)/p) = 1 mod q)
+static int residue_filter(const uint32_t *a, size_t an, uint32_t p) {
+  int tests = 0;
+  for (uint64_t q = 2 * (uint64_t)p + 1;
+       tests < POWER_RESIDUE_TESTS && q <= UINT32_MAX; q += 2 * (uint64_t)p) {
+    if (!is_prime_word((uint32_t)q)) {
+      continue;
+    }
+    uint32_t r = mod_word(a, an, (uint32_t)q);
+    if (r != 0 && pow_mod_word(r, (q - 1) / p, (uint32_t)q) != 1) {
+      return 0;
+    }
+    tests++;
+  }
+  return 1;
+}
+
+// Se c^p == a, guarda c em *r e retorna 1; retorna -1 se faltou memória
+static int check_power(const uint32_t *a, size_t an, uint32_t *c, size_t cn,
+                       uint32_t p, uint32_t **r, size_t *rn) {
+  size_t pn;
+  uint32_t *pw = pow_alloc(c, cn, p, &pn);
+  if (pw == NULL) {
+    return -1;
+  }
+  int equal = limbs_cmp(pw, pn, a, an) == 0;
+  free(pw);
+  if (equal) {
+    *r = copy_alloc(c, cn);
+    *rn = cn;
+    return *r != NULL ? 1 : -1;
+  }
+  return 0;
+}
+
+// Raiz com até POWER_ESTIMATE_BITS bits: c = 2^(log2(a) / p) pelos limbs
+// mais altos de a, conferida nos 64 bits mais baixos (c^p mod 2^64) antes
+// da potência exata
+static int estimate_root(const uint32_t *a, size_t an, uint32_t p,
+                         uint32_t **r, size_t *rn) {
+  size_t used = an < 3 ? an : 3;
+  double top = 0;
+  for (size_t i = an; i-- > an - used;) {
+    top = top * 4294967296.0 + a[i];
+  }
+  double estimate = exp2((log2(top) + 32.0 * (double)(an - used)) / p);
+  uint64_t center = (uint64_t)(estimate + 0.5);
+  uint64_t low = a[0] | (an > 1 ? (uint64_t)a[1] << 32 : 0);
+
+  for (uint64_t c = center > 2 ? center - 1 : 2; c <= center + 1; c++) {
+    uint64_t pw = 1, base = c;
+    for (uint32_t e = p; e > 0; e >>= 1) {
+      if (e & 1) {
+        pw *= base;
+      }
+      base *= base;
+    }
+    if (pw != low) {
+      continue;
+    }
+    uint32_t limbs[2] = {(uint32_t)c, (uint32_t)(c >> 32)};
+    int found = check_power(a, an, limbs, limbs[1] != 0 ? 2 : 1, p, r, rn);
+    if (found != 0) {
+      return found;
+    }
+  }
+  return 0;
+}
+
+// Se a (com bits bits e tz zeros no fim) for r^p, guarda r e retorna 1;
+// retorna 0 se não for e -1 se faltou memória
+static int power_root(const uint32_t *a, size_t an, size_t bits, size_t tz,
+                      uint32_t p, uint32_t **r, size_t *rn) {
+  // a = r^p tem p vezes os zeros do fim de r
+  if (tz % p != 0) {
+    return 0;
+  }
+  if ((bits - 1) / p + 1 <= POWER_ESTIMATE_BITS) {
+    return estimate_root(a, an, p, r, rn);
+  }
+  if (!residue_filter(a, an, p)) {
+    return 0;
+  }
+
+  size_t cn;
+  uint32_t *c = root_limbs(a, an, p, &cn);
+  if (c == NULL) {
+    return -1;
+  }
+  int found = check_power(a, an, c, cn, p, r, rn);
+  free(c);
+  return found;
+}
+
+// Crivo de Eratóstenes: composite[i] != 0 se i (<= n) não for primo
+static unsigned char *sieve(size_t n) {
+  unsigned char *composite = calloc(n + 1, 1);
+  if (composite == NULL) {
+    return NULL;
+  }
+  for (size_t i = 2; i * i <= n; i++) {
+    if (!composite[i]) {
+      for (size_t j = i * i; j <= n; j += i) {
+        composite[j] = 1;
+      }
+    }
+  }
+  return composite;
+}
+
+int bigint_is_perfect_power(const BigInt *x, BigInt **root, uint32_t *k) {
+  if (root != NULL) {
+    *root = NULL;
+  }
+  if (x == NULL) {
+    return 0;
+  }
+
+  size_t an;
+  uint32_t *a = export_abs(x, &an);
+  if (a == NULL) {
+    return 0;
+  }
+  int negative = x->sign < 0 && an > 0;
+  size_t bits = bit_length(a, an);
+
+  // 0 = 0^2, 1 = 1^2 e -1 = (-1)^3
+  size_t total = negative ? 3 : 2;
+  int ok = 1;
+  if (bits > 1) {
+    unsigned char *composite = sieve(bits);
+    ok = composite != NULL;
+    total = 1;
+    // Um negativo só pode ser potência ímpar. Ao achar a = r^p, continua
+    // em r com o mesmo p: os primos menores já falharam para a e também
+    // falham para r
+    for (size_t p = negative ? 3 : 2; ok && p < bit_length(a, an);) {
+      if (!composite[p]) {
+        uint32_t *r;
+        size_t rn;
+        int found = power_root(a, an, bit_length(a, an), trailing_zeros(a, an),
+                               (uint32_t)p, &r, &rn);
+        if (found < 0) {
+          ok = 0;
+        } else if (found) {
+          free(a);
+          a = r;
+          an = rn;
+          total *= p;
+          continue;
+        }
+      }
+      p += p == 2 ? 1 : 2;
+    }
+    free(composite);
+  }
+
+  int result = ok && total > 1;
+  if (result && root != NULL) {
+    *root = bigint_import_limbs(a, an, negative ? -1 : 1);
+    result = *root != NULL;
+  }
+  if (result && k != NULL) {
+    *k = (uint32_t)total;
+  }
+  free(a);
+  return result;
+}
@@ -0,0 +1,33 @@
+#ifndef ROOTS_H
+#define ROOTS_H
+
+#include "../BigInt/BigInt.h"
+#include <stdint.h>
+
+// Raízes inteiras por iteração de Newton com precisão dobrada
+// A raiz k-ésima de x é calculada primeiro para x sem os k·s bits mais
+// baixos (metade dos bits do resultado, recursivamente) e depois corrigida
+// por passos de Newton x' = ((k - 1)·x + n / x^(k-1)) / k no tamanho
+// completo. Como a aproximação já tem metade dos bits certos, bastam um ou
+// dois passos por nível e o custo total fica em algumas divisões do tamanho
+// de x (multiplicação e divisão rápidas dos kernels de Limbs)
+
+// Raiz quadrada inteira: retorna s = floor(sqrt(x)) e, se rem != NULL,
+// guarda em *rem o resto x - s^2. Retorna NULL se x for negativo
+BigInt *bigint_sqrtrem(const BigInt *x, BigInt **rem);
+
+// Raiz k-ésima inteira truncada para zero: floor(|x|^(1/k)) com o sinal de
+// x. Retorna NULL se k == 0 ou se x for negativo e k for par
+BigInt *bigint_root(const BigInt *x, uint32_t k);
+
+// Retorna 1 se x = r^k para algum inteiro r e algum k >= 2 (0 e 1 são
+// potências perfeitas; um negativo só é com k ímpar, ex.: -8 = (-2)^3) e 0
+// caso contrário ou se faltar memória. Se root/k não forem NULL, guarda a
+// menor base r e o maior expoente k (ex.: 64 = 2^6)
+// Antes de cada raiz exata, o expoente primo p é descartado pelos bits zero
+// no fim de x, por testes de resíduo módulo primos q = 2mp + 1 ou, quando a
+// raiz tem poucos bits, por uma estimativa em ponto flutuante conferida nos
+// 64 bits mais baixos
+int bigint_is_perfect_power(const BigInt *x, BigInt **root, uint32_t *k);
+
+#endif // ROOTS_H
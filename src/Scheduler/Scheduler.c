@@ -0,0 +1,499 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "Scheduler.h"
+#include "../ExecContext/ExecContext.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEQUE_INITIAL_CAPACITY 64
+
+typedef struct {
+  SchedulerTaskFn fn;
+  void *arg;
+  TaskGroup *group;
+  ExecContext *exec; // Contexto de quem agendou, herdado pela tarefa
+} Task;
+
+// Deque de tarefas protegido por mutex (buffer circular que cresce)
+// O dono usa o fundo; ladrões usam o topo
+typedef struct {
+  Task *tasks;
+  size_t capacity;
+  size_t head; // Topo (tarefa mais antiga)
+  size_t count;
+  pthread_mutex_t lock;
+} TaskDeque;
+
+typedef struct {
+  Scheduler *s;
+  size_t id;
+  pthread_t thread;
+  TaskDeque deque;
+  unsigned seed;     // Estado do gerador usado para escolher vítimas
+  int depth;         // Tarefas aninhadas em execução (scheduler_wait)
+  uint64_t busy_ns;  // Escrito só pelo worker, lido com __atomic
+  size_t tasks;
+  size_t steals;
+} Worker;
+
+struct Scheduler {
+  Worker *workers;
+  size_t nworkers;
+  size_t started;
+  size_t queued;      // Tarefas em algum deque (acesso atômico)
+  size_t next_inject; // Distribuição das tarefas vindas de fora
+  int shutdown;
+  pthread_mutex_t sleep_lock;
+  pthread_cond_t sleep_cond;
+  pthread_mutex_t done_lock; // Acorda quem dorme em scheduler_wait
+  pthread_cond_t done_cond;
+  size_t waiters;            // Workers dormindo em scheduler_wait
+  uint64_t start_ns;
+};
+
+static pthread_key_t current_worker_key;
+static pthread_once_t current_worker_once = PTHREAD_ONCE_INIT;
+
+static void create_current_worker_key(void) {
+  pthread_key_create(&current_worker_key, NULL);
+}
+
+static Worker *current_worker(void) {
+  pthread_once(&current_worker_once, create_current_worker_key);
+  return pthread_getspecific(current_worker_key);
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+// Deque
+// ---------------------------------------------------------------------------
+
+static int deque_init(TaskDeque *d) {
+  d->tasks = malloc(DEQUE_INITIAL_CAPACITY * sizeof(Task));
+  if (d->tasks == NULL) {
+    return 0;
+  }
+  d->capacity = DEQUE_INITIAL_CAPACITY;
+  d->head = 0;
+  d->count = 0;
+  pthread_mutex_init(&d->lock, NULL);
+  return 1;
+}
+
+static void deque_destroy(TaskDeque *d) {
+  pthread_mutex_destroy(&d->lock);
+  free(d->tasks);
+}
+
+static int deque_push_bottom(TaskDeque *d, Task task) {
+  pthread_mutex_lock(&d->lock);
+  if (d->count == d->capacity) {
+    Task *maior = malloc(2 * d->capacity * sizeof(Task));
+    if (maior == NULL) {
+      pthread_mutex_unlock(&d->lock);
+      return 0;
+    }
+    for (size_t i = 0; i < d->count; i++) {
+      maior[i] = d->tasks[(d->head + i) % d->capacity];
+    }
+    free(d->tasks);
+    d->tasks = maior;
+    d->capacity *= 2;
+    d->head = 0;
+  }
+  d->tasks[(d->head + d->count) % d->capacity] = task;
+  d->count++;
+  pthread_mutex_unlock(&d->lock);
+  return 1;
+}
+
+static int deque_pop_bottom(TaskDeque *d, Task *task) {
+  pthread_mutex_lock(&d->lock);
+  if (d->count == 0) {
+    pthread_mutex_unlock(&d->lock);
+    return 0;
+  }
+  d->count--;
+  *task = d->tasks[(d->head + d->count) % d->capacity];
+  pthread_mutex_unlock(&d->lock);
+  return 1;
+}
+
+static int deque_steal_top(TaskDeque *d, Task *task) {
+  pthread_mutex_lock(&d->lock);
+  if (d->count == 0) {
+    pthread_mutex_unlock(&d->lock);
+    return 0;
+  }
+  *task = d->tasks[d->head];
+  d->head = (d->head + 1) % d->capacity;
+  d->count--;
+  pthread_mutex_unlock(&d->lock);
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Execução
+// ---------------------------------------------------------------------------
+
+// Procura uma tarefa: primeiro no próprio deque, depois roubando de outro
+// worker escolhido aleatoriamente. self pode ser NULL (thread externa)
+static int find_task(Scheduler *s, Worker *self, Task *task) {
+  if (self != NULL && deque_pop_bottom(&self->deque, task)) {
+    __atomic_sub_fetch(&s->queued, 1, __ATOMIC_ACQ_REL);
+    return 1;
+  }
+
+  size_t start = 0;
+  if (self != NULL) {
+    self->seed = self->seed * 1103515245u + 12345u;
+    start = (self->seed >> 8) % s->nworkers;
+  }
+  for (size_t k = 0; k < s->nworkers; k++) {
+    Worker *victim = &s->workers[(start + k) % s->nworkers];
+    if (victim == self) {
+      continue;
+    }
+    if (deque_steal_top(&victim->deque, task)) {
+      __atomic_sub_fetch(&s->queued, 1, __ATOMIC_ACQ_REL);
+      if (self != NULL) {
+        __atomic_add_fetch(&self->steals, 1, __ATOMIC_RELAXED);
+      }
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void run_task(Scheduler *s, Worker *self, Task task) {
+  uint64_t start = 0;
+  if (self != NULL && self->depth == 0) {
+    start = now_ns();
+  }
+  if (self != NULL) {
+    self->depth++;
+  }
+
+  ExecContext *previous = exec_enter(task.exec);
+  task.fn(task.arg);
+  exec_leave(previous);
+
+  if (self != NULL) {
+    self->depth--;
+    __atomic_add_fetch(&self->tasks, 1, __ATOMIC_RELAXED);
+    // Só a tarefa mais externa conta, para não somar o tempo duas vezes
+    if (self->depth == 0) {
+      __atomic_add_fetch(&self->busy_ns, now_ns() - start, __ATOMIC_RELAXED);
+    }
+  }
+  if (task.group != NULL &&
+      __atomic_sub_fetch(&task.group->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+    pthread_mutex_lock(&s->done_lock);
+    pthread_cond_broadcast(&s->done_cond);
+    pthread_mutex_unlock(&s->done_lock);
+  }
+}
+
+static void *worker_main(void *arg) {
+  Worker *w = arg;
+  Scheduler *s = w->s;
+  pthread_once(&current_worker_once, create_current_worker_key);
+  pthread_setspecific(current_worker_key, w);
+
+  while (1) {
+    Task task;
+    if (find_task(s, w, &task)) {
+      run_task(s, w, task);
+      continue;
+    }
+
+    pthread_mutex_lock(&s->sleep_lock);
+    while (__atomic_load_n(&s->queued, __ATOMIC_ACQUIRE) == 0 &&
+           !s->shutdown) {
+      pthread_cond_wait(&s->sleep_cond, &s->sleep_lock);
+    }
+    int done =
+        s->shutdown && __atomic_load_n(&s->queued, __ATOMIC_ACQUIRE) == 0;
+    pthread_mutex_unlock(&s->sleep_lock);
+    if (done) {
+      break;
+    }
+  }
+
+  pthread_setspecific(current_worker_key, NULL);
+  return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// API pública
+// ---------------------------------------------------------------------------
+
+// Cria um escalonador com a quantidade de workers indicada (mínimo 1)
+Scheduler *scheduler_create(size_t workers) {
+  if (workers == 0) {
+    workers = 1;
+  }
+
+  Scheduler *s = calloc(1, sizeof(Scheduler));
+  if (s == NULL) {
+    return NULL;
+  }
+  s->workers = calloc(workers, sizeof(Worker));
+  if (s->workers == NULL) {
+    free(s);
+    return NULL;
+  }
+  s->nworkers = workers;
+  s->start_ns = now_ns();
+  pthread_mutex_init(&s->sleep_lock, NULL);
+  pthread_cond_init(&s->sleep_cond, NULL);
+  pthread_mutex_init(&s->done_lock, NULL);
+  pthread_cond_init(&s->done_cond, NULL);
+
+  for (size_t i = 0; i < workers; i++) {
+    Worker *w = &s->workers[i];
+    w->s = s;
+    w->id = i;
+    w->seed = (unsigned)(i * 2654435761u + 1);
+    if (!deque_init(&w->deque)) {
+      for (size_t j = 0; j < i; j++) {
+        deque_destroy(&s->workers[j].deque);
+      }
+      pthread_mutex_destroy(&s->sleep_lock);
+      pthread_cond_destroy(&s->sleep_cond);
+      pthread_mutex_destroy(&s->done_lock);
+      pthread_cond_destroy(&s->done_cond);
+      free(s->workers);
+      free(s);
+      return NULL;
+    }
+  }
+
+  for (size_t i = 0; i < workers; i++) {
+    if (pthread_create(&s->workers[i].thread, NULL, worker_main,
+                       &s->workers[i]) != 0) {
+      break;
+    }
+    s->started++;
+  }
+
+  if (s->started == 0) {
+    scheduler_destroy(s);
+    return NULL;
+  }
+  return s;
+}
+
+// Espera todas as tarefas terminarem e destrói o escalonador
+void scheduler_destroy(Scheduler *s) {
+  if (s == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&s->sleep_lock);
+  s->shutdown = 1;
+  pthread_cond_broadcast(&s->sleep_cond);
+  pthread_mutex_unlock(&s->sleep_lock);
+
+  for (size_t i = 0; i < s->started; i++) {
+    pthread_join(s->workers[i].thread, NULL);
+  }
+  for (size_t i = 0; i < s->nworkers; i++) {
+    deque_destroy(&s->workers[i].deque);
+  }
+
+  pthread_mutex_destroy(&s->sleep_lock);
+  pthread_cond_destroy(&s->sleep_cond);
+  pthread_mutex_destroy(&s->done_lock);
+  pthread_cond_destroy(&s->done_cond);
+  free(s->workers);
+  free(s);
+}
+
+// Agenda uma tarefa
+void scheduler_spawn(Scheduler *s, TaskGroup *group, SchedulerTaskFn fn,
+                     void *arg) {
+  Task task = {fn, arg, group, exec_current()};
+  if (group != NULL) {
+    __atomic_add_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+  }
+
+  Worker *self = current_worker();
+  Worker *target;
+  if (self != NULL && self->s == s) {
+    target = self;
+  } else {
+    size_t next = __atomic_fetch_add(&s->next_inject, 1, __ATOMIC_RELAXED);
+    target = &s->workers[next % s->started];
+  }
+
+  // Conta antes de publicar: queued nunca fica abaixo do real
+  // (seq_cst com waiters: quem dorme em scheduler_wait vê a tarefa ou é
+  // acordado abaixo)
+  __atomic_add_fetch(&s->queued, 1, __ATOMIC_SEQ_CST);
+  if (!deque_push_bottom(&target->deque, task)) {
+    __atomic_sub_fetch(&s->queued, 1, __ATOMIC_ACQ_REL);
+    run_task(s, self != NULL && self->s == s ? self : NULL, task);
+    return;
+  }
+
+  pthread_mutex_lock(&s->sleep_lock);
+  pthread_cond_signal(&s->sleep_cond);
+  pthread_mutex_unlock(&s->sleep_lock);
+
+  if (__atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST) > 0) {
+    pthread_mutex_lock(&s->done_lock);
+    pthread_cond_broadcast(&s->done_cond);
+    pthread_mutex_unlock(&s->done_lock);
+  }
+}
+
+// Espera todas as tarefas do grupo terminarem
+// Um worker executa outras tarefas enquanto espera e, sem nenhuma para
+// pegar (as do grupo estão rodando em outros workers), dorme até o grupo
+// terminar ou surgir tarefa nova; uma thread externa apenas dorme, para
+// que as tarefas rodem sempre dentro de workers (e possam criar subtarefas)
+void scheduler_wait(Scheduler *s, TaskGroup *group) {
+  Worker *self = current_worker();
+  if (self == NULL || self->s != s) {
+    pthread_mutex_lock(&s->done_lock);
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+      pthread_cond_wait(&s->done_cond, &s->done_lock);
+    }
+    pthread_mutex_unlock(&s->done_lock);
+    return;
+  }
+
+  while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+    Task task;
+    if (find_task(s, self, &task)) {
+      run_task(s, self, task);
+      continue;
+    }
+
+    pthread_mutex_lock(&s->done_lock);
+    __atomic_add_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0 &&
+           __atomic_load_n(&s->queued, __ATOMIC_SEQ_CST) == 0) {
+      pthread_cond_wait(&s->done_cond, &s->done_lock);
+    }
+    __atomic_sub_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&s->done_lock);
+  }
+}
+
+// Executa uma tarefa em um worker e espera ela terminar
+void scheduler_run(Scheduler *s, SchedulerTaskFn fn, void *arg) {
+  TaskGroup group = {0};
+  scheduler_spawn(s, &group, fn, arg);
+  scheduler_wait(s, &group);
+}
+
+// Fork-join de duas funções: com parallel e dentro de um worker, fa vira
+// uma tarefa que outro worker pode roubar enquanto fb roda aqui. Fora de
+// um worker (ou com parallel == 0) as duas rodam em sequência, na hora
+void scheduler_fork_join(SchedulerTaskFn fa, void *a, SchedulerTaskFn fb,
+                         void *b, int parallel) {
+  Scheduler *s = scheduler_current();
+  if (s == NULL || !parallel) {
+    fa(a);
+    fb(b);
+    return;
+  }
+
+  TaskGroup group = {0};
+  scheduler_spawn(s, &group, fa, a);
+  fb(b);
+  scheduler_wait(s, &group);
+}
+
+typedef struct {
+  SchedulerRangeFn fn;
+  void *ctx;
+  size_t begin;
+  size_t end;
+} RangeTask;
+
+static void range_task(void *arg) {
+  RangeTask *t = arg;
+  t->fn(t->ctx, t->begin, t->end);
+}
+
+void scheduler_parallel_for(size_t n, size_t grain, SchedulerRangeFn fn,
+                            void *ctx) {
+  Scheduler *s = scheduler_current();
+  size_t chunks = s != NULL ? 2 * scheduler_workers(s) : 1;
+  if (grain == 0) {
+    grain = 1;
+  }
+  if (chunks > n / grain) {
+    chunks = n / grain;
+  }
+
+  RangeTask *tasks = chunks >= 2 ? malloc(chunks * sizeof(RangeTask)) : NULL;
+  if (tasks == NULL) {
+    fn(ctx, 0, n);
+    return;
+  }
+
+  TaskGroup group = {0};
+  size_t step = (n + chunks - 1) / chunks;
+  size_t count = 0;
+  for (size_t begin = 0; begin < n; begin += step) {
+    tasks[count].fn = fn;
+    tasks[count].ctx = ctx;
+    tasks[count].begin = begin;
+    tasks[count].end = (n - begin < step) ? n : begin + step;
+    scheduler_spawn(s, &group, range_task, &tasks[count]);
+    count++;
+  }
+  scheduler_wait(s, &group);
+  free(tasks);
+}
+
+// Retorna o escalonador do worker que está chamando
+Scheduler *scheduler_current(void) {
+  Worker *self = current_worker();
+  return self != NULL ? self->s : NULL;
+}
+
+// Retorna a quantidade de workers
+size_t scheduler_workers(const Scheduler *s) {
+  return s != NULL ? s->started : 0;
+}
+
+// Copia as estatísticas de cada worker e retorna o tempo decorrido
+double scheduler_stats(Scheduler *s, SchedulerWorkerStats *out) {
+  for (size_t i = 0; i < s->started; i++) {
+    Worker *w = &s->workers[i];
+    out[i].busy_seconds =
+        (double)__atomic_load_n(&w->busy_ns, __ATOMIC_RELAXED) / 1e9;
+    out[i].tasks = __atomic_load_n(&w->tasks, __ATOMIC_RELAXED);
+    out[i].steals = __atomic_load_n(&w->steals, __ATOMIC_RELAXED);
+  }
+  return (double)(now_ns() - s->start_ns) / 1e9;
+}
+
+// Imprime a utilização de cada worker
+void scheduler_print_stats(Scheduler *s, FILE *out) {
+  SchedulerWorkerStats *stats = malloc(s->started * sizeof(*stats));
+  if (stats == NULL) {
+    return;
+  }
+
+  double elapsed = scheduler_stats(s, stats);
+  for (size_t i = 0; i < s->started; i++) {
+    double util = elapsed > 0 ? 100.0 * stats[i].busy_seconds / elapsed : 0;
+    fprintf(out, "worker %zu: %5.1f%% ocupado, %zu tarefas, %zu roubadas\n", i,
+            util, stats[i].tasks, stats[i].steals);
+  }
+  free(stats);
+}
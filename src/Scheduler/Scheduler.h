@@ -0,0 +1,81 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Escalonador de tarefas com work-stealing
+// Cada worker tem seu próprio deque: ele empilha e desempilha tarefas no
+// fundo (LIFO, bom para cache) e workers ociosos roubam do topo (FIFO, as
+// tarefas mais antigas e normalmente maiores). Tarefas podem criar
+// subtarefas e esperar por elas sem bloquear o worker: enquanto espera, ele
+// executa outras tarefas da fila
+
+typedef void (*SchedulerTaskFn)(void *arg);
+
+// Corpo de um laço paralelo: processa os índices [begin, end)
+typedef void (*SchedulerRangeFn)(void *ctx, size_t begin, size_t end);
+
+typedef struct Scheduler Scheduler;
+
+// Grupo de tarefas que podem ser esperadas juntas (inicialize com {0})
+typedef struct {
+  size_t pending; // Tarefas ainda não concluídas (acesso atômico)
+} TaskGroup;
+
+// Estatísticas de um worker
+typedef struct {
+  double busy_seconds; // Tempo executando tarefas
+  size_t tasks;        // Tarefas executadas
+  size_t steals;       // Tarefas roubadas de outros workers
+} SchedulerWorkerStats;
+
+// Cria um escalonador com a quantidade de workers indicada (mínimo 1)
+Scheduler *scheduler_create(size_t workers);
+
+// Espera todas as tarefas terminarem e destrói o escalonador
+void scheduler_destroy(Scheduler *s);
+
+// Agenda uma tarefa. Se group não for NULL, a tarefa conta no grupo
+// A tarefa roda com o ExecContext de quem a agendou
+// Chamado de um worker, a tarefa vai para o deque do próprio worker;
+// de fora, é distribuída entre os workers
+// Se não houver memória a tarefa é executada na hora
+void scheduler_spawn(Scheduler *s, TaskGroup *group, SchedulerTaskFn fn,
+                     void *arg);
+
+// Espera todas as tarefas do grupo terminarem. Chamada de um worker,
+// executa outras tarefas enquanto isso; de fora, apenas bloqueia
+void scheduler_wait(Scheduler *s, TaskGroup *group);
+
+// Executa uma tarefa em um worker e espera ela terminar
+// Útil para que uma operação isolada possa usar os kernels paralelos
+void scheduler_run(Scheduler *s, SchedulerTaskFn fn, void *arg);
+
+// Executa fa(a) e fb(b) e retorna quando ambas terminarem. Chamada de um
+// worker com parallel != 0, fa vira uma tarefa (que outro worker pode roubar)
+// enquanto fb roda na thread atual; caso contrário roda as duas em sequência
+void scheduler_fork_join(SchedulerTaskFn fa, void *a, SchedulerTaskFn fb,
+                         void *b, int parallel);
+
+// Laço paralelo sobre [0, n): chamado de um worker, divide o intervalo em
+// até 2 pedaços por worker, com pelo menos grain índices cada, e executa cada
+// pedaço em uma tarefa; caso contrário chama fn(ctx, 0, n) direto
+void scheduler_parallel_for(size_t n, size_t grain, SchedulerRangeFn fn,
+                            void *ctx);
+
+// Retorna o escalonador do worker que está chamando, ou NULL se a thread
+// atual não for um worker
+Scheduler *scheduler_current(void);
+
+// Retorna a quantidade de workers
+size_t scheduler_workers(const Scheduler *s);
+
+// Copia as estatísticas de cada worker para out (scheduler_workers entradas)
+// e retorna o tempo decorrido desde a criação em segundos
+double scheduler_stats(Scheduler *s, SchedulerWorkerStats *out);
+
+// Imprime a utilização de cada worker
+void scheduler_print_stats(Scheduler *s, FILE *out);
+
+#endif // SCHEDULER_H
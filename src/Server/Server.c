@@ -0,0 +1,605 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "Server.h"
+#include "../Batch/Batch.h"
+#include "../ExecContext/ExecContext.h"
+#include "../InputFile/InputFile.h"
+#include "../Scheduler/Scheduler.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Tamanho inicial do buffer de leitura de cada conexão (cresce para linhas
+// maiores)
+#define SERVER_READ_BUFFER (64 * 1024)
+
+typedef struct Connection Connection;
+typedef struct Request Request;
+
+typedef struct {
+  Scheduler *scheduler;
+  ResultCache *cache;
+  double seconds; // Tempo limite de cada requisição (<= 0: sem limite)
+  pthread_mutex_t lock;
+  // Fila FIFO de requisições. Os deques do escalonador são LIFO para o
+  // dono, o que deixaria requisições antigas esperando atrás das novas:
+  // cada tarefa agendada retira a requisição mais antiga da fila
+  pthread_mutex_t queue_lock;
+  Request *queue_head, *queue_tail;
+  pthread_cond_t idle;     // Sinalizada quando uma conexão termina
+  Connection *connections; // Conexões ativas
+  size_t active;
+  size_t accepted;
+  size_t requests; // Acesso atômico
+  size_t errors;   // Acesso atômico
+} Server;
+
+struct Connection {
+  Server *server;
+  int in_fd;
+  int out_fd;
+  pthread_mutex_t write_lock; // Uma resposta por vez na saída
+  pthread_mutex_t lock;
+  pthread_cond_t slot; // Sinalizada quando uma requisição termina
+  size_t inflight;
+  Request *active; // Requisições enfileiradas ou em execução (para cancel)
+  int broken;      // A escrita falhou (cliente desconectou)
+  Connection *prev, *next;
+};
+
+struct Request {
+  Connection *conn;
+  char *line;
+  size_t len;
+  size_t id_len;    // O id é o primeiro token de line
+  ExecContext exec; // Prazo e cancelamento da requisição
+  Request *next;    // Fila do servidor
+  Request *active_prev, *active_next; // Lista active da conexão
+};
+
+static int write_all(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return 0;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return 1;
+}
+
+// Escreve "<id> <status> <texto>\n" em uma única escrita
+static void respond(Connection *conn, const char *id, size_t id_len,
+                    const char *status, const char *text) {
+  size_t status_len = strlen(status);
+  size_t text_len = strlen(text);
+  size_t len = id_len + 1 + status_len + 1 + text_len + 1;
+  char *msg = malloc(len);
+  if (msg == NULL) {
+    return;
+  }
+  char *p = msg;
+  memcpy(p, id, id_len);
+  p += id_len;
+  *p++ = ' ';
+  memcpy(p, status, status_len);
+  p += status_len;
+  *p++ = ' ';
+  memcpy(p, text, text_len);
+  p += text_len;
+  *p = '\n';
+
+  pthread_mutex_lock(&conn->write_lock);
+  if (!conn->broken && !write_all(conn->out_fd, msg, len)) {
+    conn->broken = 1;
+  }
+  pthread_mutex_unlock(&conn->write_lock);
+  free(msg);
+}
+
+static void respond_error(Connection *conn, const char *id, size_t id_len,
+                          const char *msg) {
+  __atomic_fetch_add(&conn->server->errors, 1, __ATOMIC_RELAXED);
+  respond(conn, id, id_len, "ERR", msg);
+}
+
+// Executa uma requisição "<id> <op> <a> [b ...]" e responde
+static void handle_request(Connection *conn, const char *line, size_t end) {
+  size_t pos = 0;
+  const char *id = NULL, *token = NULL;
+  size_t id_len = 0, token_len = 0;
+  inputfile_next_token(line, end, &pos, &id, &id_len);
+
+  if (!inputfile_next_token(line, end, &pos, &token, &token_len)) {
+    respond_error(conn, id, id_len, "requisicao incompleta");
+    return;
+  }
+  if (token_len == 4 && memcmp(token, "ping", 4) == 0) {
+    respond(conn, id, id_len, "OK", "pong");
+    return;
+  }
+  BatchOp op = batch_parse_op(token, token_len);
+  if (op == BATCH_OP_INVALIDA) {
+    respond_error(conn, id, id_len, "operacao desconhecida");
+    return;
+  }
+
+  size_t count = 0;
+  size_t capacity = 2;
+  BigInt **xs = malloc(capacity * sizeof(BigInt *));
+  const char *erro = xs == NULL ? "memoria insuficiente" : NULL;
+  while (erro == NULL &&
+         inputfile_next_token(line, end, &pos, &token, &token_len)) {
+    if (count == capacity) {
+      BigInt **maior = realloc(xs, 2 * capacity * sizeof(BigInt *));
+      if (maior == NULL) {
+        erro = "memoria insuficiente";
+        break;
+      }
+      xs = maior;
+      capacity *= 2;
+    }
+    xs[count] = bigint_create_from_chars(token, token_len);
+    if (xs[count++] == NULL) {
+      erro = "numero invalido";
+    }
+  }
+
+  BigInt *result = NULL;
+  if (erro == NULL) {
+    result = batch_apply_cached(conn->server->cache, op, (const BigInt **)xs,
+                                count);
+    if (result == NULL) {
+      erro = "operacao falhou (operandos errados ou divisao por zero)";
+    }
+  }
+  for (size_t i = 0; i < count; i++) {
+    bigint_destroy(xs[i]);
+  }
+  free(xs);
+
+  char *res_str = bigint_to_string(result);
+  bigint_destroy(result);
+  if (erro == NULL && res_str == NULL) {
+    erro = "memoria insuficiente";
+  }
+  // Interrompida: o resultado (se houver) é descartado
+  ExecContext *exec = exec_current();
+  if (exec != NULL && exec_status(exec) != EXEC_OK) {
+    erro = exec_status_message(exec_status(exec));
+  }
+  if (erro != NULL) {
+    respond_error(conn, id, id_len, erro);
+  } else {
+    respond(conn, id, id_len, "OK", res_str);
+  }
+  free(res_str);
+}
+
+static void request_task(void *arg) {
+  Server *server = arg;
+  pthread_mutex_lock(&server->queue_lock);
+  Request *req = server->queue_head;
+  server->queue_head = req->next;
+  if (server->queue_head == NULL) {
+    server->queue_tail = NULL;
+  }
+  pthread_mutex_unlock(&server->queue_lock);
+
+  Connection *conn = req->conn;
+  exec_set_deadline(&req->exec, server->seconds);
+  ExecContext *previous = exec_enter(&req->exec);
+  handle_request(conn, req->line, req->len);
+  exec_leave(previous);
+
+  pthread_mutex_lock(&conn->lock);
+  if (req->active_prev != NULL) {
+    req->active_prev->active_next = req->active_next;
+  } else {
+    conn->active = req->active_next;
+  }
+  if (req->active_next != NULL) {
+    req->active_next->active_prev = req->active_prev;
+  }
+  conn->inflight--;
+  pthread_cond_signal(&conn->slot);
+  pthread_mutex_unlock(&conn->lock);
+  free(req->line);
+  free(req);
+}
+
+// "<id> cancel <alvo>": cancela as requisições da conexão com id alvo
+// Roda na thread de leitura, sem esperar na fila atrás da própria
+// requisição que quer cancelar
+static void cancel_requests(Connection *conn, const char *id, size_t id_len,
+                            const char *target, size_t target_len) {
+  size_t found = 0;
+  pthread_mutex_lock(&conn->lock);
+  for (Request *r = conn->active; r != NULL; r = r->active_next) {
+    if (r->id_len == target_len && memcmp(r->line, target, target_len) == 0) {
+      exec_cancel(&r->exec);
+      found++;
+    }
+  }
+  pthread_mutex_unlock(&conn->lock);
+
+  if (found == 0) {
+    respond_error(conn, id, id_len, "requisicao nao encontrada");
+    return;
+  }
+  char text[32];
+  snprintf(text, sizeof(text), "%zu", found);
+  respond(conn, id, id_len, "OK", text);
+}
+
+// Lê as requisições da conexão até o fim da entrada, agendando cada uma
+// como tarefa, e espera as que ainda estão em execução
+static void connection_serve(Connection *conn) {
+  Server *server = conn->server;
+  size_t capacity = SERVER_READ_BUFFER;
+  size_t start = 0, filled = 0;
+  char *buffer = malloc(capacity);
+
+  while (buffer != NULL) {
+    char *nl = memchr(buffer + start, '\n', filled - start);
+    if (nl == NULL) {
+      // Linha incompleta: move para o início (ou aumenta o buffer) e lê mais
+      if (start > 0) {
+        memmove(buffer, buffer + start, filled - start);
+        filled -= start;
+        start = 0;
+      } else if (filled == capacity) {
+        char *maior = realloc(buffer, 2 * capacity);
+        if (maior == NULL) {
+          break;
+        }
+        buffer = maior;
+        capacity *= 2;
+      }
+      ssize_t n = read(conn->in_fd, buffer + filled, capacity - filled);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n > 0) {
+        filled += (size_t)n;
+        continue;
+      }
+      if (filled == 0) {
+        break;
+      }
+      // Última linha sem '\n'
+      nl = buffer + filled;
+    }
+
+    const char *line = buffer + start;
+    size_t len = (size_t)(nl - line);
+    start = nl < buffer + filled ? (size_t)(nl - buffer) + 1 : filled;
+
+    // Linhas vazias e comentários não geram resposta
+    size_t pos = 0;
+    const char *token;
+    size_t token_len;
+    if (!inputfile_next_token(line, len, &pos, &token, &token_len) ||
+        token[0] == '#') {
+      continue;
+    }
+    const char *id = token;
+    size_t id_len = token_len;
+    if (inputfile_next_token(line, len, &pos, &token, &token_len) &&
+        token_len == 6 && memcmp(token, "cancel", 6) == 0) {
+      __atomic_fetch_add(&server->requests, 1, __ATOMIC_RELAXED);
+      if (inputfile_next_token(line, len, &pos, &token, &token_len)) {
+        cancel_requests(conn, id, id_len, token, token_len);
+      } else {
+        respond_error(conn, id, id_len, "requisicao incompleta");
+      }
+      continue;
+    }
+
+    Request *req = malloc(sizeof(Request));
+    char *copy = malloc(len);
+    if (req == NULL || copy == NULL) {
+      free(req);
+      free(copy);
+      break;
+    }
+    // A linha é copiada a partir do id, que fica no início da cópia
+    len -= (size_t)(id - line);
+    memcpy(copy, id, len);
+    req->conn = conn;
+    req->line = copy;
+    req->len = len;
+    req->id_len = id_len;
+    exec_init(&req->exec);
+    req->next = NULL;
+    req->active_prev = NULL;
+    __atomic_fetch_add(&server->requests, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&conn->lock);
+    while (conn->inflight >= SERVER_MAX_INFLIGHT) {
+      pthread_cond_wait(&conn->slot, &conn->lock);
+    }
+    conn->inflight++;
+    req->active_next = conn->active;
+    if (conn->active != NULL) {
+      conn->active->active_prev = req;
+    }
+    conn->active = req;
+    pthread_mutex_unlock(&conn->lock);
+
+    pthread_mutex_lock(&server->queue_lock);
+    if (server->queue_tail != NULL) {
+      server->queue_tail->next = req;
+    } else {
+      server->queue_head = req;
+    }
+    server->queue_tail = req;
+    pthread_mutex_unlock(&server->queue_lock);
+    scheduler_spawn(server->scheduler, NULL, request_task, server);
+  }
+
+  // As requisições da conexão podem estar sendo executadas por tarefas
+  // agendadas por outras conexões: espera pelo contador, não por um grupo
+  free(buffer);
+  pthread_mutex_lock(&conn->lock);
+  while (conn->inflight > 0) {
+    pthread_cond_wait(&conn->slot, &conn->lock);
+  }
+  pthread_mutex_unlock(&conn->lock);
+}
+
+static void connection_init(Connection *conn, Server *server, int in_fd,
+                            int out_fd) {
+  memset(conn, 0, sizeof(Connection));
+  conn->server = server;
+  conn->in_fd = in_fd;
+  conn->out_fd = out_fd;
+  pthread_mutex_init(&conn->write_lock, NULL);
+  pthread_mutex_init(&conn->lock, NULL);
+  pthread_cond_init(&conn->slot, NULL);
+}
+
+static void connection_free(Connection *conn) {
+  pthread_mutex_destroy(&conn->write_lock);
+  pthread_mutex_destroy(&conn->lock);
+  pthread_cond_destroy(&conn->slot);
+  free(conn);
+}
+
+static int server_init(Server *server, size_t threads, ResultCache *cache,
+                       double seconds) {
+  memset(server, 0, sizeof(Server));
+  // Um cliente que desconecta no meio de uma resposta não derruba o servidor
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = SIG_IGN;
+  sigaction(SIGPIPE, &sa, NULL);
+
+  server->scheduler = scheduler_create(threads);
+  if (server->scheduler == NULL) {
+    return 0;
+  }
+  server->cache = cache;
+  server->seconds = seconds;
+  pthread_mutex_init(&server->lock, NULL);
+  pthread_mutex_init(&server->queue_lock, NULL);
+  pthread_cond_init(&server->idle, NULL);
+  return 1;
+}
+
+static void server_finish(Server *server) {
+  scheduler_destroy(server->scheduler);
+  pthread_mutex_destroy(&server->lock);
+  pthread_mutex_destroy(&server->queue_lock);
+  pthread_cond_destroy(&server->idle);
+  fprintf(stderr, "Servidor: %zu conexoes, %zu requisicoes, %zu erros\n",
+          server->accepted, server->requests, server->errors);
+  if (server->cache != NULL) {
+    cache_print_stats(server->cache, stderr);
+  }
+}
+
+int server_run_stdio(size_t threads, ResultCache *cache, double seconds) {
+  Server server;
+  if (!server_init(&server, threads, cache, seconds)) {
+    return 1;
+  }
+  Connection *conn = malloc(sizeof(Connection));
+  if (conn == NULL) {
+    server_finish(&server);
+    return 1;
+  }
+  connection_init(conn, &server, STDIN_FILENO, STDOUT_FILENO);
+  server.accepted = 1;
+  connection_serve(conn);
+  connection_free(conn);
+  server_finish(&server);
+  return 0;
+}
+
+// Thread de cada conexão do socket
+static void *connection_thread(void *arg) {
+  Connection *conn = arg;
+  Server *server = conn->server;
+  connection_serve(conn);
+
+  pthread_mutex_lock(&server->lock);
+  if (conn->prev != NULL) {
+    conn->prev->next = conn->next;
+  } else {
+    server->connections = conn->next;
+  }
+  if (conn->next != NULL) {
+    conn->next->prev = conn->prev;
+  }
+  server->active--;
+  pthread_cond_signal(&server->idle);
+  pthread_mutex_unlock(&server->lock);
+
+  close(conn->in_fd);
+  connection_free(conn);
+  return NULL;
+}
+
+// SIGINT e SIGTERM ficam bloqueados em todas as threads e são recebidos por
+// esta, que acorda o laço de accept pelo pipe
+typedef struct {
+  sigset_t set;
+  int pipe_fd;
+} SignalWaiter;
+
+static void *signal_thread(void *arg) {
+  SignalWaiter *waiter = arg;
+  int sig;
+  sigwait(&waiter->set, &sig);
+  char c = 1;
+  while (write(waiter->pipe_fd, &c, 1) < 0 && errno == EINTR) {
+  }
+  return NULL;
+}
+
+static int open_socket(const char *path) {
+  struct sockaddr_un addr;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "Erro: caminho do socket muito longo\n");
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    perror("Erro ao criar socket");
+    return -1;
+  }
+  unlink(path);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(fd, 64) < 0) {
+    perror("Erro ao escutar no socket");
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int server_run_socket(const char *path, size_t threads, ResultCache *cache,
+                      double seconds) {
+  SignalWaiter waiter;
+  sigemptyset(&waiter.set);
+  sigaddset(&waiter.set, SIGINT);
+  sigaddset(&waiter.set, SIGTERM);
+  sigset_t old_mask;
+  pthread_sigmask(SIG_BLOCK, &waiter.set, &old_mask);
+
+  int pipe_fds[2] = {-1, -1};
+  int listen_fd = open_socket(path);
+  Server server;
+  if (listen_fd < 0 || pipe(pipe_fds) < 0 ||
+      !server_init(&server, threads, cache, seconds)) {
+    if (listen_fd >= 0) {
+      close(listen_fd);
+      unlink(path);
+    }
+    if (pipe_fds[0] >= 0) {
+      close(pipe_fds[0]);
+      close(pipe_fds[1]);
+    }
+    pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+    return 1;
+  }
+  waiter.pipe_fd = pipe_fds[1];
+  pthread_t signal_tid;
+  int has_signal_thread =
+      pthread_create(&signal_tid, NULL, signal_thread, &waiter) == 0;
+  fprintf(stderr, "Servidor escutando em %s (%zu workers)\n", path,
+          scheduler_workers(server.scheduler));
+
+  int status = 0;
+  while (1) {
+    struct pollfd fds[2] = {{listen_fd, POLLIN, 0}, {pipe_fds[0], POLLIN, 0}};
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("Erro em poll");
+      status = 1;
+      break;
+    }
+    if (fds[1].revents != 0) {
+      break; // SIGINT ou SIGTERM
+    }
+    if (fds[0].revents == 0) {
+      continue;
+    }
+
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+      continue;
+    }
+    Connection *conn = malloc(sizeof(Connection));
+    if (conn == NULL) {
+      close(fd);
+      continue;
+    }
+    connection_init(conn, &server, fd, fd);
+
+    pthread_mutex_lock(&server.lock);
+    conn->next = server.connections;
+    if (conn->next != NULL) {
+      conn->next->prev = conn;
+    }
+    server.connections = conn;
+    server.active++;
+    server.accepted++;
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, connection_thread, conn) == 0) {
+      pthread_detach(tid);
+    } else {
+      server.connections = conn->next;
+      if (conn->next != NULL) {
+        conn->next->prev = NULL;
+      }
+      server.active--;
+      close(fd);
+      connection_free(conn);
+    }
+    pthread_mutex_unlock(&server.lock);
+  }
+
+  // Para de ler das conexões abertas e espera as requisições em andamento
+  // serem respondidas
+  close(listen_fd);
+  unlink(path);
+  pthread_mutex_lock(&server.lock);
+  for (Connection *c = server.connections; c != NULL; c = c->next) {
+    shutdown(c->in_fd, SHUT_RD);
+  }
+  while (server.active > 0) {
+    pthread_cond_wait(&server.idle, &server.lock);
+  }
+  pthread_mutex_unlock(&server.lock);
+
+  if (has_signal_thread) {
+    if (status != 0) {
+      pthread_kill(signal_tid, SIGTERM);
+    }
+    pthread_join(signal_tid, NULL);
+  }
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+  server_finish(&server);
+  pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+  return status;
+}
@@ -0,0 +1,38 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "../ResultCache/ResultCache.h"
+#include <stddef.h>
+
+// Servidor de longa duração: mantém o escalonador, o cache de resultados e
+// as tabelas internas aquecidos entre as requisições
+//
+// Protocolo (texto, uma requisição por linha):
+//   <id> <op> <a> [b ...]    op como no modo batch ("3", "*", "mul", ...)
+//   <id> ping
+//   <id> cancel <alvo>       cancela as requisições da conexão com id alvo
+// Respostas (uma por linha):
+//   <id> OK <resultado>
+//   <id> ERR <mensagem>
+// id é qualquer token sem espaços escolhido pelo cliente. As requisições de
+// uma conexão são executadas em paralelo pelos workers, então as respostas
+// podem sair fora de ordem: use o id para associá-las
+// Cada requisição roda em um ExecContext: com seconds > 0 ela tem esse
+// tempo de execução e, se estourar, responde "ERR tempo esgotado"; uma
+// requisição cancelada responde "ERR cancelado". cancel responde
+// "OK <quantidade cancelada>" ou "ERR requisicao nao encontrada"
+
+// Máximo de requisições de uma conexão em execução ao mesmo tempo; a leitura
+// da conexão espera quando o limite é atingido
+#define SERVER_MAX_INFLIGHT 256
+
+// Atende o protocolo lendo de stdin e respondendo em stdout até o fim da
+// entrada, com threads workers. Retorna 0 em sucesso, 1 em erro
+int server_run_stdio(size_t threads, ResultCache *cache, double seconds);
+
+// Escuta em um socket UNIX (o arquivo path é recriado) e atende cada conexão
+// até receber SIGINT ou SIGTERM. Retorna 0 em sucesso, 1 em erro
+int server_run_socket(const char *path, size_t threads, ResultCache *cache,
+                      double seconds);
+
+#endif // SERVER_H
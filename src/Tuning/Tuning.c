@@ -0,0 +1,72 @@
+#include "Tuning.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Limiares medidos nesta máquina por "make tune" (o Makefile define
+// PE_TUNED_HEADER quando o arquivo existe)
+#ifdef PE_TUNED_HEADER
+#include "tuned.h"
+#endif
+
+#ifndef TUNED_KARATSUBA_THRESHOLD
+#define TUNED_KARATSUBA_THRESHOLD 32
+#endif
+#ifndef TUNED_NTT_THRESHOLD
+#define TUNED_NTT_THRESHOLD 25000
+#endif
+#ifndef TUNED_DIV_NEWTON_THRESHOLD
+#define TUNED_DIV_NEWTON_THRESHOLD 3000
+#endif
+#ifndef TUNED_RADIX_DC_THRESHOLD
+#define TUNED_RADIX_DC_THRESHOLD 32
+#endif
+
+static const size_t tuning_defaults[TUNE_PARAMS] = {
+    TUNED_KARATSUBA_THRESHOLD, TUNED_NTT_THRESHOLD, TUNED_DIV_NEWTON_THRESHOLD,
+    TUNED_RADIX_DC_THRESHOLD};
+
+static const char *tuning_names[TUNE_PARAMS] = {
+    "PE_KARATSUBA_THRESHOLD", "PE_NTT_THRESHOLD", "PE_DIV_NEWTON_THRESHOLD",
+    "PE_RADIX_DC_THRESHOLD"};
+
+// Karatsuba e a conversão precisam de pelo menos 2 limbs por metade
+static const size_t tuning_minimums[TUNE_PARAMS] = {4, 4, 2, 2};
+
+static size_t tuning_values[TUNE_PARAMS];
+static pthread_once_t tuning_once = PTHREAD_ONCE_INIT;
+
+static void tuning_init(void) {
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    tuning_values[p] = tuning_defaults[p];
+    const char *env = getenv(tuning_names[p]);
+    if (env == NULL) {
+      continue;
+    }
+    char *end;
+    unsigned long long value = strtoull(env, &end, 10);
+    if (*env == '\0' || *end != '\0' || value < tuning_minimums[p]) {
+      fprintf(stderr, "Aviso: %s=%s invalido (minimo %zu), usando %zu\n",
+              tuning_names[p], env, tuning_minimums[p], tuning_defaults[p]);
+      continue;
+    }
+    tuning_values[p] = (size_t)value;
+  }
+}
+
+size_t tuning_get(TuneParam p) {
+  pthread_once(&tuning_once, tuning_init);
+  return __atomic_load_n(&tuning_values[p], __ATOMIC_RELAXED);
+}
+
+void tuning_set(TuneParam p, size_t value) {
+  pthread_once(&tuning_once, tuning_init);
+  if (value < tuning_minimums[p]) {
+    value = tuning_minimums[p];
+  }
+  __atomic_store_n(&tuning_values[p], value, __ATOMIC_RELAXED);
+}
+
+size_t tuning_default(TuneParam p) { return tuning_defaults[p]; }
+
+const char *tuning_name(TuneParam p) { return tuning_names[p]; }
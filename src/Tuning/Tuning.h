@@ -0,0 +1,34 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <stddef.h>
+
+// Limiares de troca de algoritmo, ajustáveis por máquina
+// Os valores padrão vêm de src/Tuning/tuned.h quando ele existe (gerado por
+// "make tune", que mede cada par de algoritmos nesta máquina) ou dos
+// valores fixos de Tuning.c. Cada um pode ser sobrescrito na execução por
+// uma variável de ambiente (ex.: PE_KARATSUBA_THRESHOLD=48), lida uma única
+// vez no primeiro uso
+
+typedef enum {
+  TUNE_KARATSUBA,  // Limbs do menor fator a partir dos quais usa Karatsuba
+  TUNE_NTT,        // Limbs do menor fator a partir dos quais usa a NTT
+  TUNE_DIV_NEWTON, // Limbs do divisor e do quociente para dividir por Newton
+  TUNE_RADIX_DC,   // Limbs da potência de 10 para converter por divisão e
+                   // conquista (abaixo disso, grupo a grupo)
+  TUNE_PARAMS
+} TuneParam;
+
+// Valor atual do limiar
+size_t tuning_get(TuneParam p);
+
+// Troca o valor do limiar (usado pelo afinador)
+void tuning_set(TuneParam p, size_t value);
+
+// Valor compilado (tuned.h ou padrão fixo), sem a variável de ambiente
+size_t tuning_default(TuneParam p);
+
+// Nome da variável de ambiente do limiar (ex.: "PE_NTT_THRESHOLD")
+const char *tuning_name(TuneParam p);
+
+#endif // TUNING_H
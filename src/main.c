@@ -1,27 +1,178 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "BigInt/BigInt.h"
+#include "Batch/Batch.h"
+#include "BigIntSerial/BigIntSerial.h"
+#include "ExecContext/ExecContext.h"
+#include "Expr/Expr.h"
+#include "Factor/Factor.h"
+#include "InputFile/InputFile.h"
+#include "Instrument/Instrument.h"
+#include "OutOfCore/OutOfCore.h"
+#include "Prime/Prime.h"
+#include "ResultCache/ResultCache.h"
+#include "Roots/Roots.h"
+#include "Scheduler/Scheduler.h"
+#include "Server/Server.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
-int ler_numeros(int isFile, const char *input_filename, char *num1_str,
-                size_t num1_size, char *num2_str, size_t num2_size) {
-  if (isFile) {
-    FILE *fin = fopen(input_filename, "r");
-    if (fin == NULL) {
-      perror("Erro ao abrir arquivo de entrada");
-      return 0;
+// Lê um token do teclado para um buffer que cresce sob demanda
+// Retorna NULL no fim da entrada (quem chamar deve liberar o resultado)
+char *ler_token(FILE *f) {
+  int c = fgetc(f);
+  while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+    c = fgetc(f);
+  }
+  if (c == EOF) {
+    return NULL;
+  }
+
+  size_t capacity = 64;
+  size_t len = 0;
+  char *token = malloc(capacity);
+  while (token != NULL && c != EOF && c != ' ' && c != '\t' && c != '\r' &&
+         c != '\n') {
+    if (len + 1 == capacity) {
+      capacity *= 2;
+      char *maior = realloc(token, capacity);
+      if (maior == NULL) {
+        free(token);
+        return NULL;
+      }
+      token = maior;
+    }
+    token[len++] = (char)c;
+    c = fgetc(f);
+  }
+
+  if (token != NULL) {
+    token[len] = '\0';
+  }
+  return token;
+}
+
+// Lê uma linha do teclado (pulando linhas em branco) para um buffer que
+// cresce sob demanda. Retorna NULL no fim da entrada
+char *ler_linha(FILE *f) {
+  int c = fgetc(f);
+  while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+    c = fgetc(f);
+  }
+  if (c == EOF) {
+    return NULL;
+  }
+
+  size_t capacity = 128;
+  size_t len = 0;
+  char *linha = malloc(capacity);
+  while (linha != NULL && c != EOF && c != '\n') {
+    if (len + 1 == capacity) {
+      capacity *= 2;
+      char *maior = realloc(linha, capacity);
+      if (maior == NULL) {
+        free(linha);
+        return NULL;
+      }
+      linha = maior;
     }
-    if (fscanf(fin, "%s %s", num1_str, num2_str) != 2) {
-      printf("Erro: arquivo deve conter dois números.\n");
-      fclose(fin);
+    linha[len++] = (char)c;
+    c = fgetc(f);
+  }
+
+  if (linha != NULL) {
+    linha[len] = '\0';
+  }
+  return linha;
+}
+
+// Lê os dois primeiros números do arquivo (mapeado com mmap, sem cópia)
+int ler_numeros_arquivo(const char *input_filename, BigInt **num1,
+                        BigInt **num2) {
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 0;
+  }
+
+  size_t pos = 0;
+  const char *tok1 = NULL, *tok2 = NULL;
+  size_t len1 = 0, len2 = 0;
+  if (!inputfile_next_token(in.data, in.size, &pos, &tok1, &len1) ||
+      !inputfile_next_token(in.data, in.size, &pos, &tok2, &len2)) {
+    printf("Erro: arquivo deve conter dois números.\n");
+    inputfile_close(&in);
+    return 0;
+  }
+
+  *num1 = bigint_create_from_chars(tok1, len1);
+  *num2 = bigint_create_from_chars(tok2, len2);
+  inputfile_close(&in);
+  return 1;
+}
+
+// Lê os dois operandos (do teclado ou do arquivo) já convertidos em BigInt
+// Retorna 1 se ambos foram criados; em erro nada precisa ser liberado
+int ler_numeros(int isFile, const char *input_filename, BigInt **num1,
+                BigInt **num2) {
+  *num1 = NULL;
+  *num2 = NULL;
+
+  if (isFile) {
+    if (!ler_numeros_arquivo(input_filename, num1, num2)) {
       return 0;
     }
-    fclose(fin);
   } else {
     printf("Digite o primeiro numero: ");
-    scanf("%s", num1_str);
+    char *num1_str = ler_token(stdin);
     printf("Digite o segundo numero: ");
-    scanf("%s", num2_str);
+    char *num2_str = ler_token(stdin);
+
+    *num1 = bigint_create_from_string(num1_str);
+    *num2 = bigint_create_from_string(num2_str);
+    free(num1_str);
+    free(num2_str);
+  }
+
+  if (*num1 == NULL || *num2 == NULL) {
+    printf("Erro ao criar BigInt\n");
+    bigint_destroy(*num1);
+    bigint_destroy(*num2);
+    return 0;
+  }
+  return 1;
+}
+
+// Lê um único operando (do teclado ou o primeiro número do arquivo)
+// Retorna 1 se foi criado; em erro nada precisa ser liberado
+int ler_numero(int isFile, const char *input_filename, BigInt **num) {
+  *num = NULL;
+
+  if (isFile) {
+    InputFile in;
+    if (!inputfile_open(input_filename, &in)) {
+      perror("Erro ao abrir arquivo de entrada");
+      return 0;
+    }
+    size_t pos = 0;
+    const char *tok = NULL;
+    size_t len = 0;
+    if (inputfile_next_token(in.data, in.size, &pos, &tok, &len)) {
+      *num = bigint_create_from_chars(tok, len);
+    }
+    inputfile_close(&in);
+  } else {
+    printf("Digite o numero: ");
+    char *num_str = ler_token(stdin);
+    *num = bigint_create_from_string(num_str);
+    free(num_str);
+  }
+
+  if (*num == NULL) {
+    printf("Erro ao criar BigInt\n");
+    return 0;
   }
   return 1;
 }
@@ -48,7 +199,527 @@ void escrever_resultado(int isFile, const char *output_filename,
   }
 }
 
-int main(void) {
+void imprimir_uso(const char *programa) {
+  printf("Uso:\n");
+  printf("  %s [--threads N] [--cache-mb M] (menu interativo)\n", programa);
+  printf("  %s --to-bin <entrada.txt> <saida.bin>\n", programa);
+  printf("  %s --from-bin <entrada.bin> <saida.txt>\n", programa);
+  printf("  %s --file <op> <a.bin> <b.bin> [saida.bin] [--threads N] "
+         "[--memory-mb M]\n",
+         programa);
+  printf("      (out-of-core sobre arquivos binarios: op = + - * cmp; cmp "
+         "imprime -1, 0 ou 1)\n");
+  printf("  %s --batch <entrada.txt> <saida.txt> [--threads N] "
+         "[--cache-mb M] [--seconds S]\n",
+         programa);
+  printf("      (uma operacao por linha: \"op a [b ...]\", op = 1..19, "
+         "+ - * / %% mdc fat binom prod sqrt root ispow pow fib lucas\n"
+         "       isprime nextprime)\n");
+  printf("  %s --batch-gcd <entrada.txt> <saida.txt> [--threads N]\n",
+         programa);
+  printf("      (um numero por linha; escreve mdc(x_i, produto dos demais))\n");
+  printf("  %s --factor <entrada.txt> <saida.txt> [--threads N] "
+         "[--seconds S]\n",
+         programa);
+  printf("      (um numero por linha; escreve a fatoracao, ex.: "
+         "\"2^3 * 3 * 1000000007\",\n"
+         "       com ate S segundos por numero)\n");
+  printf("  %s --expr <entrada.txt> <saida.txt>\n", programa);
+  printf("      (expressoes com variaveis, ex.: \"x = 2^127 - 1; "
+         "(x * x + 3) mod 97\")\n");
+  printf("  %s --server <socket> [--threads N] [--cache-mb M] "
+         "[--seconds S]\n",
+         programa);
+  printf("  %s --stdio [--threads N] [--cache-mb M] [--seconds S]\n",
+         programa);
+  printf("      (servidor: \"<id> <op> a [b ...]\" por linha -> "
+         "\"<id> OK <res>\" ou \"<id> ERR <msg>\";\n"
+         "       \"<id> cancel <alvo>\" cancela uma requisicao)\n");
+  printf("  --cache-mb M guarda resultados de operacoes repetidas em um cache "
+         "LRU de ate M MB\n");
+  printf("  --seconds S limita cada operacao (linha ou requisicao) a S "
+         "segundos\n");
+}
+
+// Converte o primeiro número de um arquivo texto para o formato binário
+// Os limbs vão direto para o arquivo mapeado (sem LinkedList); hosts em que
+// isso não é possível usam BigInt e bigint_save
+int converter_para_binario(const char *input_filename,
+                           const char *output_filename) {
+  if (bigint_file_from_decimal(input_filename, output_filename)) {
+    return 0;
+  }
+
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 1;
+  }
+
+  size_t pos = 0;
+  const char *token = NULL;
+  size_t len = 0;
+  BigInt *num = NULL;
+  if (inputfile_next_token(in.data, in.size, &pos, &token, &len)) {
+    num = bigint_create_from_chars(token, len);
+  }
+  inputfile_close(&in);
+  if (num == NULL) {
+    printf("Erro: arquivo deve conter um número.\n");
+    return 1;
+  }
+
+  int ok = bigint_save(num, output_filename);
+  bigint_destroy(num);
+  if (!ok) {
+    perror("Erro ao gravar arquivo binário");
+    return 1;
+  }
+  return 0;
+}
+
+// Converte um arquivo binário de volta para texto decimal, lendo os limbs
+// do arquivo mapeado e escrevendo os dígitos direto no arquivo de saída
+int converter_para_texto(const char *input_filename,
+                         const char *output_filename) {
+  BigIntView view;
+  if (bigint_view_open(input_filename, &view)) {
+    int ok = bigint_file_to_decimal(&view, output_filename);
+    bigint_view_close(&view);
+    if (!ok) {
+      perror("Erro ao gravar arquivo de saída");
+      return 1;
+    }
+    printf("Resultado gravado em %s\n", output_filename);
+    return 0;
+  }
+
+  BigInt *num = bigint_load(input_filename);
+  if (num == NULL) {
+    printf("Erro: arquivo binário inválido ou corrompido.\n");
+    return 1;
+  }
+
+  escrever_resultado(1, output_filename, num);
+  bigint_destroy(num);
+  return 0;
+}
+
+typedef struct {
+  BatchOp op;
+  const BigIntView *a;
+  const BigIntView *b;
+  const char *saida;
+  size_t memoria_mb;
+  int ok;
+} OperacaoArquivo;
+
+void operar_arquivos_tarefa(void *arg) {
+  OperacaoArquivo *operacao = arg;
+  switch (operacao->op) {
+  case BATCH_OP_SOMA:
+    operacao->ok =
+        bigint_file_sum(operacao->a, operacao->b, operacao->saida);
+    break;
+  case BATCH_OP_SUBTRACAO:
+    operacao->ok =
+        bigint_file_subtract(operacao->a, operacao->b, operacao->saida);
+    break;
+  default:
+    operacao->ok = bigint_file_multiply(operacao->a, operacao->b,
+                                        operacao->saida,
+                                        operacao->memoria_mb);
+    break;
+  }
+}
+
+// Soma, subtração, multiplicação ou comparação ("cmp") de dois arquivos
+// binários, sem carregá-los em BigInts. A multiplicação roda em um worker
+// do escalonador para que os produtos de blocos usem os kernels paralelos
+int operar_arquivos(const char *op, const char *a_path, const char *b_path,
+                    const char *saida, size_t threads, size_t memoria_mb) {
+  int comparar = strcmp(op, "cmp") == 0;
+  BatchOp batch_op = batch_parse_op(op, strlen(op));
+  if (!comparar && batch_op != BATCH_OP_SOMA &&
+      batch_op != BATCH_OP_SUBTRACAO && batch_op != BATCH_OP_MULTIPLICACAO) {
+    printf("Erro: operacao deve ser +, -, * ou cmp\n");
+    return 1;
+  }
+
+  BigIntView a, b;
+  if (!bigint_view_open(a_path, &a)) {
+    printf("Erro: arquivo binário inválido ou corrompido: %s\n", a_path);
+    return 1;
+  }
+  if (!bigint_view_open(b_path, &b)) {
+    printf("Erro: arquivo binário inválido ou corrompido: %s\n", b_path);
+    bigint_view_close(&a);
+    return 1;
+  }
+
+  int status = 0;
+  if (comparar) {
+    printf("%d\n", bigint_file_compare(&a, &b));
+  } else {
+    OperacaoArquivo operacao = {batch_op, &a, &b, saida, memoria_mb, 0};
+    Scheduler *escalonador = threads > 1 ? scheduler_create(threads) : NULL;
+    if (escalonador != NULL) {
+      scheduler_run(escalonador, operar_arquivos_tarefa, &operacao);
+      scheduler_destroy(escalonador);
+    } else {
+      operar_arquivos_tarefa(&operacao);
+    }
+    if (!operacao.ok) {
+      perror("Erro ao gravar arquivo de saída");
+      status = 1;
+    }
+  }
+  bigint_view_close(&a);
+  bigint_view_close(&b);
+  return status;
+}
+
+// Compila e avalia um programa de expressões, escrevendo uma saída por
+// linha em out ("ERRO" nas que falharam). O primeiro erro e as estatísticas
+// do DAG vão para stderr. Retorna 1 se todas as saídas foram calculadas
+int avaliar_expressoes(const char *src, size_t len, FILE *out) {
+  ExprProgram *programa = expr_create();
+  if (programa == NULL) {
+    printf("Erro ao criar programa\n");
+    return 0;
+  }
+
+  expr_compile(programa, src, len);
+  size_t n = expr_outputs(programa);
+  BigInt **resultados = calloc(n > 0 ? n : 1, sizeof(BigInt *));
+  int ok = resultados != NULL && expr_evaluate(programa, resultados);
+  for (size_t i = 0; resultados != NULL && i < n; i++) {
+    char *str = bigint_to_string(resultados[i]);
+    fprintf(out, "%s\n", str != NULL ? str : "ERRO");
+    free(str);
+    bigint_destroy(resultados[i]);
+  }
+  free(resultados);
+
+  ExprStats stats;
+  expr_stats(programa, &stats);
+  fprintf(stderr, "Expressao: %zu nos, %zu reaproveitados (CSE), %zu fusoes\n",
+          stats.nodes, stats.shared, stats.fused);
+  if (expr_error(programa) != NULL) {
+    fprintf(stderr, "Erro: %s\n", expr_error(programa));
+  }
+  expr_destroy(programa);
+  return ok;
+}
+
+// Avalia as expressões de um arquivo e grava os resultados em outro
+int avaliar_arquivo(const char *input_filename, const char *output_filename) {
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 0;
+  }
+  FILE *fout = fopen(output_filename, "w");
+  if (fout == NULL) {
+    perror("Erro ao abrir arquivo de saída");
+    inputfile_close(&in);
+    return 0;
+  }
+  int ok = avaliar_expressoes(in.data, in.size, fout);
+  fclose(fout);
+  inputfile_close(&in);
+  return ok;
+}
+
+// Interpreta um número não negativo de uma opção
+int ler_tamanho(const char *valor, long *n) {
+  char *fim;
+  *n = strtol(valor, &fim, 10);
+  return *valor != '\0' && *fim == '\0' && *n >= 0;
+}
+
+// Interpreta as opções "--threads N" (N = 0 usa o número de processadores
+// online), "--cache-mb M", "--seconds S" e "--memory-mb M" a partir de
+// argv[primeiro], em qualquer ordem. Com cache_mb, segundos ou memoria_mb
+// == NULL a opção não é aceita
+int ler_opcoes(int argc, char **argv, int primeiro, size_t *threads,
+               size_t *cache_mb, double *segundos, size_t *memoria_mb) {
+  for (int i = primeiro; i < argc; i += 2) {
+    long n;
+    if (i + 1 >= argc) {
+      return 0;
+    }
+    if (segundos != NULL && strcmp(argv[i], "--seconds") == 0) {
+      char *fim;
+      *segundos = strtod(argv[i + 1], &fim);
+      if (*argv[i + 1] == '\0' || *fim != '\0' || *segundos < 0) {
+        return 0;
+      }
+      continue;
+    }
+    if (!ler_tamanho(argv[i + 1], &n)) {
+      return 0;
+    }
+    if (strcmp(argv[i], "--threads") == 0) {
+      if (n == 0) {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+      }
+      *threads = n > 0 ? (size_t)n : 1;
+    } else if (cache_mb != NULL && strcmp(argv[i], "--cache-mb") == 0) {
+      *cache_mb = (size_t)n;
+    } else if (memoria_mb != NULL && strcmp(argv[i], "--memory-mb") == 0) {
+      *memoria_mb = (size_t)n;
+    } else {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Cria o cache de resultados quando pedido (cache_mb > 0)
+// Retorna 0 se não foi possível criar
+int criar_cache(size_t cache_mb, ResultCache **cache) {
+  *cache = NULL;
+  if (cache_mb == 0) {
+    return 1;
+  }
+  *cache = cache_create(cache_mb * 1024 * 1024);
+  if (*cache == NULL) {
+    printf("Erro: nao foi possivel criar o cache\n");
+    return 0;
+  }
+  return 1;
+}
+
+typedef struct {
+  ResultCache *cache;
+  BatchOp op;
+  const BigInt *a;
+  const BigInt *b;
+  BigInt *resultado;
+} Operacao;
+
+void executar_operacao_tarefa(void *arg) {
+  Operacao *operacao = arg;
+  const BigInt *xs[2] = {operacao->a, operacao->b};
+  operacao->resultado = batch_apply_cached(operacao->cache, operacao->op, xs,
+                                           operacao->b != NULL ? 2 : 1);
+}
+
+// Mostra em stderr o progresso das operações longas do menu
+void mostrar_progresso(void *arg, const char *etapa, double fracao) {
+  int *mostrou = arg;
+  fprintf(stderr, "\r%s: %3.0f%%", etapa, 100 * fracao);
+  *mostrou = 1;
+}
+
+// Executa a operação (passando pelo cache, se houver), dentro de um worker
+// do escalonador quando houver, com o progresso em stderr
+BigInt *executar_operacao(Scheduler *escalonador, ResultCache *cache,
+                          BatchOp op, const BigInt *a, const BigInt *b) {
+  Operacao operacao = {cache, op, a, b, NULL};
+  ExecContext exec;
+  int mostrou = 0;
+  exec_init(&exec);
+  exec_set_progress(&exec, mostrar_progresso, &mostrou);
+  ExecContext *anterior = exec_enter(&exec);
+  if (escalonador != NULL) {
+    scheduler_run(escalonador, executar_operacao_tarefa, &operacao);
+  } else {
+    executar_operacao_tarefa(&operacao);
+  }
+  exec_leave(anterior);
+  if (mostrou) {
+    fprintf(stderr, "\n");
+  }
+  return operacao.resultado;
+}
+
+typedef struct {
+  const BigInt *n;
+  double segundos;
+  Factorization *resultado;
+} Fatoracao;
+
+void fatorar_tarefa(void *arg) {
+  Fatoracao *fatoracao = arg;
+  fatoracao->resultado = bigint_factor(fatoracao->n, fatoracao->segundos);
+}
+
+// Fatora n dentro de um worker do escalonador, quando houver, para que as
+// caminhadas do rho e as curvas da ECM rodem em paralelo
+Factorization *fatorar(Scheduler *escalonador, const BigInt *n,
+                       double segundos) {
+  Fatoracao fatoracao = {n, segundos, NULL};
+  if (escalonador != NULL) {
+    scheduler_run(escalonador, fatorar_tarefa, &fatoracao);
+  } else {
+    fatorar_tarefa(&fatoracao);
+  }
+  return fatoracao.resultado;
+}
+
+// Fatora cada número do arquivo de entrada (um por linha) e grava uma
+// fatoração por linha ("ERRO" para zero ou entrada inválida). segundos é o
+// limite de cada número (0: sem limite)
+int fatorar_arquivo(const char *input_filename, const char *output_filename,
+                    size_t threads, double segundos) {
+  InputFile in;
+  if (!inputfile_open(input_filename, &in)) {
+    perror("Erro ao abrir arquivo de entrada");
+    return 1;
+  }
+  FILE *fout = fopen(output_filename, "w");
+  Scheduler *escalonador = scheduler_create(threads);
+  if (fout == NULL || escalonador == NULL) {
+    perror("Erro ao abrir arquivo de saída");
+    if (fout != NULL) {
+      fclose(fout);
+    }
+    scheduler_destroy(escalonador);
+    inputfile_close(&in);
+    return 1;
+  }
+
+  size_t pos = 0, incompletas = 0;
+  const char *token = NULL;
+  size_t len = 0;
+  int status = 0;
+  while (inputfile_next_token(in.data, in.size, &pos, &token, &len)) {
+    BigInt *num = bigint_create_from_chars(token, len);
+    Factorization *f =
+        num != NULL ? fatorar(escalonador, num, segundos) : NULL;
+    char *texto = f != NULL ? factorization_to_string(f) : NULL;
+    fprintf(fout, "%s\n", texto != NULL ? texto : "ERRO");
+    if (texto == NULL) {
+      status = 1;
+    } else if (!f->complete) {
+      incompletas++;
+    }
+    free(texto);
+    factorization_destroy(f);
+    bigint_destroy(num);
+  }
+  if (incompletas > 0) {
+    fprintf(stderr, "Tempo esgotado: %zu numero(s) com fatores compostos\n",
+            incompletas);
+  }
+  scheduler_destroy(escalonador);
+  fclose(fout);
+  inputfile_close(&in);
+  return status;
+}
+
+int menu_interativo(Scheduler *escalonador, ResultCache *cache);
+
+int main(int argc, char **argv) {
+  // Dump dos contadores na saída e em SIGUSR1 (só com make INSTRUMENT=1)
+  INSTR_INIT();
+
+  // Modos não interativos
+  if (argc > 1) {
+    if (argc == 4 && strcmp(argv[1], "--to-bin") == 0) {
+      return converter_para_binario(argv[2], argv[3]);
+    }
+    if (argc == 4 && strcmp(argv[1], "--from-bin") == 0) {
+      return converter_para_texto(argv[2], argv[3]);
+    }
+    if (argc >= 5 && strcmp(argv[1], "--file") == 0) {
+      int comparar = strcmp(argv[2], "cmp") == 0;
+      long online = sysconf(_SC_NPROCESSORS_ONLN);
+      size_t threads = online > 0 ? (size_t)online : 1;
+      size_t memoria_mb = OOC_DEFAULT_MEMORY_MB;
+      if ((!comparar && argc < 6) ||
+          !ler_opcoes(argc, argv, comparar ? 5 : 6, &threads, NULL, NULL,
+                      &memoria_mb)) {
+        imprimir_uso(argv[0]);
+        return 1;
+      }
+      return operar_arquivos(argv[2], argv[3], argv[4],
+                             comparar ? NULL : argv[5], threads, memoria_mb);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--batch") == 0) {
+      size_t threads = 1, cache_mb = 0;
+      double segundos = 0;
+      ResultCache *cache;
+      if (!ler_opcoes(argc, argv, 4, &threads, &cache_mb, &segundos, NULL)) {
+        imprimir_uso(argv[0]);
+        return 1;
+      }
+      if (!criar_cache(cache_mb, &cache)) {
+        return 1;
+      }
+      int status = batch_run(argv[2], argv[3], threads, cache, segundos);
+      cache_destroy(cache);
+      return status;
+    }
+    if (argc == 4 && strcmp(argv[1], "--expr") == 0) {
+      return avaliar_arquivo(argv[2], argv[3]) ? 0 : 1;
+    }
+    if ((argc >= 3 && strcmp(argv[1], "--server") == 0) ||
+        strcmp(argv[1], "--stdio") == 0) {
+      int stdio = strcmp(argv[1], "--stdio") == 0;
+      long online = sysconf(_SC_NPROCESSORS_ONLN);
+      size_t threads = online > 0 ? (size_t)online : 1, cache_mb = 0;
+      double segundos = 0;
+      ResultCache *cache;
+      if (!ler_opcoes(argc, argv, stdio ? 2 : 3, &threads, &cache_mb,
+                      &segundos, NULL)) {
+        imprimir_uso(argv[0]);
+        return 1;
+      }
+      if (!criar_cache(cache_mb, &cache)) {
+        return 1;
+      }
+      int status = stdio ? server_run_stdio(threads, cache, segundos)
+                         : server_run_socket(argv[2], threads, cache,
+                                             segundos);
+      cache_destroy(cache);
+      return status;
+    }
+    if (argc >= 4 && strcmp(argv[1], "--batch-gcd") == 0) {
+      size_t threads = 1;
+      if (!ler_opcoes(argc, argv, 4, &threads, NULL, NULL, NULL)) {
+        imprimir_uso(argv[0]);
+        return 1;
+      }
+      return batch_gcd_run(argv[2], argv[3], threads);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--factor") == 0) {
+      long online = sysconf(_SC_NPROCESSORS_ONLN);
+      size_t threads = online > 0 ? (size_t)online : 1;
+      double segundos = 0;
+      if (!ler_opcoes(argc, argv, 4, &threads, NULL, &segundos, NULL)) {
+        imprimir_uso(argv[0]);
+        return 1;
+      }
+      return fatorar_arquivo(argv[2], argv[3], threads, segundos);
+    }
+  }
+
+  // Menu interativo, com escalonador e cache opcionais
+  size_t threads = 0, cache_mb = 0;
+  ResultCache *cache;
+  if (!ler_opcoes(argc, argv, 1, &threads, &cache_mb, NULL, NULL)) {
+    imprimir_uso(argv[0]);
+    return 1;
+  }
+  if (!criar_cache(cache_mb, &cache)) {
+    return 1;
+  }
+  Scheduler *escalonador = threads > 0 ? scheduler_create(threads) : NULL;
+  int status = menu_interativo(escalonador, cache);
+  scheduler_destroy(escalonador);
+  if (cache != NULL) {
+    cache_print_stats(cache, stdout);
+    cache_destroy(cache);
+  }
+  return status;
+}
+
+// Menu interativo. Com um escalonador, cada operação roda em um worker e
+// pode usar os kernels paralelos (ex.: multiplicação de operandos enormes)
+int menu_interativo(Scheduler *escalonador, ResultCache *cache) {
   // Setup
   int isFile = 0;
   int setupOption = 0;
@@ -82,6 +753,18 @@ int main(void) {
     printf("4. Divisao Inteira\n");
     printf("5. Modulo\n");
     printf("6. Máximo Divisor Comum\n");
+    printf("7. Fatorial\n");
+    printf("8. Coeficiente Binomial\n");
+    printf("12. Raiz Quadrada\n");
+    printf("13. Raiz k-esima\n");
+    printf("14. Potencia Perfeita\n");
+    printf("15. Potencia\n");
+    printf("16. Fibonacci\n");
+    printf("17. Lucas\n");
+    printf("18. Teste de Primalidade\n");
+    printf("19. Proximo Primo\n");
+    printf("20. Fatoracao\n");
+    printf("21. Expressao\n");
     printf("Digite a opcao: ");
     scanf("%d", &option);
 
@@ -95,177 +778,342 @@ int main(void) {
 
     case 1: {
       printf("Adicao\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
-
-      if (num1 && num2) {
-        BigInt *result = bigint_sum(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
-        }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
-      } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_SOMA, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
       }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
       break;
     }
 
     case 2: {
       printf("Subtracao\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
-
-      if (num1 && num2) {
-        BigInt *result = bigint_subtract(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
-        }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
-      } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_SUBTRACAO, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
       }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
       break;
     }
 
     case 3: {
       printf("Multiplicacao\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
-
-      if (num1 && num2) {
-        BigInt *result = bigint_multiplicacao(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
-        }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
-      } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_MULTIPLICACAO, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
       }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
 
       break;
     }
 
     case 4: {
       printf("Divisao Inteira\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
-
-      if (num1 && num2) {
-        BigInt *result = bigint_divisao(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
-        }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
-      } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_DIVISAO, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
       }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
 
       break;
     }
 
     case 5: {
       printf("Modulo\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
-
-      if (num1 && num2) {
-        BigInt *result = bigint_mod(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
-        }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
-      } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_MODULO, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
       }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
 
       break;
     }
     case 6: {
       printf("Máximo Divisor Comum\n");
-      char num1_str[1024], num2_str[1024];
-      if (!ler_numeros(isFile, input_filename, num1_str, sizeof(num1_str),
-                       num2_str, sizeof(num2_str))) {
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
+        break;
+      }
+
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_MDC, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
+
+      break;
+    }
+    case 7: {
+      printf("Fatorial\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_FATORIAL, num, NULL);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: n deve estar entre 0 e 4294967295\n");
+      }
+      bigint_destroy(num);
+
+      break;
+    }
+    case 8: {
+      printf("Coeficiente Binomial\n");
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
+        break;
+      }
+
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_BINOMIAL, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: n deve estar entre 0 e 4294967295\n");
+      }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
+
+      break;
+    }
+    case 12: {
+      printf("Raiz Quadrada\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+
+      BigInt *result = executar_operacao(escalonador, cache,
+                                         BATCH_OP_RAIZ_QUADRADA, num, NULL);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: o numero nao pode ser negativo\n");
+      }
+      bigint_destroy(num);
+
+      break;
+    }
+    case 13: {
+      printf("Raiz k-esima (numero e k)\n");
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
+        break;
+      }
+
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_RAIZ, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: k deve estar entre 1 e 4294967295 (impar para "
+               "negativos)\n");
+      }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
+
+      break;
+    }
+    case 14: {
+      printf("Potencia Perfeita\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
         break;
       }
 
-      BigInt *num1 = bigint_create_from_string(num1_str);
-      BigInt *num2 = bigint_create_from_string(num2_str);
+      BigInt *base = NULL;
+      uint32_t k = 0;
+      if (bigint_is_perfect_power(num, &base, &k)) {
+        printf("Sim: numero = base^%u, base = ", (unsigned)k);
+        bigint_print(base);
+        printf("\n");
+      } else {
+        printf("Nao e potencia perfeita\n");
+      }
+      bigint_destroy(base);
+      bigint_destroy(num);
 
-      if (num1 && num2) {
-        BigInt *result = bigint_gcd(num1, num2);
-        if (result) {
-          escrever_resultado(isFile, output_filename, result);
-          bigint_destroy(result);
+      break;
+    }
+    case 15: {
+      printf("Potencia (base e expoente)\n");
+      BigInt *num1, *num2;
+      if (!ler_numeros(isFile, input_filename, &num1, &num2)) {
+        break;
+      }
+
+      BigInt *result =
+          executar_operacao(escalonador, cache, BATCH_OP_POTENCIA, num1, num2);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: o expoente deve estar entre 0 e 4294967295\n");
+      }
+      bigint_destroy(num1);
+      bigint_destroy(num2);
+
+      break;
+    }
+    case 16:
+    case 17: {
+      printf(option == 16 ? "Fibonacci\n" : "Lucas\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+
+      BigInt *result = executar_operacao(
+          escalonador, cache,
+          option == 16 ? BATCH_OP_FIBONACCI : BATCH_OP_LUCAS, num, NULL);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: n deve estar entre 0 e 4294967295\n");
+      }
+      bigint_destroy(num);
+
+      break;
+    }
+    case 18: {
+      printf("Teste de Primalidade\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+
+      if (bigint_is_probable_prime(num, PRIME_DEFAULT_ROUNDS)) {
+        printf("Primo (provavel)\n");
+      } else {
+        printf("Nao e primo\n");
+      }
+      bigint_destroy(num);
+
+      break;
+    }
+    case 19: {
+      printf("Proximo Primo\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+
+      BigInt *result = executar_operacao(escalonador, cache,
+                                         BATCH_OP_PROXIMO_PRIMO, num, NULL);
+      if (result) {
+        escrever_resultado(isFile, output_filename, result);
+        bigint_destroy(result);
+      } else {
+        printf("Erro: memoria insuficiente\n");
+      }
+      bigint_destroy(num);
+
+      break;
+    }
+    case 20: {
+      printf("Fatoracao\n");
+      BigInt *num;
+      if (!ler_numero(isFile, input_filename, &num)) {
+        break;
+      }
+      double segundos = 0;
+      printf("Tempo limite em segundos (0 = sem limite): ");
+      scanf("%lf", &segundos);
+
+      Factorization *f = fatorar(escalonador, num, segundos);
+      char *texto = f != NULL ? factorization_to_string(f) : NULL;
+      if (texto == NULL) {
+        printf("Erro: n deve ser diferente de zero\n");
+      } else if (isFile) {
+        FILE *fout = fopen(output_filename, "w");
+        if (fout != NULL) {
+          fprintf(fout, "%s\n", texto);
+          fclose(fout);
+          printf("Resultado gravado em %s\n", output_filename);
+        } else {
+          perror("Erro ao abrir arquivo de saída");
         }
-        bigint_destroy(num1);
-        bigint_destroy(num2);
       } else {
-        printf("Erro ao criar BigInt\n");
-        if (num1)
-          bigint_destroy(num1);
-        if (num2)
-          bigint_destroy(num2);
+        printf("Resultado: %s\n", texto);
+      }
+      if (f != NULL && !f->complete) {
+        printf("Tempo esgotado: a fatoracao esta incompleta\n");
+      }
+      free(texto);
+      factorization_destroy(f);
+      bigint_destroy(num);
+
+      break;
+    }
+    case 21: {
+      printf("Expressao\n");
+      if (isFile) {
+        // O arquivo de entrada inteiro é o programa
+        if (avaliar_arquivo(input_filename, output_filename)) {
+          printf("Resultado gravado em %s\n", output_filename);
+        }
+        break;
+      }
+
+      printf("Digite a expressao (comandos separados por ';'): ");
+      char *linha = ler_linha(stdin);
+      if (linha == NULL) {
+        break;
       }
+      avaliar_expressoes(linha, strlen(linha), stdout);
+      free(linha);
 
       break;
     }
@@ -0,0 +1,540 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "BigInt/BigInt.h"
+#include "BigIntSerial/BigIntSerial.h"
+#include "LinkedList/LinkedList.h"
+#include "OutOfCore/OutOfCore.h"
+#include "Tuning/Tuning.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Verificações de regressão (make test)
+// Cada grupo testa uma propriedade que já quebrou ou que depende de mais de
+// um módulo: copy-on-write da lista, arquivo binário, out-of-core com o
+// destino igual a um operando, operações com inteiros nativos nos limites
+// de 32 e 64 bits e os algoritmos escolhidos pelos limiares
+// (src/Tuning), comparados entre si: o resultado com os limiares no mínimo
+// (Karatsuba, NTT, Newton e conversão por divisão e conquista em números
+// pequenos) tem que ser igual ao dos algoritmos simples
+//
+// Uso: test [diretorio]   (arquivos temporários; padrão: output)
+
+static int falhas = 0;
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      fprintf(stderr, "FALHA: %s (%s:%d)\n", #cond, __FILE__, __LINE__);     \
+      falhas++;                                                              \
+    }                                                                        \
+  } while (0)
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_limb(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return (uint32_t)(rng_state >> 32);
+}
+
+// Número aleatório com exatamente n limbs (topo não nulo) e o sinal dado
+static BigInt *random_bigint(size_t n, int sign) {
+  uint32_t *limbs = malloc(n * sizeof(uint32_t));
+  if (limbs == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    limbs[i] = next_limb();
+  }
+  limbs[n - 1] |= 1;
+  BigInt *bi = bigint_import_limbs(limbs, n, sign);
+  free(limbs);
+  return bi;
+}
+
+// Compara o valor decimal de bi com o texto esperado
+static int string_is(const BigInt *bi, const char *expected) {
+  char *s = bigint_to_string(bi);
+  int ok = s != NULL && strcmp(s, expected) == 0;
+  free(s);
+  return ok;
+}
+
+// Cópia, limpeza e append não podem alterar a lista original
+static void test_copy_on_write(void) {
+  BigInt *a = bigint_create_from_string("123456789012345678901234567890");
+  BigInt *c = bigint_copy(a);
+  CHECK(a != NULL && c != NULL);
+  if (a == NULL || c == NULL) {
+    bigint_destroy(a);
+    bigint_destroy(c);
+    return;
+  }
+  CHECK(linkedlist_is_shared(a->digits));
+
+  linkedlist_clear(c->digits);
+  CHECK(!linkedlist_is_shared(a->digits));
+  CHECK(!linkedlist_is_shared(c->digits));
+  linkedlist_append(c->digits, 7);
+  CHECK(string_is(c, "7"));
+  CHECK(string_is(a, "123456789012345678901234567890"));
+
+  // Append em uma cópia ainda compartilhada
+  BigInt *d = bigint_copy(a);
+  CHECK(d != NULL);
+  if (d != NULL) {
+    linkedlist_append(d->digits, 1);
+    CHECK(string_is(a, "123456789012345678901234567890"));
+    CHECK(bigint_compare(d, a) > 0);
+    bigint_destroy(d);
+  }
+
+  bigint_destroy(c);
+  bigint_destroy(a);
+}
+
+// Grava e carrega: o valor, o sinal e o zero voltam iguais
+static void test_serial(const char *dir) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/test_serial.bin", dir);
+
+  BigInt *values[3] = {random_bigint(1000, 1), random_bigint(3, -1),
+                       bigint_create_from_int(0)};
+  for (int i = 0; i < 3; i++) {
+    CHECK(values[i] != NULL && bigint_save(values[i], path));
+    BigInt *loaded = bigint_load(path);
+    CHECK(loaded != NULL && bigint_equal(loaded, values[i]));
+    bigint_destroy(loaded);
+    bigint_destroy(values[i]);
+  }
+  remove(path);
+}
+
+// Executa op(a, b) out-of-core gravando sobre o arquivo de a
+// Retorna o valor final do arquivo de a
+static BigInt *file_op_into_a(char op, const BigInt *a, const BigInt *b,
+                              const char *a_path, const char *b_path) {
+  if (!bigint_save(a, a_path) || !bigint_save(b, b_path)) {
+    return NULL;
+  }
+  BigIntView va, vb;
+  if (!bigint_view_open(a_path, &va)) {
+    return NULL;
+  }
+  if (!bigint_view_open(b_path, &vb)) {
+    bigint_view_close(&va);
+    return NULL;
+  }
+
+  int ok = 0;
+  switch (op) {
+  case '+': ok = bigint_file_sum(&va, &vb, a_path); break;
+  case '-': ok = bigint_file_subtract(&va, &vb, a_path); break;
+  case '*': ok = bigint_file_multiply(&va, &vb, a_path, 1); break;
+  }
+  bigint_view_close(&va);
+  bigint_view_close(&vb);
+  return ok ? bigint_load(a_path) : NULL;
+}
+
+// acc = acc op b: o destino é um dos operandos mapeados
+static void test_out_of_core(const char *dir) {
+  char a_path[4096], b_path[4096];
+  snprintf(a_path, sizeof(a_path), "%s/test_ooc_a.bin", dir);
+  snprintf(b_path, sizeof(b_path), "%s/test_ooc_b.bin", dir);
+
+  // 5000 limbs com orçamento de 1 MB: mais de um bloco na multiplicação
+  BigInt *a = random_bigint(5000, 1);
+  BigInt *b = random_bigint(4500, -1);
+  const char ops[] = {'+', '-', '*'};
+  for (int i = 0; a != NULL && b != NULL && i < 3; i++) {
+    BigInt *expected = ops[i] == '+'   ? bigint_sum(a, b)
+                       : ops[i] == '-' ? bigint_subtract(a, b)
+                                       : bigint_multiplicacao(a, b);
+    BigInt *got = file_op_into_a(ops[i], a, b, a_path, b_path);
+    CHECK(expected != NULL && got != NULL && bigint_equal(got, expected));
+    bigint_destroy(expected);
+    bigint_destroy(got);
+  }
+
+  // Mesmo arquivo nos dois operandos e no destino: acc = acc * acc
+  BigInt *square = a != NULL ? bigint_multiplicacao(a, a) : NULL;
+  BigInt *got = a != NULL ? file_op_into_a('*', a, a, a_path, a_path) : NULL;
+  CHECK(square != NULL && got != NULL && bigint_equal(got, square));
+  bigint_destroy(square);
+  bigint_destroy(got);
+
+  bigint_destroy(a);
+  bigint_destroy(b);
+  remove(a_path);
+  remove(b_path);
+}
+
+// Retorna 1 se r é o zero canônico (sinal positivo, igual a 0 em
+// bigint_compare e em bigint_equal) e libera r
+static int canonical_zero(BigInt *r) {
+  BigInt *zero = bigint_create_from_int(0);
+  int ok = r != NULL && zero != NULL && r->sign == 1 &&
+           bigint_compare(r, zero) == 0 && bigint_equal(r, zero) &&
+           bigint_is_zero(r);
+  bigint_destroy(zero);
+  bigint_destroy(r);
+  return ok;
+}
+
+// Magnitudes iguais se cancelam em +0, qualquer que seja o sinal
+static void test_zero_sign(void) {
+  BigInt *m5 = bigint_create_from_int(-5);
+  BigInt *p5 = bigint_create_from_int(5);
+  BigInt *big = random_bigint(40, -1);
+  BigInt *big_neg = big != NULL ? bigint_negate(big) : NULL;
+  CHECK(m5 != NULL && p5 != NULL && big != NULL && big_neg != NULL);
+  if (m5 != NULL && p5 != NULL && big != NULL && big_neg != NULL) {
+    CHECK(canonical_zero(bigint_subtract(m5, m5)));
+    CHECK(canonical_zero(bigint_sum(m5, p5)));
+    CHECK(canonical_zero(bigint_sum(p5, m5)));
+    CHECK(canonical_zero(bigint_subtract(big, big)));
+    CHECK(canonical_zero(bigint_sum(big, big_neg)));
+  }
+  bigint_destroy(m5);
+  bigint_destroy(p5);
+  bigint_destroy(big);
+  bigint_destroy(big_neg);
+}
+
+// Valores exatos nos limites de 32 e 64 bits
+static void test_native_known(void) {
+  BigInt *min = bigint_create_from_i64(INT64_MIN);
+  BigInt *max = bigint_create_from_u64(UINT64_MAX);
+  BigInt *two32 = bigint_create_from_u64((uint64_t)1 << 32);
+  CHECK(min != NULL && max != NULL && two32 != NULL);
+  if (min == NULL || max == NULL || two32 == NULL) {
+    bigint_destroy(min);
+    bigint_destroy(max);
+    bigint_destroy(two32);
+    return;
+  }
+  CHECK(string_is(min, "-9223372036854775808"));
+  CHECK(string_is(max, "18446744073709551615"));
+  CHECK(string_is(two32, "4294967296"));
+
+  // Conversões de volta, com e sem estouro
+  int overflow = -1;
+  CHECK(bigint_to_i64(min, &overflow) == INT64_MIN && overflow == 0);
+  CHECK(bigint_to_u64(max, &overflow) == UINT64_MAX && overflow == 0);
+  CHECK(bigint_to_i64(max, &overflow) == INT64_MAX && overflow == 1);
+  CHECK(bigint_to_u64(min, &overflow) == 0 && overflow == 1);
+  CHECK(bigint_to_u64(two32, &overflow) == (uint64_t)1 << 32 && !overflow);
+
+  BigInt *r = bigint_subtract_si(min, 1); // -2^63 - 1
+  CHECK(r != NULL && bigint_to_i64(r, &overflow) == INT64_MIN && overflow);
+  bigint_destroy(r);
+  r = bigint_sum_ui(max, 1); // 2^64
+  CHECK(r != NULL && string_is(r, "18446744073709551616"));
+  CHECK(r != NULL && bigint_to_u64(r, &overflow) == UINT64_MAX && overflow);
+  bigint_destroy(r);
+
+  r = bigint_multiplicacao_si(max, INT64_MIN);
+  CHECK(r != NULL &&
+        string_is(r, "-170141183460469231722463931679029329920"));
+  bigint_destroy(r);
+  r = bigint_multiplicacao_si(min, INT64_MIN);
+  CHECK(r != NULL && string_is(r, "85070591730234615865843651857942052864"));
+  bigint_destroy(r);
+  r = bigint_subtract_si(max, INT64_MIN);
+  CHECK(r != NULL && string_is(r, "27670116110564327423"));
+  bigint_destroy(r);
+
+  // Divisão truncada para zero com divisores negativos
+  r = bigint_divisao_si(min, -1);
+  CHECK(r != NULL && string_is(r, "9223372036854775808"));
+  bigint_destroy(r);
+  r = bigint_divisao_si(max, -((int64_t)1 << 32));
+  CHECK(r != NULL && string_is(r, "-4294967295"));
+  bigint_destroy(r);
+  r = bigint_divisao_ui(max, UINT64_MAX);
+  CHECK(r != NULL && string_is(r, "1"));
+  bigint_destroy(r);
+  CHECK(bigint_divisao_si(max, 0) == NULL);
+  CHECK(bigint_divisao_ui(max, 0) == NULL);
+
+  // Resto sempre em [0, |b|)
+  uint64_t resto = 1;
+  BigInt *m7 = bigint_create_from_int(-7);
+  CHECK(m7 != NULL && bigint_mod_si(m7, -3, &resto) && resto == 2);
+  CHECK(bigint_mod_si(min, INT64_MIN, &resto) && resto == 0);
+  CHECK(bigint_mod_si(max, INT64_MIN, &resto) && resto == INT64_MAX);
+  CHECK(bigint_mod_ui(max, (uint64_t)1 << 32, &resto) &&
+        resto == UINT32_MAX);
+  CHECK(bigint_mod_ui(min, UINT64_MAX, &resto) &&
+        resto == UINT64_MAX - ((uint64_t)1 << 63));
+  CHECK(!bigint_mod_si(max, 0, &resto));
+  bigint_destroy(m7);
+
+  // Resultados zero: sempre o zero canônico, como bigint_create_from_int(0)
+  BigInt *m5 = bigint_create_from_int(-5);
+  CHECK(m5 != NULL);
+  if (m5 != NULL) {
+    CHECK(canonical_zero(bigint_sum_si(m5, 5)));
+    CHECK(canonical_zero(bigint_subtract_si(m5, -5)));
+    CHECK(canonical_zero(bigint_multiplicacao_si(m5, 0)));
+    CHECK(canonical_zero(bigint_multiplicacao_ui(m5, 0)));
+    CHECK(canonical_zero(bigint_divisao_si(m5, -6)));
+    CHECK(canonical_zero(bigint_divisao_ui(m5, UINT64_MAX)));
+  }
+  bigint_destroy(m5);
+  CHECK(canonical_zero(bigint_subtract_si(min, INT64_MIN)));
+  CHECK(canonical_zero(bigint_sum_ui(min, (uint64_t)1 << 63)));
+  CHECK(canonical_zero(bigint_subtract_ui(max, UINT64_MAX)));
+  CHECK(canonical_zero(bigint_multiplicacao_si(min, 0)));
+
+  CHECK(bigint_compare_si(min, INT64_MIN) == 0);
+  CHECK(bigint_compare_si(two32, INT64_MIN) == 1);
+  CHECK(bigint_compare_ui(max, UINT64_MAX) == 0);
+  CHECK(bigint_compare_ui(min, 0) == -1);
+  CHECK(bigint_compare_ui(two32, (uint64_t)1 << 32) == 0);
+
+  bigint_destroy(min);
+  bigint_destroy(max);
+  bigint_destroy(two32);
+}
+
+// Operandos nativos nos limites (os de _si e os de _ui)
+static const int64_t native_si[] = {
+    0, 1, -1, 3, -3, INT32_MAX, (int64_t)UINT32_MAX, (int64_t)1 << 32,
+    -((int64_t)1 << 32), ((int64_t)1 << 32) + 1, INT64_MAX, INT64_MIN,
+    INT64_MIN + 1};
+static const uint64_t native_ui[] = {
+    0, 1, 3, UINT32_MAX, (uint64_t)1 << 32, ((uint64_t)1 << 32) + 1,
+    (uint64_t)1 << 63, UINT64_MAX - 1, UINT64_MAX};
+
+#define NATIVE_COUNT(v) (sizeof(v) / sizeof((v)[0]))
+
+// Retorna 1 se os resultados são iguais (ou os dois NULL) e libera ambos
+static int same_result(BigInt *mixed, BigInt *full) {
+  int ok = (mixed == NULL && full == NULL) ||
+           (mixed != NULL && full != NULL && bigint_equal(mixed, full));
+  bigint_destroy(mixed);
+  bigint_destroy(full);
+  return ok;
+}
+
+// Resto de a por b (b != 0) pela versão BigInt/BigInt, como uint64_t
+static uint64_t full_mod(const BigInt *a, const BigInt *b) {
+  BigInt *r = bigint_mod(a, b);
+  uint64_t value = r != NULL ? bigint_to_u64(r, NULL) : UINT64_MAX;
+  bigint_destroy(r);
+  return value;
+}
+
+// Cada operação mista contra a versão BigInt/BigInt, para operandos a
+// pequenos, nos limites e com vários limbs
+static void test_native_differential(void) {
+  BigInt *as[NATIVE_COUNT(native_si) + 3];
+  size_t na = 0;
+  for (size_t i = 0; i < NATIVE_COUNT(native_si); i++) {
+    as[na++] = bigint_create_from_i64(native_si[i]);
+  }
+  as[na++] = bigint_create_from_u64(UINT64_MAX);
+  as[na++] = random_bigint(3, 1);
+  as[na++] = random_bigint(5, -1);
+
+  for (size_t i = 0; i < na; i++) {
+    const BigInt *a = as[i];
+    CHECK(a != NULL);
+    if (a == NULL) {
+      continue;
+    }
+
+    for (size_t j = 0; j < NATIVE_COUNT(native_si); j++) {
+      int64_t v = native_si[j];
+      BigInt *b = bigint_create_from_i64(v);
+      CHECK(b != NULL);
+      if (b == NULL) {
+        continue;
+      }
+      CHECK(same_result(bigint_sum_si(a, v), bigint_sum(a, b)));
+      CHECK(same_result(bigint_subtract_si(a, v), bigint_subtract(a, b)));
+      CHECK(same_result(bigint_multiplicacao_si(a, v),
+                        bigint_multiplicacao(a, b)));
+      CHECK(bigint_compare_si(a, v) == bigint_compare(a, b));
+      if (v != 0) {
+        uint64_t resto;
+        CHECK(same_result(bigint_divisao_si(a, v), bigint_divisao(a, b)));
+        CHECK(bigint_mod_si(a, v, &resto) && resto == full_mod(a, b));
+      }
+      bigint_destroy(b);
+    }
+
+    for (size_t j = 0; j < NATIVE_COUNT(native_ui); j++) {
+      uint64_t v = native_ui[j];
+      BigInt *b = bigint_create_from_u64(v);
+      CHECK(b != NULL);
+      if (b == NULL) {
+        continue;
+      }
+      CHECK(same_result(bigint_sum_ui(a, v), bigint_sum(a, b)));
+      CHECK(same_result(bigint_subtract_ui(a, v), bigint_subtract(a, b)));
+      CHECK(same_result(bigint_multiplicacao_ui(a, v),
+                        bigint_multiplicacao(a, b)));
+      CHECK(bigint_compare_ui(a, v) == bigint_compare(a, b));
+      if (v != 0) {
+        uint64_t resto;
+        CHECK(same_result(bigint_divisao_ui(a, v), bigint_divisao(a, b)));
+        CHECK(bigint_mod_ui(a, v, &resto) && resto == full_mod(a, b));
+      }
+      bigint_destroy(b);
+    }
+  }
+
+  for (size_t i = 0; i < na; i++) {
+    bigint_destroy(as[i]);
+  }
+}
+
+// Limiares de cada modo: algoritmos simples, só Karatsuba e tudo no mínimo
+// (NTT, Newton e conversão por divisão e conquista desde poucos limbs)
+#define TEST_MODES 3
+#define TEST_OFF ((size_t)1 << 30)
+
+static const size_t test_modes[TEST_MODES][TUNE_PARAMS] = {
+    {TEST_OFF, TEST_OFF, TEST_OFF, TEST_OFF},
+    {4, TEST_OFF, TEST_OFF, TEST_OFF},
+    {4, 4, 2, 2}};
+
+static void set_mode(int mode) {
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    tuning_set((TuneParam)p, test_modes[mode][p]);
+  }
+}
+
+// Resultados de um modo para os mesmos operandos
+typedef struct {
+  BigInt *product;
+  BigInt *quotient;
+  BigInt *remainder;
+  char *text;
+} ModeResults;
+
+static void mode_results_free(ModeResults *r) {
+  bigint_destroy(r->product);
+  bigint_destroy(r->quotient);
+  bigint_destroy(r->remainder);
+  free(r->text);
+}
+
+// Multiplicação, divisão e conversão decimal iguais em todos os modos
+static void test_thresholds(void) {
+  static const size_t sizes[] = {1, 2, 5, 17, 40, 130, 700, 3100};
+  size_t nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  for (size_t k = 0; k < nsizes; k++) {
+    size_t n = sizes[k];
+    BigInt *a = random_bigint(n, k % 2 ? -1 : 1);
+    BigInt *b = random_bigint(n, 1);
+    BigInt *d = random_bigint(n > 1 ? n / 2 : 1, k % 3 ? 1 : -1);
+    CHECK(a != NULL && b != NULL && d != NULL);
+    if (a == NULL || b == NULL || d == NULL) {
+      bigint_destroy(a);
+      bigint_destroy(b);
+      bigint_destroy(d);
+      continue;
+    }
+
+    ModeResults r[TEST_MODES];
+    for (int m = 0; m < TEST_MODES; m++) {
+      set_mode(m);
+      r[m].product = bigint_multiplicacao(a, b);
+      r[m].quotient = bigint_divisao(a, d);
+      r[m].remainder = bigint_mod(a, d);
+      r[m].text = bigint_to_string(a);
+      CHECK(r[m].product != NULL && r[m].quotient != NULL &&
+            r[m].remainder != NULL && r[m].text != NULL);
+
+      // Ida e volta pelo decimal com os limiares do modo
+      BigInt *parsed = r[m].text != NULL
+                           ? bigint_create_from_string(r[m].text)
+                           : NULL;
+      CHECK(parsed != NULL && bigint_equal(parsed, a));
+      bigint_destroy(parsed);
+    }
+
+    for (int m = 1; m < TEST_MODES; m++) {
+      CHECK(bigint_equal(r[m].product, r[0].product));
+      CHECK(bigint_equal(r[m].quotient, r[0].quotient));
+      CHECK(bigint_equal(r[m].remainder, r[0].remainder));
+      CHECK(r[m].text != NULL && r[0].text != NULL &&
+            strcmp(r[m].text, r[0].text) == 0);
+    }
+
+    // a = q * d + r' e 0 <= r < |d| (o resto r' de a - q * d tem o sinal de
+    // a, e bigint_mod devolve o representante não negativo)
+    BigInt *qd = bigint_multiplicacao(r[0].quotient, d);
+    BigInt *rest = qd != NULL ? bigint_subtract(a, qd) : NULL;
+    BigInt *abs_d = bigint_abs(d);
+    BigInt *abs_rest = rest != NULL ? bigint_abs(rest) : NULL;
+    CHECK(abs_rest != NULL && abs_d != NULL &&
+          bigint_compare(abs_rest, abs_d) < 0);
+    CHECK(bigint_compare_si(r[0].remainder, 0) >= 0 &&
+          bigint_compare(r[0].remainder, abs_d) < 0);
+    bigint_destroy(qd);
+    bigint_destroy(rest);
+    bigint_destroy(abs_d);
+    bigint_destroy(abs_rest);
+
+    for (int m = 0; m < TEST_MODES; m++) {
+      mode_results_free(&r[m]);
+    }
+    bigint_destroy(a);
+    bigint_destroy(b);
+    bigint_destroy(d);
+  }
+
+  for (int p = 0; p < TUNE_PARAMS; p++) {
+    tuning_set((TuneParam)p, tuning_default((TuneParam)p));
+  }
+}
+
+// Mostra o resultado do grupo que começou com before falhas
+static void report(const char *group, int before) {
+  printf("%-16s %s\n", group, falhas == before ? "ok" : "FALHOU");
+}
+
+int main(int argc, char *argv[]) {
+  const char *dir = argc > 1 ? argv[1] : "output";
+  int before;
+
+  before = falhas;
+  test_copy_on_write();
+  report("copy-on-write", before);
+
+  before = falhas;
+  test_serial(dir);
+  report("arquivo binario", before);
+
+  before = falhas;
+  test_out_of_core(dir);
+  report("out-of-core", before);
+
+  before = falhas;
+  test_zero_sign();
+  report("zero com sinal", before);
+
+  before = falhas;
+  test_native_known();
+  test_native_differential();
+  report("inteiros nativos", before);
+
+  before = falhas;
+  test_thresholds();
+  report("limiares", before);
+
+  if (falhas > 0) {
+    printf("%d verificacoes falharam\n", falhas);
+    return 1;
+  }
+  return 0;
+}